@@ -0,0 +1,263 @@
+#!/usr/bin/env python
+
+# Keeps benchmark results as baselines keyed by git commit, and compares new
+# runs against them, so a slowdown in the ground/soil physics, the integrator
+# or a whole regional run shows up before a production run rather than after.
+#
+# Reads the JSON written by the benchmark programs:
+#
+#     DOSTEMBENCH      -> physicsbench.json  (ns per column-day for each kernel/state)
+#     DOSTEMINTEG      -> integbench.json    (integrator ns and derivative calls per month)
+#     DOSTEMREGNBENCH  -> regnbench.json     (cohort-years/s and peak RSS for each stage)
+#
+# Usage:
+#
+#     $ ./benchbaseline.py save physicsbench.json integbench.json
+#     $ ./benchbaseline.py compare physicsbench.json integbench.json
+#     $ ./benchbaseline.py compare -b 43a76f6 -t 3 -t peak_rss_kb=10 regnbench.json
+#     $ ./benchbaseline.py list
+#
+# Baselines are kept as <dir>/<commit>/<benchmark>.json (default dir
+# 'baselines'). A commit with uncommitted changes to tracked files is saved
+# as <commit>-dirty. 'compare' uses the newest baseline of each benchmark
+# unless one is chosen with -b (a commit or its prefix). It exits with 1 if
+# any metric is worse than its threshold, so it can gate a production run,
+# and with 2 if a result has no baseline to compare with.
+#
+# Timings only compare on the same machine. The host is kept with each
+# baseline and a different one is reported.
+
+import os
+import sys
+import json
+import time
+import socket
+import argparse
+import subprocess
+
+# metric name -> (better direction, default noise threshold in %)
+# 'exact' metrics are counts of work done, which should not change for the
+# same inputs; any change is shown, but is not a slowdown by itself.
+METRICS = {
+  'median_ns':          ('lower',  5.0),
+  'ns_per_month':       ('lower',  5.0),
+  'derivs_per_month':   ('lower',  1.0),
+  'rejected_per_month': ('lower',  1.0),
+  'cohort_years_per_s': ('higher', 5.0),
+  'peak_rss_kb':        ('lower',  5.0),
+  'cohort_years':       ('exact',  0.0),
+}
+
+def extract(result):
+  '''Returns {(item, metric): value} and the workload description of a benchmark result.'''
+  kind = result.get('benchmark', '')
+  values = {}
+  if kind == 'dostem-physics':
+    for r in result['results']:
+      values[(r['kernel'] + '/' + r['config'], 'median_ns')] = r['median']
+    workload = 'days=%s reps=%s' % (result.get('days'), result.get('reps'))
+
+  elif kind == 'dostem-integrator':
+    s = result['summary']
+    values[('integrator', 'ns_per_month')] = s['ns_per_month_median']
+    values[('integrator', 'derivs_per_month')] = s['derivs_per_month']
+    values[('integrator', 'rejected_per_month')] = s['rejected_per_month']
+    workload = 'dump=%s months=%s' % (os.path.basename(str(result.get('dumpfile'))), result.get('months'))
+
+  elif kind == 'dostem-regional':
+    for r in result['results']:
+      if r['status'] != 0 or r['cohorts_failed'] > 0:
+        continue
+      values[(r['stage'], 'cohort_years_per_s')] = r['cohort_years_per_s']
+      values[(r['stage'], 'peak_rss_kb')] = r['peak_rss_kb']
+      values[(r['stage'], 'cohort_years')] = r['cohort_years']
+    workload = 'cohorts=%s cells=%s seed=%s' % (result.get('cohorts'), result.get('cells'), result.get('seed'))
+
+  else:
+    raise ValueError("unknown benchmark '%s'" % kind)
+
+  return values, workload
+
+def git_commit():
+  try:
+    head = subprocess.check_output(['git', 'rev-parse', 'HEAD']).decode().strip()
+    dirty = subprocess.check_output(['git', 'status', '--porcelain', '--untracked-files=no']).decode().strip()
+  except (OSError, subprocess.CalledProcessError):
+    sys.exit("not in a git repository; give the commit with -c")
+  return head + ('-dirty' if dirty else '')
+
+def host():
+  name = socket.gethostname()
+  try:
+    for line in open('/proc/cpuinfo'):
+      if line.startswith('model name'):
+        return name + ' (' + line.split(':', 1)[1].strip() + ')'
+  except IOError:
+    pass
+  return name
+
+def load(path):
+  with open(path) as f:
+    return json.load(f)
+
+def baselines(basedir):
+  '''Returns a list of (saved time, commit, benchmark, path) of all baselines, oldest first.'''
+  found = []
+  if not os.path.isdir(basedir):
+    return found
+  for commit in os.listdir(basedir):
+    cdir = os.path.join(basedir, commit)
+    if not os.path.isdir(cdir):
+      continue
+    for name in os.listdir(cdir):
+      if name.endswith('.json'):
+        path = os.path.join(cdir, name)
+        meta = load(path).get('baseline', {})
+        found.append((meta.get('saved', 0), commit, name[:-5], path))
+  found.sort()
+  return found
+
+def find_baseline(basedir, kind, commit):
+  matches = [b for b in baselines(basedir) if b[2] == kind and (commit is None or b[1].startswith(commit))]
+  if commit is not None and len(set(b[1] for b in matches)) > 1:
+    sys.exit("commit '%s' is ambiguous in %s" % (commit, basedir))
+  return matches[-1] if matches else None
+
+def cmd_save(args):
+  commit = args.commit or git_commit()
+  cdir = os.path.join(args.dir, commit)
+  if not os.path.isdir(cdir):
+    os.makedirs(cdir)
+  for path in args.results:
+    result = load(path)
+    extract(result)        # refuses files of no known benchmark
+    result['baseline'] = {'commit': commit, 'saved': time.time(), 'host': host(), 'source': path}
+    out = os.path.join(cdir, result['benchmark'] + '.json')
+    with open(out, 'w') as f:
+      json.dump(result, f, indent=1, sort_keys=True)
+    print("%s saved as %s" % (path, out))
+
+def cmd_list(args):
+  found = baselines(args.dir)
+  if not found:
+    print("no baselines in %s" % args.dir)
+  for saved, commit, kind, path in found:
+    meta = load(path)['baseline']
+    print("%s  %-24s %-18s %s" % (time.strftime('%Y-%m-%d %H:%M', time.localtime(saved)), commit[:24], kind, meta.get('host', '')))
+
+def thresholds(specs):
+  '''-t 3 sets all metrics, -t name=pct one of them.'''
+  th = dict((m, METRICS[m][1]) for m in METRICS)
+  for spec in specs or []:
+    if '=' in spec:
+      name, pct = spec.split('=', 1)
+      if name not in METRICS:
+        sys.exit("unknown metric '%s' (one of: %s)" % (name, ', '.join(sorted(METRICS))))
+      th[name] = float(pct)
+    else:
+      for m in th:
+        if METRICS[m][0] != 'exact':
+          th[m] = float(spec)
+  return th
+
+def verdict(metric, old, new, threshold):
+  '''Returns the change in % (positive is worse) and the verdict.'''
+  direction = METRICS[metric][0]
+  if old == 0:
+    return 0.0, ('ok' if new == old else 'changed')
+  change = 100.0 * (new - old) / abs(old)
+  if direction == 'exact':
+    return change, ('ok' if new == old else 'changed')
+  worse = change if direction == 'lower' else -change
+  if worse > threshold:
+    return worse, 'SLOWER' if metric != 'peak_rss_kb' else 'LARGER'
+  if worse < -threshold:
+    return worse, 'better'
+  return worse, 'ok'
+
+def fmt(v):
+  if v is None:
+    return '-'
+  if isinstance(v, int) or v == int(v):
+    return '%d' % v
+  return '%.2f' % v
+
+def cmd_compare(args):
+  th = thresholds(args.threshold)
+  rows = []
+  regressions = 0
+  unmatched = 0
+  for path in args.results:
+    result = load(path)
+    kind = result.get('benchmark', '')
+    new, workload = extract(result)
+    base = find_baseline(args.dir, kind, args.baseline)
+    if base is None:
+      print("%s: no baseline of %s in %s" % (path, kind, args.dir))
+      unmatched += 1
+      continue
+    baseres = load(base[3])
+    old, baseworkload = extract(baseres)
+    print("%s against %s (%s)" % (path, base[1], kind))
+    if workload != baseworkload:
+      print("  workload differs: %s, baseline %s" % (workload, baseworkload))
+    if baseres['baseline'].get('host') != host():
+      print("  baseline is from another host: %s" % baseres['baseline'].get('host'))
+
+    for key in sorted(set(old) | set(new)):
+      item, metric = key
+      o, n = old.get(key), new.get(key)
+      if o is None or n is None:
+        rows.append((kind, item, metric, fmt(o), fmt(n), '', '', 'new' if o is None else 'missing'))
+        continue
+      worse, v = verdict(metric, o, n, th[metric])
+      if v in ('SLOWER', 'LARGER'):
+        regressions += 1
+      if args.all or v != 'ok':
+        rows.append((kind, item, metric, fmt(o), fmt(n), '%+.1f%%' % worse, '%g%%' % th[metric], v))
+
+  if rows:
+    head = ('benchmark', 'item', 'metric', 'baseline', 'current', 'worse by', 'threshold', '')
+    widths = [max(len(str(r[i])) for r in rows + [head]) for i in range(len(head))]
+    line = lambda r: '  '.join(str(c).ljust(w) if i < 3 or i == 7 else str(c).rjust(w) for i, (c, w) in enumerate(zip(r, widths)))
+    print('')
+    print(line(head))
+    print(line(['-' * w for w in widths]))
+    for r in rows:
+      print(line(r))
+  print('')
+  print("%d metric(s) worse than the threshold" % regressions)
+  if regressions:
+    return 1
+  return 2 if unmatched else 0
+
+def main():
+  parser = argparse.ArgumentParser(description='benchmark baselines by git commit')
+  parser.add_argument('-d', '--dir', default='baselines', help='baseline directory (default: baselines)')
+  sub = parser.add_subparsers(dest='command')
+
+  p = sub.add_parser('save', help='store results as the baseline of a commit')
+  p.add_argument('-c', '--commit', help='commit to save under (default: git HEAD)')
+  p.add_argument('results', nargs='+')
+
+  p = sub.add_parser('compare', help='compare results with a baseline')
+  p.add_argument('-b', '--baseline', help='commit (or prefix) of the baseline (default: newest)')
+  p.add_argument('-t', '--threshold', action='append',
+                 help='noise threshold in %%, for all metrics (-t 3) or one (-t peak_rss_kb=10)')
+  p.add_argument('-a', '--all', action='store_true', help='show unchanged metrics too')
+  p.add_argument('results', nargs='+')
+
+  sub.add_parser('list', help='list the stored baselines')
+
+  args = parser.parse_args()
+  if args.command == 'save':
+    cmd_save(args)
+  elif args.command == 'compare':
+    sys.exit(cmd_compare(args))
+  elif args.command == 'list':
+    cmd_list(args)
+  else:
+    parser.print_help()
+
+if __name__ == '__main__':
+  main()
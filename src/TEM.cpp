@@ -34,6 +34,7 @@
 using namespace std;
  
 #include "TEMMOD.h"         // set run-mode and output option(s) for site-run 
+#include "util/Logger.h"
 
 #ifdef SITERUN
 	#include "runmodes/Siter.h"
@@ -47,14 +48,13 @@ using namespace std;
        
 int main(int argc, char* argv[]){
 	
-	setvbuf(stdout, NULL, _IONBF, 0);
-	setvbuf(stderr, NULL, _IONBF, 0);
+	Logger::init();       //buffered stdout, see util/Logger.h
 
 	#ifdef REGNRUN
 		time_t stime;
 		time_t etime;
 		stime=time(NULL);
-		cout <<"run TEM regionally - start @"<<ctime(&stime)<<"\n";
+		LOG(LOG_INFO) <<"run TEM regionally - start @"<<ctime(&stime)<<"\n";
 
 		string controlfile="";
 		if(argc==1){ //if there is no control file specified
@@ -70,8 +70,8 @@ int main(int argc, char* argv[]){
 		regner.run();
       
  		etime=time(NULL);
-		cout <<"run TEM regionally - done @"<<ctime(&etime)<<"\n";
-		cout <<"total seconds: "<<difftime(etime, stime)<<"\n";
+		LOG(LOG_INFO) <<"run TEM regionally - done @"<<ctime(&etime)<<"\n";
+		LOG(LOG_INFO) <<"total seconds: "<<difftime(etime, stime)<<"\n";
 
 	#endif
 
@@ -79,7 +79,7 @@ int main(int argc, char* argv[]){
 		time_t stime;
 		time_t etime;
 		stime=time(NULL);
-		cout<<"run TEM stand-alone - start @"<<ctime(&stime)<<"\n";
+		LOG(LOG_INFO) <<"run TEM stand-alone - start @"<<ctime(&stime)<<"\n";
 
 		string controlfile="";
 		if(argc==1){ //if there is no control file specified
@@ -94,8 +94,8 @@ int main(int argc, char* argv[]){
  		siter.run();       
  
  		etime=time(NULL);
-		cout <<"run TEM stand-alone - done @"<<ctime(&etime)<<"\n";
-		cout <<"total seconds: "<<difftime(etime, stime)<<"\n";
+		LOG(LOG_INFO) <<"run TEM stand-alone - done @"<<ctime(&etime)<<"\n";
+		LOG(LOG_INFO) <<"total seconds: "<<difftime(etime, stime)<<"\n";
 	#endif
 
  	return 0;
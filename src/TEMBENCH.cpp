@@ -0,0 +1,366 @@
+////////////////////////////////////////////////////////////////////////////////////////
+/*
+ *  TEMBENCH.cpp
+ *  main program for timing the physics kernels of the ground (soil/snow) column
+ *  on synthetic columns, without any input file
+ *
+ *  usage: DOSTEMBENCH [jsonfile] [-days N] [-reps R]
+ *
+ *      a column is snow + moss + shallow/deep peat + 13 mineral + 5 rock layers, set up from
+ *      the default lookup parameters (CohortLookup) as in an 'initmode 1' run, and
+ *      then brought into one of the states:
+ *         frozen     - frozen soil under snow, cold air
+ *         thawing    - frozen soil, no snow, warm air and rain
+ *         refreezing - after some warm days, cold air without snow (fronts from top and bottom)
+ *         saturated  - unfrozen soil at water holding capacity, heavy rain
+ *
+ *      each kernel runs alone on a new column for N days (default 60), R times (default 5),
+ *      and the median and minimum time of a column-day are written as JSON to jsonfile
+ *      (default 'physicsbench.json'; not to stdout, where the model modules write messages)
+ *
+*/
+/////////////////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <time.h>
+using namespace std;
+
+#include "TEMMOD.h"
+
+#include "run/Cohort.h"
+#include "run/ModelData.h"
+#include "run/Timer.h"
+#include "util/CrankNicholson.h"
+
+/////////////////////////////////////////////////////////////////////////////////
+
+const int NCONFIG = 4;
+const char* CONFIGS[NCONFIG] = {"frozen", "thawing", "refreezing", "saturated"};
+
+const int NKERNEL = 5;
+const char* KERNELS[NKERNEL] = {"ground_day", "stefan", "richard", "cranknicholson", "soillayer_property"};
+
+const int BENCH_DRGTYPE = 0;
+const int BENCH_VEGTYPE = 4;
+
+double wallclock(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec*1.e9 + ts.tv_nsec;     //ns
+};
+
+//daily forcing of a configuration
+struct DayForcing {
+	double tair;    //degC
+	double snow;    //mm/day
+	double rain;    //mm/day
+};
+
+DayForcing prepForcing(const int & config){
+	DayForcing f;
+	f.tair = -15.;
+	f.snow = 5.;
+	f.rain = 0.;
+	if (config==1) {
+		f.tair = 12.;
+		f.snow = 0.;
+		f.rain = 2.;
+	} else if (config==2) {
+		f.tair = 12.;
+		f.snow = 0.;
+		f.rain = 2.;
+	} else if (config==3) {
+		f.tair = 8.;
+		f.snow = 0.;
+		f.rain = 15.;
+	}
+	return f;
+};
+
+DayForcing runForcing(const int & config){
+	DayForcing f;
+	f.tair = -20.;
+	f.snow = 0.;
+	f.rain = 0.;
+	if (config==1) {
+		f.tair = 12.;
+		f.rain = 2.;
+	} else if (config==2) {
+		f.tair = -10.;
+	} else if (config==3) {
+		f.tair = 8.;
+		f.rain = 15.;
+	}
+	return f;
+};
+
+int prepDays(const int & config){
+	if (config==0) return 30;       //snow pack
+	if (config==2) return 60;       //thawed top soil
+	return 0;
+};
+
+// one synthetic column, with the data sets a Cohort needs
+class BenchColumn {
+	public:
+		BenchColumn(const int & config);
+
+		EnvData ed;
+		BgcData bd;
+		FirData fd;
+		ModelData md;
+		RegionData rd;
+		GridData gd;
+		CohortData cd;
+		Timer timer;
+		Cohort cht;
+
+		void forceDay(const DayForcing & f);
+		int groundDay(const DayForcing & f);
+		int stefanDay(const DayForcing & f);
+		void richardDay(const DayForcing & f);
+
+	private:
+		void unfreeze(const double & tem);
+};
+
+BenchColumn::BenchColumn(const int & config){
+	md.initmode = 1;
+	md.runeq    = true;
+	cd.drgtype  = BENCH_DRGTYPE;
+	cd.vegtype  = BENCH_VEGTYPE;
+
+	gd.topclay = 20;
+	gd.topsand = 40;
+	gd.topsilt = 40;
+	gd.botclay = 30;
+	gd.botsand = 30;
+	gd.botsilt = 40;
+
+	cht.setTime(&timer);
+	cht.setProcessData(&ed, &bd, &fd);
+	cht.setModelData(&md);
+	cht.setInputData(&rd, &gd, &cd);
+	cht.init();
+
+	//all organic horizons present
+	cht.chtlu.mossthick[BENCH_DRGTYPE][BENCH_VEGTYPE] = 0.04;
+	cht.chtlu.fibthick[BENCH_DRGTYPE][BENCH_VEGTYPE]  = 0.10;
+	cht.chtlu.humthick[BENCH_DRGTYPE][BENCH_VEGTYPE]  = 0.20;
+	cht.reset();
+
+	ed.d_soid.nfactor = 1.;
+	ed.y_vegd.vegfrac = 0.;
+
+	if (config==3) unfreeze(3.);
+
+	DayForcing f = prepForcing(config);
+	for (int id=0; id<prepDays(config); id++) groundDay(f);
+};
+
+//soil and rock above zero, soil water as liquid up to its holding capacity
+void BenchColumn::unfreeze(const double & tem){
+	for (Layer* currl=cht.ground.fstsoill; currl!=NULL; currl=currl->nextl) {
+		currl->tem = tem;
+		if (currl->isSoil()) {
+			currl->frozen = -1;
+			currl->liq = currl->maxliq;
+			currl->ice = 0.;
+		}
+	}
+};
+
+void BenchColumn::forceDay(const DayForcing & f){
+	ed.beginOfDay();
+	ed.d_atms.ta   = f.tair;
+	ed.d_a2l.snfl  = f.snow;
+	ed.d_a2l.rnfl  = f.rain;
+	ed.d_v2g.rthfl = 0.;
+	ed.d_v2g.rdrip = 0.;
+	ed.d_v2a.trans = 0.;
+};
+
+int BenchColumn::groundDay(const DayForcing & f){
+	forceDay(f);
+	return cht.ground.updateDaily(0, 1901, 6, 0, f.tair, 12.);
+};
+
+// fronts and temperatures, as in Ground::updateDaily() without the snow and water
+int BenchColumn::stefanDay(const DayForcing & f){
+	forceDay(f);
+	Ground & g = cht.ground;
+	int error = 0;
+	if (g.fstfntl==NULL) {
+		int tstate = g.fstsoill->frozen;
+		if (g.frontl->isSoil() && ((tstate==1 && f.tair>0) || (tstate==-1 && f.tair<0) || tstate==0)) {
+			error = g.soil.stefan.updateFronts(f.tair, g.frontl, g.backl, g.fstsoill, g.lstminl, 6);
+		}
+	} else {
+		error = g.soil.stefan.updateFronts(f.tair, g.frontl, g.backl, g.fstsoill, g.lstminl, 6);
+		if (error==0) error = g.soil.stefan.checkFrontsValidity(g.fstsoill);
+	}
+
+	g.fstfntl = NULL;
+	g.lstfntl = NULL;
+	for (Layer* currl=g.fstsoill; currl!=NULL; currl=currl->nextl) {
+		if (currl->isSoil() && dynamic_cast<SoilLayer*>(currl)->fronts.size()>0) {
+			if (g.fstfntl==NULL) g.fstfntl = currl;
+			g.lstfntl = currl;
+		}
+	}
+
+	g.soil.stefan.updateTemps(f.tair, g.frontl, g.backl, g.fstsoill, g.fstfntl, g.lstfntl);
+	return error;
+};
+
+void BenchColumn::richardDay(const DayForcing & f){
+	forceDay(f);
+	Ground & g = cht.ground;
+	double drain = 0.;
+	double infil = f.rain/86400.;    //mm/s
+	double zwt   = g.soil.getWaterTable(g.fstsoill);
+	g.soil.richard.update(g.frontl, g.backl, g.fstsoill, g.drainl, drain, 0., 0., infil, zwt);
+};
+
+/////////////////////////////////////////////////////////////////////////////////
+
+// the layer arrays (1-based, as in Stefan/Richard) of a column for Crank-Nicholson
+struct ColumnArrays {
+	int numl;
+	double t[MAX_GRN_LAY+2], dx[MAX_GRN_LAY+2], cn[MAX_GRN_LAY+2], cap[MAX_GRN_LAY+2];
+	double s[MAX_GRN_LAY+2], e[MAX_GRN_LAY+2], tnew[MAX_GRN_LAY+2];
+	double a[MAX_GRN_LAY+2], b[MAX_GRN_LAY+2], c[MAX_GRN_LAY+2], r[MAX_GRN_LAY+2], u[MAX_GRN_LAY+2];
+};
+
+void columnArrays(Ground & g, ColumnArrays & ca){
+	int il = 0;
+	for (Layer* currl=g.frontl; currl!=NULL && il<MAX_GRN_LAY; currl=currl->nextl) {
+		il++;
+		ca.t[il]   = currl->tem;
+		ca.dx[il]  = currl->dz;
+		ca.cn[il]  = currl->getThermalConductivity()/currl->dz;
+		ca.cap[il] = currl->getHeatCapacity()*currl->dz;
+
+		ca.a[il] = -1.;
+		ca.b[il] = 4.+0.01*il;
+		ca.c[il] = -1.;
+		ca.r[il] = currl->tem;
+	}
+	ca.numl = il;
+};
+
+double cnDay(ColumnArrays & ca){
+	double dt = 1.;
+	CrankNicholson cns;
+	cns.geBackward(1, ca.numl, ca.t, ca.dx, ca.cn, ca.cap, ca.s, ca.e, dt, true);
+	cns.cnForward(1, ca.numl, ca.t, ca.tnew, ca.s, ca.e);
+	cns.tridiagonal(1, ca.numl, ca.a, ca.b, ca.c, ca.r, ca.u);
+	return ca.tnew[ca.numl/2]+ca.u[ca.numl/2];
+};
+
+// the property functions of every soil layer, once (not getHydraulicCond1(), which is not used)
+double propertyColumn(Ground & g){
+	double sum = 0.;
+	for (Layer* currl=g.fstsoill; currl!=NULL; currl=currl->nextl) {
+		if (!currl->isSoil()) break;
+		SoilLayer* sl = dynamic_cast<SoilLayer*>(currl);
+		sum += sl->getFrzThermCond() + sl->getUnfThermCond();
+		sum += sl->getFrzVolHeatCapa() + sl->getUnfVolHeatCapa() + sl->getMixVolHeatCapa();
+		sum += sl->getMatricPotential() + sl->getFrozenFraction();
+		sum += sl->getAlbedoVis() + sl->getAlbedoNir();
+		sum += sl->getThermalConductivity() + sl->getHeatCapacity();
+	}
+	return sum;
+};
+
+/////////////////////////////////////////////////////////////////////////////////
+
+// ns per column-day of one kernel on a new column
+double timeKernel(const int & kernel, const int & config, const int & ndays, double & sink){
+	BenchColumn * col = new BenchColumn(config);
+	DayForcing f = runForcing(config);
+	Ground & g = col->cht.ground;
+	ColumnArrays ca;
+	if (kernel==3) columnArrays(g, ca);
+
+	double t0 = wallclock();
+	for (int id=0; id<ndays; id++) {
+		if (kernel==0) {
+			sink += col->groundDay(f);
+		} else if (kernel==1) {
+			sink += col->stefanDay(f);
+		} else if (kernel==2) {
+			col->richardDay(f);
+		} else if (kernel==3) {
+			sink += cnDay(ca);
+		} else {
+			sink += propertyColumn(g);
+		}
+	}
+	double t1 = wallclock();
+
+	sink += g.frontl->tem;
+	delete col;
+	return (t1-t0)/ndays;
+};
+
+int main(int argc, char* argv[]){
+
+	string jsonfile = "physicsbench.json";
+	int ndays = 60;
+	int nreps = 5;
+	for (int i=1; i<argc; i++) {
+		if (strcmp(argv[i], "-days")==0 && i+1<argc) {
+			ndays = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-reps")==0 && i+1<argc) {
+			nreps = atoi(argv[++i]);
+		} else if (argv[i][0]!='-') {
+			jsonfile = argv[i];
+		} else {
+			cout <<"usage: "<<argv[0]<<" [jsonfile] [-days N] [-reps R]\n";
+			return -1;
+		}
+	}
+	if (ndays<1) ndays = 1;
+	if (nreps<1) nreps = 1;
+
+	FILE * out = fopen(jsonfile.c_str(), "w");
+	if (out==NULL) {
+		cout <<"cannot open "<<jsonfile<<"\n";
+		return -1;
+	}
+
+	double sink = 0.;
+	fprintf(out, "{\n\"benchmark\": \"dostem-physics\",\n\"version\": 1,\n");
+	fprintf(out, "\"days\": %d,\n\"reps\": %d,\n\"unit\": \"ns/column-day\",\n\"results\": [", ndays, nreps);
+	bool first = true;
+	for (int ik=0; ik<NKERNEL; ik++) {
+		for (int ic=0; ic<NCONFIG; ic++) {
+			vector<double> ns;
+			try {
+				for (int ir=0; ir<nreps; ir++) ns.push_back(timeKernel(ik, ic, ndays, sink));
+			} catch (Exception &exception) {
+				cout <<"problem in "<<KERNELS[ik]<<"/"<<CONFIGS[ic]<<"\n";
+				exception.mesg();
+				continue;
+			}
+			sort(ns.begin(), ns.end());
+			fprintf(out, "%s\n{\"kernel\": \"%s\", \"config\": \"%s\", \"median\": %.1f, \"min\": %.1f}",
+					first ? "" : ",", KERNELS[ik], CONFIGS[ic], ns[ns.size()/2], ns[0]);
+			first = false;
+		}
+	}
+	fprintf(out, "\n]\n}\n");
+	fclose(out);
+	cout <<"physics benchmark written to "<<jsonfile<<"\n";
+
+	if (sink!=sink) cout <<"NaN in a column state\n";    //keeps the results used
+	return 0;
+
+};
@@ -0,0 +1,352 @@
+////////////////////////////////////////////////////////////////////////////////////////
+/*
+ *  TEMINTEG.cpp
+ *  main program for timing the monthly bgc integration (Integrator, RKF45) and checking
+ *  its accuracy, on months of real cohorts recorded by 'integratordump <file>' in the
+ *  control file of a run (see util/IntegratorDump.h)
+ *
+ *  usage: DOSTEMINTEG dumpfile [jsonfile] [-reps R] [-refsteps N] [-months M]
+ *
+ *      every recorded month (at most M, default all) is restored and integrated by
+ *      Integrator::updateMonthly() as in the run, with its counters (derivative evaluations,
+ *      accepted/rejected/forced steps, months given up) and the median wall time of
+ *      R repetitions (default 5). The integrated pools are
+ *         - checked against the ones recorded in the run ('replay' mismatches, which should
+ *           be none for a dump of the same build), and
+ *         - compared with a reference: the same derivatives (Soil_Bgc/Vegetation_Bgc delta)
+ *           integrated in double precision by classical RK4 with N fixed steps (default 1024),
+ *           whose own error is estimated from the one with N/2 steps
+ *      the results are written as JSON to jsonfile (default 'integbench.json')
+ *
+*/
+/////////////////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+#include <time.h>
+using namespace std;
+
+#include "TEMMOD.h"
+
+#include "util/Integrator.h"
+#include "util/IntegratorDump.h"
+
+/////////////////////////////////////////////////////////////////////////////////
+
+double wallclock(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec*1.e9 + ts.tv_nsec;     //ns
+};
+
+//the objects Integrator works on, as linked in a Cohort
+class ReplayColumn{
+	public:
+		ReplayColumn();
+		void restore(const IntegratorRecord & rec);
+
+		EnvData ed;
+		BgcData bd;
+		FirData fd;
+		CohortData cd;
+		CohortLookup chtlu;
+		Soil_Bgc sb;
+		Vegetation_Bgc vb;
+		Integrator integ;
+};
+
+ReplayColumn::ReplayColumn(){
+	bd.cd = &cd;
+	ed.cd = &cd;
+	integ.setSoil_Bgc(&sb);
+	integ.setVegetation_Bgc(&vb);
+	integ.setBgcData(&bd);
+	integ.setEnvData(&ed);
+};
+
+void ReplayColumn::restore(const IntegratorRecord & rec){
+	IntegratorDump::restore(rec, &sb, &vb, &ed, &bd, &fd, &chtlu);
+};
+
+/////////////////////////////////////////////////////////////////////////////////
+// the pools, in the order of Integrator::temkey
+
+int numPools(const int & numsl){
+	return 7+2*numsl;
+};
+
+int poolKey(const int & ip){
+	if (ip<7) return ip;      //I_VEGC ... I_WDEBRIS
+	int il = (ip-7)/2;
+	return ((ip-7)%2==0) ? Integrator::I_L_REAC+il : Integrator::I_L_NONC+il;
+};
+
+void getPools(const vegstate_bgc & vegs, const soistate_bgc & sois, const int & numsl, double pool[]){
+	pool[Integrator::I_VEGC]       = vegs.c;
+	pool[Integrator::I_STRN]       = vegs.strn;
+	pool[Integrator::I_STON]       = vegs.ston;
+	pool[Integrator::I_SOLN]       = sois.orgn;
+	pool[Integrator::I_AVLN]       = sois.avln;
+	pool[Integrator::I_UNNORMLEAF] = vegs.unnormleaf;
+	pool[Integrator::I_WDEBRIS]    = sois.wdebris;
+	for (int il=0; il<numsl; il++) {
+		pool[7+2*il]   = sois.reac[il];
+		pool[7+2*il+1] = sois.nonc[il];
+	}
+};
+
+// the state derivatives, as Integrator::delta() but in double precision
+void derivs(ReplayColumn & col, const int & numsl, const double pool[], double dpool[]){
+	Soil_Bgc & sb = col.sb;
+	Vegetation_Bgc & vb = col.vb;
+
+	vb.tmp_vegs.c          = pool[Integrator::I_VEGC];
+	vb.tmp_vegs.strn       = pool[Integrator::I_STRN];
+	vb.tmp_vegs.ston       = pool[Integrator::I_STON];
+	vb.tmp_vegs.unnormleaf = pool[Integrator::I_UNNORMLEAF];
+	for (int il=0; il<numsl; il++) {
+		sb.tmp_sois.reac[il] = pool[7+2*il];
+		sb.tmp_sois.nonc[il] = pool[7+2*il+1];
+	}
+	sb.tmp_sois.orgn    = pool[Integrator::I_SOLN];
+	sb.tmp_sois.avln    = pool[Integrator::I_AVLN];
+	sb.tmp_sois.wdebris = pool[Integrator::I_WDEBRIS];
+
+	sb.delta();
+	vb.delta();
+	vb.deltanfeed();
+	sb.del_soi2v = vb.del_soi2v;
+	sb.del_v2soi = vb.del_v2soi;
+	sb.deltaavln();
+	sb.deltastate();
+	vb.deltastate();
+
+	dpool[Integrator::I_VEGC]       = vb.del_vegs.c;
+	dpool[Integrator::I_STRN]       = vb.del_vegs.strn;
+	dpool[Integrator::I_STON]       = vb.del_vegs.ston;
+	dpool[Integrator::I_SOLN]       = sb.del_sois.orgn;
+	dpool[Integrator::I_AVLN]       = sb.del_sois.avln;
+	dpool[Integrator::I_UNNORMLEAF] = vb.del_vegs.unnormleaf;
+	dpool[Integrator::I_WDEBRIS]    = sb.del_sois.wdebris;
+	for (int il=0; il<numsl; il++) {
+		dpool[7+2*il]   = sb.del_sois.reac[il];
+		dpool[7+2*il+1] = sb.del_sois.nonc[il];
+	}
+};
+
+// the pools after one month (time 0 to 1) of 'nstep' classical RK4 steps
+void referenceMonth(ReplayColumn & col, const IntegratorRecord & rec, const int & nstep, double pool[]){
+	col.restore(rec);
+	int numsl = col.ed.m_soid.actual_num_soil;
+	int np = numPools(numsl);
+	getPools(col.bd.m_vegs, col.bd.m_sois, numsl, pool);
+
+	vector<double> k1(np), k2(np), k3(np), k4(np), tmp(np);
+	double h = 1./nstep;
+	for (int is=0; is<nstep; is++) {
+		derivs(col, numsl, pool, &k1[0]);
+		for (int i=0; i<np; i++) tmp[i] = pool[i]+0.5*h*k1[i];
+		derivs(col, numsl, &tmp[0], &k2[0]);
+		for (int i=0; i<np; i++) tmp[i] = pool[i]+0.5*h*k2[i];
+		derivs(col, numsl, &tmp[0], &k3[0]);
+		for (int i=0; i<np; i++) tmp[i] = pool[i]+h*k3[i];
+		derivs(col, numsl, &tmp[0], &k4[0]);
+		for (int i=0; i<np; i++) pool[i] += h/6.*(k1[i]+2.*k2[i]+2.*k3[i]+k4[i]);
+	}
+};
+
+double relDiff(const double & a, const double & ref){
+	double d = fabs(a-ref);
+	if (d==0.) return 0.;
+	return d/max(fabs(ref), 1.e-9);
+};
+
+/////////////////////////////////////////////////////////////////////////////////
+
+struct MonthResult{
+	int chtid;
+	int yrcnt;
+	int month;
+	rkfstats stats;
+	double ns;            //median wall time of updateMonthly()
+	int worst;            //pool of the largest relative drift
+	double drift;         //largest relative drift of a pool
+	double totcdrift;     //drift of total carbon (gC/m2)
+	double referr;        //largest relative error of the reference, by N vs. N/2 steps
+	bool replayed;        //same pools as in the run
+};
+
+MonthResult runMonth(ReplayColumn & col, const IntegratorRecord & rec, const int & nreps, const int & nstep){
+	MonthResult res;
+	res.chtid = rec.chtid;
+	res.yrcnt = rec.yrcnt;
+	res.month = rec.month;
+
+	//the counters and pools of one integration, as in the run
+	col.restore(rec);
+	col.integ.resetStats();
+	col.integ.updateMonthly();
+	res.stats = col.integ.stats;
+
+	int numsl = col.ed.m_soid.actual_num_soil;
+	int np = numPools(numsl);
+	vector<double> pool(np), recpool(np), ref(np), ref2(np);
+	getPools(col.bd.m_vegs, col.bd.m_sois, numsl, &pool[0]);
+	getPools(rec.vegsout, rec.soisout, numsl, &recpool[0]);
+	res.replayed = true;
+	for (int i=0; i<np; i++) {
+		if (pool[i]!=recpool[i]) res.replayed = false;
+	}
+
+	vector<double> ns;
+	for (int ir=0; ir<nreps; ir++) {
+		col.restore(rec);
+		double t0 = wallclock();
+		col.integ.updateMonthly();
+		ns.push_back(wallclock()-t0);
+	}
+	sort(ns.begin(), ns.end());
+	res.ns = ns[ns.size()/2];
+
+	referenceMonth(col, rec, nstep, &ref[0]);
+	referenceMonth(col, rec, max(nstep/2, 1), &ref2[0]);
+
+	res.worst  = 0;
+	res.drift  = 0.;
+	res.referr = 0.;
+	double totc = 0.;
+	double reftotc = 0.;
+	for (int i=0; i<np; i++) {
+		double d = relDiff(pool[i], ref[i]);
+		if (d>res.drift) {
+			res.drift = d;
+			res.worst = i;
+		}
+		res.referr = max(res.referr, relDiff(ref2[i], ref[i]));
+
+		int key = poolKey(i);
+		if (key==Integrator::I_VEGC || key==Integrator::I_WDEBRIS || i>=7) {
+			totc    += pool[i];
+			reftotc += ref[i];
+		}
+	}
+	res.totcdrift = totc-reftotc;
+
+	return res;
+};
+
+int main(int argc, char* argv[]){
+
+	string dumpfile = "";
+	string jsonfile = "integbench.json";
+	int nreps  = 5;
+	int nstep  = 1024;
+	long maxmonths = -1;
+	for (int i=1; i<argc; i++) {
+		if (strcmp(argv[i], "-reps")==0 && i+1<argc) {
+			nreps = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-refsteps")==0 && i+1<argc) {
+			nstep = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-months")==0 && i+1<argc) {
+			maxmonths = atol(argv[++i]);
+		} else if (argv[i][0]!='-' && dumpfile=="") {
+			dumpfile = argv[i];
+		} else if (argv[i][0]!='-') {
+			jsonfile = argv[i];
+		} else {
+			dumpfile = "";
+			break;
+		}
+	}
+	if (dumpfile=="") {
+		cout <<"usage: "<<argv[0]<<" dumpfile [jsonfile] [-reps R] [-refsteps N] [-months M]\n";
+		return -1;
+	}
+	if (nreps<1) nreps = 1;
+	if (nstep<2) nstep = 2;
+
+	FILE * in = IntegratorDump::openRead(dumpfile);
+	if (in==NULL) return -1;
+
+	ReplayColumn * col = new ReplayColumn();
+	IntegratorRecord * rec = new IntegratorRecord();
+	vector<MonthResult> results;
+	long nfailed = 0;
+	while ((maxmonths<0 || (long)results.size()+nfailed<maxmonths) && IntegratorDump::read(in, *rec)) {
+		try {
+			results.push_back(runMonth(*col, *rec, nreps, nstep));
+		} catch (Exception &exception) {
+			cout <<"problem in month "<<rec->month<<" of year "<<rec->yrcnt<<" of cohort "<<rec->chtid<<"\n";
+			exception.mesg();
+			nfailed++;
+		}
+	}
+	fclose(in);
+
+	FILE * out = fopen(jsonfile.c_str(), "w");
+	if (out==NULL) {
+		cout <<"cannot open "<<jsonfile<<"\n";
+		return -1;
+	}
+
+	rkfstats tot;
+	memset(&tot, 0, sizeof(tot));
+	vector<double> ns;
+	double maxdrift = 0.;
+	double sumdrift = 0.;
+	double maxreferr = 0.;
+	long nmismatch = 0;
+	for (unsigned int im=0; im<results.size(); im++) {
+		const MonthResult & r = results[im];
+		tot.derivs   += r.stats.derivs;
+		tot.accepted += r.stats.accepted;
+		tot.rejected += r.stats.rejected;
+		tot.forced   += r.stats.forced;
+		tot.blackhol += r.stats.blackhol;
+		ns.push_back(r.ns);
+		maxdrift  = max(maxdrift, r.drift);
+		sumdrift += r.drift;
+		maxreferr = max(maxreferr, r.referr);
+		if (!r.replayed) nmismatch++;
+	}
+	sort(ns.begin(), ns.end());
+	double nmon = max((double)results.size(), 1.);
+
+	fprintf(out, "{\n\"benchmark\": \"dostem-integrator\",\n\"version\": 1,\n");
+	fprintf(out, "\"dumpfile\": \"%s\",\n\"months\": %d,\n\"failed\": %ld,\n\"reps\": %d,\n\"refsteps\": %d,\n",
+			dumpfile.c_str(), (int)results.size(), nfailed, nreps, nstep);
+	fprintf(out, "\"summary\": {\"derivs_per_month\": %.2f, \"accepted_per_month\": %.2f, \"rejected_per_month\": %.2f, "
+			"\"forced\": %ld, \"blackhol\": %ld, \"ns_per_month_median\": %.1f, \"ns_total\": %.1f, "
+			"\"max_rel_drift\": %.3e, \"mean_rel_drift\": %.3e, \"max_ref_err\": %.3e, \"replay_mismatches\": %ld},\n",
+			tot.derivs/nmon, tot.accepted/nmon, tot.rejected/nmon, tot.forced, tot.blackhol,
+			ns.empty() ? 0. : ns[ns.size()/2], ns.empty() ? 0. : accumulate(ns.begin(), ns.end(), 0.),
+			maxdrift, sumdrift/nmon, maxreferr, nmismatch);
+	fprintf(out, "\"results\": [");
+	Integrator names;
+	for (unsigned int im=0; im<results.size(); im++) {
+		const MonthResult & r = results[im];
+		string pool = names.predstr[poolKey(r.worst)];
+		pool.erase(remove(pool.begin(), pool.end(), ' '), pool.end());
+		fprintf(out, "%s\n{\"chtid\": %d, \"yrcnt\": %d, \"month\": %d, \"derivs\": %ld, \"accepted\": %ld, "
+				"\"rejected\": %ld, \"forced\": %ld, \"blackhol\": %ld, \"ns\": %.1f, \"pool\": \"%s\", "
+				"\"rel_drift\": %.3e, \"totc_drift\": %.3e, \"ref_err\": %.3e, \"replayed\": %s}",
+				im==0 ? "" : ",", r.chtid, r.yrcnt, r.month, r.stats.derivs, r.stats.accepted,
+				r.stats.rejected, r.stats.forced, r.stats.blackhol, r.ns, pool.c_str(),
+				r.drift, r.totcdrift, r.referr, r.replayed ? "true" : "false");
+	}
+	fprintf(out, "\n]\n}\n");
+	fclose(out);
+	cout <<"integrator benchmark of "<<results.size()<<" months written to "<<jsonfile<<"\n";
+
+	delete rec;
+	delete col;
+	return (nmismatch>0 || nfailed>0) ? 1 : 0;
+
+};
@@ -16,6 +16,23 @@
 	#define SITERUN
 //	#define REGNRUN
 
+	//phase timing of the cohort runs, written to 'phasetimer.txt' in the output directory
+	//(see util/PhaseTimer.h); leave it off for production runs
+//	#define PHASETIMER
+	//with PHASETIMER, also the hardware counters (cycles, instructions, cache and branch misses)
+	//of each phase, if the system allows (see util/PerfCounters.h)
+//	#define PHASECOUNTERS
+
+	//the most detailed console messages compiled in (see util/Logger.h): 0 errors, 1 warnings,
+	//2 info, 3 debug (with the yearly progress); 'loglevel' in the control file selects up to this
+	#define LOGLEVELMAX 3
+
+	//the derived daily climate drivers (saturated vapour pressure, deficits, ...) of a month
+	//computed together, 4 days at a time with SSE2, within a few ulp of the exact functions
+	//(see atmosphere/AtmosUtil.h); off by default, as the model results then drift slightly
+	//(up to ~1e-4 relative) from those of the exact functions
+//	#define SIMDDAYDRIVERS
+
 	//the output time-step option(s) for SITE-RUN
 	#ifdef SITERUN
 		const bool SITEMODE=true;
@@ -0,0 +1,279 @@
+////////////////////////////////////////////////////////////////////////////////////////
+/*
+ *  TEMPACK.cpp
+ *  main program for packing the netcdf inputs of a DOS-TEM run into ONE binary file
+ *  (see input/InputPack.h), which then is set as 'inputpack' in the control file
+ *
+ *  usage: DOSTEMPACK controlfile packfile [-verify]
+ *
+ *      the control file is the same one as for the run, i.e. the pack is for
+ *      its run stage and input directories only.
+ *      with '-verify', all records read from the pack are compared with those
+ *      read from the netcdf files
+ *
+*/
+/////////////////////////////////////////////////////////////////////////////////////////
+
+//include
+
+#include <string>
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+using namespace std;
+
+#include "TEMMOD.h"
+
+#include "run/Controller.h"
+#include "run/ModelData.h"
+#include "input/InputPack.h"
+#include "input/RegionInputer.h"
+#include "input/GridInputer.h"
+#include "input/CohortInputer.h"
+
+/////////////////////////////////////////////////////////////////////////////////
+
+int nerr = 0;
+
+void checkInt(const string & what, const int & recid, const int * a, const int * b, const int & n){
+	for (int i=0; i<n; i++) {
+		if (a[i]!=b[i]) {
+			cout <<"record "<<recid<<" "<<what<<"["<<i<<"]: netcdf "<<a[i]<<" vs. pack "<<b[i]<<"\n";
+			nerr++;
+			return;
+		}
+	}
+};
+
+void checkFloat(const string & what, const int & recid, const float * a, const float * b, const int & n){
+	for (int i=0; i<n; i++) {
+		if (a[i]!=b[i] && !(a[i]!=a[i] && b[i]!=b[i])) {
+			cout <<"record "<<recid<<" "<<what<<"["<<i<<"]: netcdf "<<a[i]<<" vs. pack "<<b[i]<<"\n";
+			nerr++;
+			return;
+		}
+	}
+};
+
+void checkGridData(const int & recid, GridData * a, GridData * b){
+	checkFloat("LAT", recid, &a->lat, &b->lat, 1);
+	checkFloat("LON", recid, &a->lon, &b->lon, 1);
+	checkInt("CLAYTOP", recid, &a->topclay, &b->topclay, 1);
+	checkInt("CLAYBOT", recid, &a->botclay, &b->botclay, 1);
+	checkInt("SANDTOP", recid, &a->topsand, &b->topsand, 1);
+	checkInt("SANDBOT", recid, &a->botsand, &b->botsand, 1);
+	checkInt("SILTTOP", recid, &a->topsilt, &b->topsilt, 1);
+	checkInt("SILTBOT", recid, &a->botsilt, &b->botsilt, 1);
+	checkFloat("ELEV", recid, &a->elevation, &b->elevation, 1);
+	checkFloat("SLOPE", recid, &a->slope, &b->slope, 1);
+	checkFloat("ASP", recid, &a->aspect, &b->aspect, 1);
+	checkFloat("FA", recid, &a->flowacc, &b->flowacc, 1);
+
+	checkInt("atm years", recid, &a->act_atm_drv_yr, &b->act_atm_drv_yr, 1);
+	int nclm = a->act_atm_drv_yr*12;
+	checkFloat("TAIR", recid, &a->ta[0][0], &b->ta[0][0], nclm);
+	checkFloat("PREC", recid, &a->prec[0][0], &b->prec[0][0], nclm);
+	checkFloat("NIRR", recid, &a->nirr[0][0], &b->nirr[0][0], nclm);
+	checkFloat("VAPO", recid, &a->vap[0][0], &b->vap[0][0], nclm);
+
+	checkInt("FRI", recid, &a->fri, &b->fri, 1);
+};
+
+void checkFire(const string & stg, const int & recid, CohortInputer & ncin, CohortInputer & pkin){
+	int nc[4][MAX_SP_YR+MAX_TR_YR+MAX_SC_YR];
+	int pk[4][MAX_SP_YR+MAX_TR_YR+MAX_SC_YR];
+	int numyr = 0;
+	if (stg=="SP") {
+		numyr = ncin.firesp_drv_yr;
+		ncin.getSpinupFire(nc[0], nc[1], nc[2], nc[3], recid);
+		pkin.getSpinupFire(pk[0], pk[1], pk[2], pk[3], recid);
+	} else if (stg=="TR") {
+		numyr = ncin.firetr_drv_yr;
+		ncin.getTransientFire(nc[0], nc[1], nc[2], nc[3], recid);
+		pkin.getTransientFire(pk[0], pk[1], pk[2], pk[3], recid);
+	} else if (stg=="SC") {
+		numyr = ncin.firesc_drv_yr;
+		ncin.getScenarioFire(nc[0], nc[1], nc[2], nc[3], recid);
+		pkin.getScenarioFire(pk[0], pk[1], pk[2], pk[3], recid);
+	}
+	checkInt(stg+"/DOB", recid, nc[0], pk[0], numyr);
+	checkInt(stg+"/MOB", recid, nc[1], pk[1], numyr);
+	checkInt(stg+"/YOB", recid, nc[2], pk[2], numyr);
+	checkInt(stg+"/AOB", recid, nc[3], pk[3], numyr);
+};
+
+// every record of current run stage, and every record it refers to, from both paths
+void verify(ModelData & md, InputPack & pack, RegionInputer & rin, GridInputer & gin, CohortInputer & cin){
+
+	RegionInputer pkrin;
+	GridInputer pkgin;
+	CohortInputer pkcin;
+	pkrin.setModelData(&md);
+	pkgin.setModelData(&md);
+	pkcin.setModelData(&md);
+	pkrin.setInputPack(&pack);
+	pkgin.setInputPack(&pack);
+	pkcin.setInputPack(&pack);
+	pkgin.init();
+	pkcin.init();
+
+	RegionData * rd1 = new RegionData();
+	RegionData * rd2 = new RegionData();
+	rin.getCO2(rd1);
+	pkrin.getCO2(rd2);
+	checkInt("CO2 years", 0, &rd1->act_co2_drv_yr, &rd2->act_co2_drv_yr, 1);
+	checkInt("CO2 YEAR", 0, rd1->co2year, rd2->co2year, rd1->act_co2_drv_yr);
+	checkFloat("CO2", 0, rd1->co2, rd2->co2, rd1->act_co2_drv_yr);
+	delete rd1;
+	delete rd2;
+
+	string stg = "SC";
+	if (md.runeq) {
+		stg = "EQ";
+	} else if (md.runsp) {
+		stg = "SP";
+	} else if (md.runtr) {
+		stg = "TR";
+	}
+	int nrec = pack.getNrec(stg+"/"+stg+"CHTID");
+	int neqrec = pack.getNrec("EQ/EQCHTID");
+
+	GridData * gd1 = new GridData();
+	GridData * gd2 = new GridData();
+	for (int r=0; r<nrec; r++) {
+		int id1[2];
+		int id2[2];
+
+		cin.getChtID(id1[0], r);
+		pkcin.getChtID(id2[0], r);
+		checkInt(stg+"CHTID", r, id1, id2, 1);
+		int chtid = id1[0];
+
+		cin.getClmID(id1[0], r);
+		pkcin.getClmID(id2[0], r);
+		checkInt("CLMID", r, id1, id2, 1);
+		int clmid = id1[0];
+
+		//the parent cohort(s), as in Regioner::run()
+		int eqchtid = chtid;
+		if (stg=="SC") {
+			id1[0] = cin.getScRecID(chtid);
+			id2[0] = pkcin.getScRecID(chtid);
+			checkInt("SC record", r, id1, id2, 1);
+			cin.getTrchtid5ScFile(id1[1], id1[0]);
+			pkcin.getTrchtid5ScFile(id2[1], id2[0]);
+			checkInt("SC/TRCHTID", r, &id1[1], &id2[1], 1);
+			chtid = id1[1];
+		}
+		if (stg=="SC" || stg=="TR") {
+			id1[0] = cin.getTrRecID(chtid);
+			id2[0] = pkcin.getTrRecID(chtid);
+			checkInt("TR record", r, id1, id2, 1);
+			cin.getSpchtid5TrFile(id1[1], id1[0]);
+			pkcin.getSpchtid5TrFile(id2[1], id2[0]);
+			checkInt("TR/SPCHTID", r, &id1[1], &id2[1], 1);
+			chtid = id1[1];
+		}
+		if (stg!="EQ") {
+			id1[0] = cin.getSpRecID(chtid);
+			id2[0] = pkcin.getSpRecID(chtid);
+			checkInt("SP record", r, id1, id2, 1);
+			cin.getEqchtid5SpFile(id1[1], id1[0]);
+			pkcin.getEqchtid5SpFile(id2[1], id2[0]);
+			checkInt("SP/EQCHTID", r, &id1[1], &id2[1], 1);
+			eqchtid = id1[1];
+		}
+
+		int eqcid = cin.getEqRecID(eqchtid);
+		id2[0] = pkcin.getEqRecID(eqchtid);
+		checkInt("EQ record", r, &eqcid, id2, 1);
+		if (eqcid>=0) {
+			cin.getVegetation(id1[0], eqcid);
+			pkcin.getVegetation(id2[0], eqcid);
+			checkInt("VEGID", r, id1, id2, 1);
+			cin.getDrainage(id1[0], eqcid);
+			pkcin.getDrainage(id2[0], eqcid);
+			checkInt("DRAINID", r, id1, id2, 1);
+		}
+
+		if (stg!="EQ") checkFire(stg, r, cin, pkcin);
+
+		if (r>=neqrec) continue;   //grid id is read from the eq cohortid file by the stage record
+		cin.getGrdID(id1[0], r);
+		pkcin.getGrdID(id2[0], r);
+		checkInt("GRDID", r, id1, id2, 1);
+		int grdid = id1[0];
+
+		int grdrecid = gin.getGridRecID(grdid);
+		int clmrecid = gin.getClmRecID(clmid);
+		id1[0] = pkgin.getGridRecID(grdid);
+		id1[1] = pkgin.getClmRecID(clmid);
+		checkInt("GRD record", r, &grdrecid, &id1[0], 1);
+		checkInt("CLM record", r, &clmrecid, &id1[1], 1);
+		if (grdrecid<0 || clmrecid<0) continue;
+
+		gin.getGridData(gd1, grdrecid, clmrecid);
+		pkgin.getGridData(gd2, grdrecid, clmrecid);
+		checkGridData(r, gd1, gd2);
+	}
+	delete gd1;
+	delete gd2;
+
+	cout <<"verified "<<nrec<<" "<<stg<<" cohort records: "<<nerr<<" mismatches\n";
+
+};
+
+int main(int argc, char* argv[]){
+
+	if (argc<3) {
+		cout <<"usage: "<<argv[0]<<" controlfile packfile [-verify]\n";
+		return -1;
+	}
+	string controlfile = argv[1];
+	string packfile    = argv[2];
+	bool checking = (argc>3 && string(argv[3])=="-verify");
+
+	ModelData md;
+	Controller configin;
+	RegionInputer rin;
+	GridInputer gin;
+	CohortInputer cin;
+
+	try {
+		configin.controlfile = controlfile;
+	#ifdef SITERUN
+		configin.ctrl4siterun(&md);
+	#else
+		configin.ctrl4regnrun(&md);
+	#endif
+		md.checking4run();
+
+		rin.setModelData(&md);
+		gin.setModelData(&md);
+		gin.init();
+		cin.setModelData(&md);
+		cin.init();
+
+		InputPack pack;
+		pack.create(packfile, md.runstages);
+		rin.packInputs(&pack);
+		gin.packInputs(&pack);
+		cin.packInputs(&pack);
+		pack.close();
+		cout <<"packed '"<<md.runstages<<"' inputs into "<<packfile<<"\n";
+
+		if (checking) {
+			InputPack inpack;
+			inpack.open(packfile, md.runstages);
+			verify(md, inpack, rin, gin, cin);
+		}
+
+	} catch (Exception &exception){
+		cout <<"problem in packing inputs\n";
+		exception.mesg();
+		return -1;
+	}
+
+	return (nerr>0) ? 1 : 0;
+
+};
@@ -0,0 +1,314 @@
+////////////////////////////////////////////////////////////////////////////////////////
+/*
+ *  TEMREGNBENCH.cpp
+ *  main program for timing regional runs (Regioner) end to end, on a synthetic input set
+ *  of N cohorts over M climate cells (see input/SyntheticInputs.h)
+ *
+ *  usage: DOSTEMREGNBENCH workdir [jsonfile] [-cohorts N] [-cells M] [-seed S]
+ *                         [-stages eq,sp,tr,sc] [-nogen] [-genonly]
+ *
+ *      the input set is written into workdir (default 100 cohorts over 10 cells),
+ *      unless -nogen, e.g. to re-run on one made before. Then the stages are run in order,
+ *      each in a child process started in workdir (for its config/), with
+ *         ctrl-<stage>.txt  - its control file
+ *         out-<stage>/      - its outputs and the console messages (regioner.log)
+ *      the first stage starts from the lookup, the others from the restart file of the one before.
+ *
+ *      for each stage, the wall time of the child (input reading included), the cohorts done
+ *      and failed (from the restart file), the cohort-years run (the monthly bgc integrations
+ *      in the solver statistics, /12) per second, the peak resident memory of the child and
+ *      the bytes written are written as JSON to jsonfile
+ *      (default 'regnbench.json' in the current directory)
+ *
+ *      the model must be built for regional runs (REGNRUN in TEMMOD.h); -genonly writes
+ *      the input set only, with any build
+ *
+*/
+/////////////////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <time.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+using namespace std;
+
+#include "TEMMOD.h"
+
+#include "runmodes/Regioner.h"
+#include "input/SyntheticInputs.h"
+
+/////////////////////////////////////////////////////////////////////////////////
+
+double wallclock(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec*1.e-9;     //s
+};
+
+//bytes of the files in a directory and below
+long long dirBytes(const string & dir){
+	long long bytes = 0;
+	DIR * dp = opendir(dir.c_str());
+	if (dp==NULL) return 0;
+	struct dirent * ent;
+	while ((ent = readdir(dp))!=NULL) {
+		if (strcmp(ent->d_name, ".")==0 || strcmp(ent->d_name, "..")==0) continue;
+		string path = dir+"/"+ent->d_name;
+		struct stat st;
+		if (stat(path.c_str(), &st)!=0) continue;
+		if (S_ISDIR(st.st_mode)) {
+			bytes += dirBytes(path);
+		} else {
+			bytes += st.st_size;
+		}
+	}
+	closedir(dp);
+	return bytes;
+};
+
+//the cohorts in a restart file, and those with an error code
+void countRestart(const string & filename, int & done, int & failed){
+	done   = 0;
+	failed = 0;
+
+	NcError err(NcError::silent_nonfatal);
+	NcFile resFile(filename.c_str(), NcFile::ReadOnly);
+	if (!resFile.is_valid()) return;
+	NcDim* chtD = resFile.get_dim("CHTID");
+	NcVar* errcodeV = resFile.get_var("ERRCODE");
+	if (chtD==NULL || errcodeV==NULL) return;
+
+	int nrec = chtD->size();
+	vector<int> errcode(nrec+1, 0);
+	if (nrec>0 && !errcodeV->get(&errcode[0], nrec)) return;
+	for (int i=0; i<nrec; i++) {
+		if (errcode[i]==0) {
+			done++;
+		} else {
+			failed++;
+		}
+	}
+};
+
+//the cohort-months run, as counted by the solver statistics (one RKF integration a month)
+double countMonths(const string & filename){
+	NcError err(NcError::silent_nonfatal);
+	NcFile solFile(filename.c_str(), NcFile::ReadOnly);
+	if (!solFile.is_valid()) return 0.;
+	NcDim* recD = solFile.get_dim("REC");
+	NcVar* rkfcallV = solFile.get_var("RKFCALLS");
+	if (recD==NULL || rkfcallV==NULL) return 0.;
+
+	int nrec = recD->size();
+	vector<int> calls(nrec+1, 0);
+	if (nrec>0 && !rkfcallV->get(&calls[0], nrec)) return 0.;
+	double months = 0.;
+	for (int i=0; i<nrec; i++) months += calls[i];
+	return months;
+};
+
+//the sizes of an input set written before (-nogen)
+void readSet(const string & workdir, SyntheticInputs & syn){
+	NcError err(NcError::silent_nonfatal);
+
+	NcFile chtFile((workdir+"/runcht.nc").c_str(), NcFile::ReadOnly);
+	NcDim* chtD = chtFile.get_dim("CHTID");
+	if (chtFile.is_valid() && chtD!=NULL) syn.numcht = chtD->size();
+
+	NcFile grdFile((workdir+"/grid/latlon.nc").c_str(), NcFile::ReadOnly);
+	NcDim* grdD = grdFile.get_dim("GRDID");
+	if (grdFile.is_valid() && grdD!=NULL) syn.numclm = grdD->size();
+};
+
+struct StageResult {
+	string stage;
+	int status;           //exit status of the child, -1 if it did not exit
+	double wall;          //s
+	long maxrss;          //kB
+	long long outbytes;
+	int done;
+	int failed;
+	double chtyears;
+};
+
+// one stage, in a child process, so that each has its own peak memory and a failure
+// (Regioner exits on bad inputs) ends the stage only
+StageResult runStage(const string & workdir, const string & stage, const string & prvstage){
+	StageResult res;
+	res.stage    = stage;
+	res.status   = -1;
+	res.wall     = 0.;
+	res.maxrss   = 0;
+	res.outbytes = 0;
+	res.done     = 0;
+	res.failed   = 0;
+	res.chtyears = 0.;
+
+	string outdir = "out-"+stage+"/";
+	mkdir((workdir+"/"+outdir).c_str(), 0755);
+
+	string ctrlfile = "ctrl-"+stage+".txt";
+	ofstream ofs((workdir+"/"+ctrlfile).c_str());
+	ofs <<outdir<<"\n";
+	ofs <<"region/\ngrid/\neq/\nsp/\ntr/\nsc/\n";
+	ofs <<"runcht.nc\n";
+	if (prvstage=="") {
+		ofs <<"none\n"<<stage<<"\nlookup\n";
+	} else {
+		ofs <<"out-"<<prvstage<<"/restart-"<<prvstage<<".nc\n"<<stage<<"\nrestart\n";
+	}
+	ofs <<"dynamic\ndynamic\nsynthetic-"<<stage<<"\n";
+	ofs.close();
+
+	cout <<"running '"<<stage<<"' in "<<workdir<<" ...\n";
+	cout.flush();
+
+	double t0 = wallclock();
+	pid_t pid = fork();
+	if (pid<0) {
+		cout <<"cannot start the '"<<stage<<"' run\n";
+		return res;
+	}
+
+	if (pid==0) {
+		if (chdir(workdir.c_str())!=0) _exit(-1);
+		string logfile = outdir+"regioner.log";
+		if (freopen(logfile.c_str(), "w", stdout)==NULL) _exit(-1);
+		{
+			Regioner regner;        //its outputers close the files when it goes
+			regner.init(ctrlfile);
+			regner.run();
+		}
+		cout.flush();
+		fflush(stdout);
+		_exit(0);
+	}
+
+	int wstatus = 0;
+	struct rusage ru;
+	memset(&ru, 0, sizeof(ru));
+	wait4(pid, &wstatus, 0, &ru);
+	res.wall   = wallclock()-t0;
+	res.maxrss = ru.ru_maxrss;
+	if (WIFEXITED(wstatus)) res.status = WEXITSTATUS(wstatus);
+
+	res.outbytes = dirBytes(workdir+"/"+outdir);
+	countRestart(workdir+"/"+outdir+"restart-"+stage+".nc", res.done, res.failed);
+	res.chtyears = countMonths(workdir+"/"+outdir+"solver-"+stage+".nc")/12.;
+
+	return res;
+};
+
+int main(int argc, char* argv[]){
+
+	string workdir  = "";
+	string jsonfile = "regnbench.json";
+	string stagelist = "eq,sp,tr,sc";
+	bool generating = true;
+	bool running    = true;
+	SyntheticInputs syn;
+	int nargs = 0;
+	for (int i=1; i<argc; i++) {
+		if (strcmp(argv[i], "-cohorts")==0 && i+1<argc) {
+			syn.numcht = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-cells")==0 && i+1<argc) {
+			syn.numclm = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-seed")==0 && i+1<argc) {
+			syn.seed = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-stages")==0 && i+1<argc) {
+			stagelist = argv[++i];
+		} else if (strcmp(argv[i], "-nogen")==0) {
+			generating = false;
+		} else if (strcmp(argv[i], "-genonly")==0) {
+			running = false;
+		} else if (argv[i][0]!='-' && nargs<2) {
+			if (nargs==0) workdir = argv[i];
+			if (nargs==1) jsonfile = argv[i];
+			nargs++;
+		} else {
+			workdir = "";
+			break;
+		}
+	}
+	if (workdir=="") {
+		cout <<"usage: "<<argv[0]<<" workdir [jsonfile] [-cohorts N] [-cells M] [-seed S]\n"
+			<<"       [-stages eq,sp,tr,sc] [-nogen] [-genonly]\n";
+		return -1;
+	}
+	if (running && !REGNMODE) {
+		cout <<"the regional benchmark needs a regional build (REGNRUN in TEMMOD.h)\n";
+		return -1;
+	}
+
+	vector<string> stages;
+	istringstream sstages(stagelist);
+	string stage;
+	while (getline(sstages, stage, ',')) {
+		if (stage!="eq" && stage!="sp" && stage!="tr" && stage!="sc") {
+			cout <<"unknown stage '"<<stage<<"' - one of eq, sp, tr, sc\n";
+			return -1;
+		}
+		stages.push_back(stage);
+	}
+
+	double gentime = 0.;
+	if (generating) {
+		double t0 = wallclock();
+		try {
+			syn.write(workdir);
+		} catch (Exception &exception) {
+			cout <<"problem in writing the synthetic inputs\n";
+			exception.mesg();
+			return -1;
+		}
+		gentime = wallclock()-t0;
+		cout <<syn.numcht<<" cohorts over "<<syn.numclm<<" cells written to "<<workdir
+			<<" ("<<gentime<<" s)\n";
+	}
+	if (!running) return 0;
+	if (!generating) readSet(workdir, syn);
+
+	vector<StageResult> results;
+	for (unsigned int is=0; is<stages.size(); is++) {
+		string prvstage = (is>0) ? stages[is-1] : "";
+		results.push_back(runStage(workdir, stages[is], prvstage));
+	}
+
+	FILE * out = fopen(jsonfile.c_str(), "w");
+	if (out==NULL) {
+		cout <<"cannot open "<<jsonfile<<"\n";
+		return -1;
+	}
+
+	int nerr = 0;
+	fprintf(out, "{\n\"benchmark\": \"dostem-regional\",\n\"version\": 1,\n");
+	fprintf(out, "\"cohorts\": %d,\n\"cells\": %d,\n\"seed\": %u,\n", syn.numcht, syn.numclm, syn.seed);
+	fprintf(out, "\"generated\": %s,\n\"generate_s\": %.3f,\n\"input_bytes\": %lld,\n\"results\": [",
+			generating ? "true" : "false", gentime, dirBytes(workdir+"/region")+dirBytes(workdir+"/grid")
+			+dirBytes(workdir+"/eq")+dirBytes(workdir+"/sp")+dirBytes(workdir+"/tr")+dirBytes(workdir+"/sc"));
+	for (unsigned int is=0; is<results.size(); is++) {
+		const StageResult & r = results[is];
+		fprintf(out, "%s\n{\"stage\": \"%s\", \"status\": %d, \"cohorts_done\": %d, \"cohorts_failed\": %d, "
+				"\"cohort_years\": %.0f, \"wall_s\": %.3f, \"cohort_years_per_s\": %.2f, "
+				"\"peak_rss_kb\": %ld, \"output_bytes\": %lld}",
+				is>0 ? "," : "", r.stage.c_str(), r.status, r.done, r.failed, r.chtyears, r.wall,
+				r.wall>0. ? r.chtyears/r.wall : 0., r.maxrss, r.outbytes);
+		if (r.status!=0 || r.failed>0 || r.done+r.failed<syn.numcht) nerr++;
+	}
+	fprintf(out, "\n]\n}\n");
+	fclose(out);
+	cout <<"regional benchmark written to "<<jsonfile<<"\n";
+
+	return (nerr>0) ? 1 : 0;
+
+};
@@ -1,5 +1,10 @@
 #include "AtmosUtil.h"
 
+#include <cmath>
+#ifdef __SSE2__
+	#include <emmintrin.h>
+#endif
+
 AtmosUtil::AtmosUtil(){
 	
 };
@@ -245,3 +250,168 @@ void AtmosUtil::updateDailyDriver(float tad[],const float prevta, const float cu
     }
   
 }; 
+
+// single precision exp and log (Cephes expf/logf), the SSE2 and the plain versions doing
+// the same operations in the same order, so a day has the same result in either
+
+const float EXPHI  = 88.3762626647949f;
+const float EXPLO  = -88.3762626647949f;
+const float LOG2EF = 1.44269504088896341f;
+const float EXPC1  = 0.693359375f;
+const float EXPC2  = -2.12194440e-4f;
+const float EXPP[] = {1.9875691500E-4f, 1.3981999507E-3f, 8.3334519073E-3f,
+		4.1665795894E-2f, 1.6666665459E-1f, 5.0000001201E-1f};
+
+const float SQRTHF = 0.707106781186547524f;
+const float LOGP[] = {7.0376836292E-2f, -1.1514610310E-1f, 1.1676998740E-1f,
+		-1.2420140846E-1f, 1.4249322787E-1f, -1.6668057665E-1f,
+		2.0000714765E-1f, -2.4999993993E-1f, 3.3333331174E-1f};
+
+union FloatBits{
+	float f;
+	int i;
+};
+
+inline float expPoly(float x){
+	x = x<EXPHI ? x : EXPHI;
+	x = x>EXPLO ? x : EXPLO;
+	float fx = std::floor(x*LOG2EF + 0.5f);
+	x = x - fx*EXPC1;
+	x = x - fx*EXPC2;
+	float z = x*x;
+	float y = EXPP[0];
+	for (int i=1; i<6; i++) y = y*x + EXPP[i];
+	y = y*z;
+	y = y + x;
+	y = y + 1.f;
+	FloatBits p;
+	p.i = ((int)fx + 127)<<23;
+	return y*p.f;
+};
+
+// x>0 and normal
+inline float logPoly(float x){
+	FloatBits b;
+	b.f = x;
+	float e = (float)((b.i>>23) - 0x7f) + 1.f;
+	b.i = (b.i & ~0x7f800000) | 0x3f000000;          //mantissa in [0.5, 1)
+	x = b.f;
+	float tmp = x<SQRTHF ? x : 0.f;
+	e = x<SQRTHF ? e - 1.f : e;
+	x = x - 1.f;
+	x = x + tmp;
+	float z = x*x;
+	float y = LOGP[0];
+	for (int i=1; i<9; i++) y = y*x + LOGP[i];
+	y = y*x;
+	y = y*z;
+	y = y + e*EXPC2;
+	y = y - z*0.5f;
+	x = x + y;
+	return x + e*EXPC1;
+};
+
+#ifdef __SSE2__
+inline __m128 expPoly4(__m128 x){
+	x = _mm_min_ps(x, _mm_set1_ps(EXPHI));
+	x = _mm_max_ps(x, _mm_set1_ps(EXPLO));
+	__m128 fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(LOG2EF)), _mm_set1_ps(0.5f));
+	__m128 tr = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));                  //floor, as trunc
+	fx = _mm_sub_ps(tr, _mm_and_ps(_mm_cmpgt_ps(tr, fx), _mm_set1_ps(1.f)));
+	x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(EXPC1)));
+	x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(EXPC2)));
+	__m128 z = _mm_mul_ps(x, x);
+	__m128 y = _mm_set1_ps(EXPP[0]);
+	for (int i=1; i<6; i++) y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(EXPP[i]));
+	y = _mm_mul_ps(y, z);
+	y = _mm_add_ps(y, x);
+	y = _mm_add_ps(y, _mm_set1_ps(1.f));
+	__m128i n = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(fx), _mm_set1_epi32(127)), 23);
+	return _mm_mul_ps(y, _mm_castsi128_ps(n));
+};
+
+inline __m128 logPoly4(__m128 x){
+	__m128i bits = _mm_castps_si128(x);
+	__m128 e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(0x7f)));
+	e = _mm_add_ps(e, _mm_set1_ps(1.f));
+	bits = _mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(~0x7f800000)), _mm_set1_epi32(0x3f000000));
+	x = _mm_castsi128_ps(bits);
+	__m128 mask = _mm_cmplt_ps(x, _mm_set1_ps(SQRTHF));
+	__m128 tmp = _mm_and_ps(x, mask);
+	e = _mm_sub_ps(e, _mm_and_ps(mask, _mm_set1_ps(1.f)));
+	x = _mm_sub_ps(x, _mm_set1_ps(1.f));
+	x = _mm_add_ps(x, tmp);
+	__m128 z = _mm_mul_ps(x, x);
+	__m128 y = _mm_set1_ps(LOGP[0]);
+	for (int i=1; i<9; i++) y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(LOGP[i]));
+	y = _mm_mul_ps(y, x);
+	y = _mm_mul_ps(y, z);
+	y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(EXPC2)));
+	y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+	x = _mm_add_ps(x, y);
+	return _mm_add_ps(x, _mm_mul_ps(e, _mm_set1_ps(EXPC1)));
+};
+#endif
+
+// the constants of Atmosphere::getDensity, getSatVP, getDerSVP and getAbsHumDeficit
+const float MWR = 18.f/8.3143f;
+
+void AtmosUtil::updateDailyDerived(const int & ndays, const float ta[], const float vp[],
+		float rhoa[], float svp[], float vpd[], float dersvp[], float abshd[]){
+	int id = 0;
+
+#ifdef __SSE2__
+	for (; id+4<=ndays; id+=4) {
+		__m128 t = _mm_loadu_ps(ta+id);
+		__m128 v = _mm_loadu_ps(vp+id);
+
+		_mm_storeu_ps(rhoa+id, _mm_sub_ps(_mm_set1_ps(1.292f), _mm_mul_ps(_mm_set1_ps(0.00428f), t)));
+
+		__m128 t2 = _mm_add_ps(t, _mm_set1_ps(237.3f));
+		__m128 s = expPoly4(_mm_div_ps(_mm_mul_ps(_mm_set1_ps(17.27f), t), t2));
+		s = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.61078f), s), _mm_set1_ps(1000.f));
+		_mm_storeu_ps(svp+id, s);
+		_mm_storeu_ps(vpd+id, _mm_max_ps(_mm_sub_ps(s, v), _mm_setzero_ps()));
+		_mm_storeu_ps(dersvp+id, _mm_div_ps(_mm_mul_ps(_mm_set1_ps(4099.f), s), _mm_mul_ps(t2, t2)));
+
+		__m128 l = logPoly4(_mm_div_ps(v, _mm_set1_ps(0.611f)));
+		__m128 temp = _mm_sub_ps(_mm_set1_ps(17.502f), l);
+		__m128 dew = _mm_div_ps(_mm_mul_ps(_mm_set1_ps(240.97f), l), temp);
+		__m128 zero = _mm_cmpeq_ps(temp, _mm_setzero_ps());
+		dew = _mm_or_ps(_mm_andnot_ps(zero, dew), _mm_and_ps(zero, t));
+		__m128 a = _mm_div_ps(_mm_mul_ps(s, _mm_set1_ps(1000.f)), _mm_add_ps(dew, _mm_set1_ps(273.2f)));
+		__m128 b = _mm_div_ps(_mm_mul_ps(v, _mm_set1_ps(1000.f)), _mm_add_ps(t, _mm_set1_ps(273.2f)));
+		__m128 h = _mm_mul_ps(_mm_set1_ps(MWR), _mm_sub_ps(a, b));
+		_mm_storeu_ps(abshd+id, _mm_andnot_ps(_mm_set1_ps(-0.f), h));                 //fabs
+	}
+#endif
+
+	for (; id<ndays; id++) {
+		float t = ta[id];
+		float v = vp[id];
+
+		rhoa[id] = 1.292f - 0.00428f*t;
+
+		float t2 = t + 237.3f;
+		float s = expPoly(17.27f*t/t2);
+		s = 0.61078f*s*1000.f;
+		svp[id] = s;
+		vpd[id] = s-v>0.f ? s-v : 0.f;
+		dersvp[id] = 4099.f*s/(t2*t2);
+
+		float l = logPoly(v/0.611f);
+		float temp = 17.502f - l;
+		float dew = temp!=0.f ? 240.97f*l/temp : t;
+		abshd[id] = std::fabs(MWR*(s*1000.f/(dew+273.2f) - v*1000.f/(t+273.2f)));
+	}
+
+	// the polynomial log is for normal positive numbers only, as the vapour pressure is;
+	// anything else goes as in Atmosphere::getAbsHumDeficit
+	for (id=0; id<ndays; id++) {
+		if (vp[id]>=1.e-30f) continue;
+		float l = std::log(vp[id]/0.611);
+		float temp = 17.502 - l;
+		float dew = temp>0 || temp<0 ? 240.97*l/temp : ta[id];
+		abshd[id] = std::fabs(MWR*(svp[id]*1000./(273.2 + dew) - vp[id]*1000/(273.2 + ta[id])));
+	}
+};
@@ -25,6 +25,17 @@ class AtmosUtil{
 		const int & dinmcurr, const int & dinmnext);
 		
 	void updateDailyPrec(float precd[], const int & dinmcurr , const float & mta, const float & mprec);
+
+	// the derived daily drivers of 'ndays' days from the air temperature (degC) and vapour
+	// pressure (Pa): air density, saturated vapour pressure, vapour pressure deficit, the
+	// slope of the saturated vapour pressure and the absolute humidity deficit, as the
+	// Atmosphere get...() functions. All days go through at once, 4 at a time with SSE2,
+	// in single precision, with exp and log as polynomials (within 1 ulp). Against the get...()
+	// functions, over -60..50 degC and 1..8000 Pa: rhoa within 1 ulp, svp and dersvp within
+	// 16 ulp (2e-6, the exp argument being single precision), vpd and abshd within 16 ulp of
+	// their larger term (they are differences)
+	void updateDailyDerived(const int & ndays, const float ta[], const float vp[],
+		float rhoa[], float svp[], float vpd[], float dersvp[], float abshd[]);
 	
 	private:
 	Interpolator itp;
@@ -2,6 +2,7 @@
  * 
  */
 #include "Atmosphere.h"
+#include "DriverCache.h"
 
 Atmosphere::Atmosphere(){
    	// if in the mode of spinup or spintransient
@@ -11,6 +12,16 @@ Atmosphere::Atmosphere(){
 	wetdays = 10.; // cru has wetdays output from 1901 to 2002, but not for scenario run
 	// temperarily assume wetdays = 10;
 
+	daywindow = true;
+	eqready = false;
+	trready = false;
+	day_winyr = -1;
+	day_winm  = -1;
+	clm = NULL;
+	drvcache = NULL;
+	drvcached = false;
+	clmhash = 0;
+
 };
 
 Atmosphere::~Atmosphere(){
@@ -18,142 +29,121 @@ Atmosphere::~Atmosphere(){
 };
 
 void Atmosphere::prepareMonthDrivingData(){
-     float lat = ed->gd->lat;
-     int dinm[] ={31,28,31,30,31,30,31,31,30,31,30,31};
- //   			cout<<"lat :"<<ed->gd->lat<<"\n";
-
-     //ta degC, prec mm/mon, nirr w/m2, vap mbar, 
-     for(int iy =0; iy<ed->gd->act_atm_drv_yr; iy++){
-       	for (int im=0; im<12; im++){
-       		ta[iy][im]   = ed->gd->ta[iy][im];
-       		prec[iy][im] = ed->gd->prec[iy][im];
-       		nirr[iy][im] = ed->gd->nirr[iy][im];
-       		vap[iy][im]  = ed->gd->vap[iy][im];
-//		if (im == 6) cout << "tair July (src/atmosphere.cpp): " << ta[iy][im] << "\n";
-       	}	
-     }
-
-
-     for(int iy =0; iy<ed->gd->act_atm_drv_yr; iy++){
-       	for (int im=0; im<12; im++){
-       		vap[iy][im] *=100; // convert from mbar to pa
-       		precsplt(ta[iy][im], prec[iy][im], snow[iy][im],rain[iy][im]); // distinguish prec as snow or rainfall
-       	}	
-     }
-            
-    // for equilibrium
-    	
-	for(int im =0; im<12; im++){
-		eq_ta[im]=0.;
-		eq_prec[im]=0.;
-		eq_rain[im]=0.;
-		eq_snow[im]=0.;
-		eq_nirr[im]=0.;
-		eq_vap[im]=0.;
-    			
-		for(int iy=0; iy<MAX_ATM_NOM_YR;iy++){    //Yuan: average over the first 30 yrs atm data
-			eq_ta[im] += ta[iy][im]/MAX_ATM_NOM_YR;
-			eq_prec[im] += prec[iy][im]/MAX_ATM_NOM_YR;
-			eq_rain[im] += rain[iy][im]/MAX_ATM_NOM_YR;
-			eq_snow[im] += snow[iy][im]/MAX_ATM_NOM_YR;
-			eq_nirr[im] += nirr[iy][im]/MAX_ATM_NOM_YR;
-			eq_vap[im] += vap[iy][im]/MAX_ATM_NOM_YR;
-		}
-	}
-    		
-	for(int im =0; im<12; im++){
-		ca_ta[im]=0.;
-		ca_prec[im]=0.;
-		ca_rain[im]=0.;
-    		ca_snow[im]=0.;
-    		ca_nirr[im]=0.;
-    		ca_vap[im]=0.;
-    		
-    		for(int iy=ed->gd->act_atm_drv_yr-MAX_ATM_NOM_YR; iy<ed->gd->act_atm_drv_yr;iy++){    //Yuan: average over  the last 30 yrs atm data
-    			ca_ta[im] += ta[iy][im]/MAX_ATM_NOM_YR;
-    			ca_prec[im] += prec[iy][im]/MAX_ATM_NOM_YR;
-    			ca_rain[im] += rain[iy][im]/MAX_ATM_NOM_YR;
-    			ca_snow[im] += snow[iy][im]/MAX_ATM_NOM_YR;
-    			ca_nirr[im] += nirr[iy][im]/MAX_ATM_NOM_YR;
-    			ca_vap[im] += vap[iy][im]/MAX_ATM_NOM_YR;
-    		}
+	const SolarTable & solar = SolarCache::get(ed->gd->lat);
+	for (int im=0; im<12; im++){
+		girr[im] = solar.girr[im];
 	}
-   
-   	// prepare other variables
-   	for(int iy=0; iy<ed->gd->act_atm_drv_yr; iy++){
-   		yrsumday=0; //Yi: may 17, 2010
-   		for(int im=0; im<12;im++){
-	       		girr[iy][im] = getGIRR(lat, dinm[im] );
-	       		cld[iy][im] = getCLDS(girr[iy][im], nirr[iy][im]);
-	       		par[iy][im] = getPAR( cld[iy][im],  nirr[iy][im] );
-    		}
-   	}
 
-	yrsumday=0; 
-   	for(int im=0; im<12;im++){
-// 		yrsumday=0; //Yi: may 17, 2010
-	    	eq_girr[im] = getGIRR(lat, dinm[im] );
-	    	eq_cld[im] = getCLDS(eq_girr[im], eq_nirr[im]);
-	    	eq_par[im] = getPAR( eq_cld[im],  eq_nirr[im] );
-    	}
-    
-  	yrsumday=0; 
-    	for(int im=0; im<12;im++){
-//		yrsumday=0; //Yi: may 17, 2010
-		ca_girr[im] = getGIRR(lat, dinm[im] );
-		ca_cld[im] = getCLDS(ca_girr[im], ca_nirr[im]);
-	    	ca_par[im] = getPAR( ca_cld[im],  ca_nirr[im] );
-    	}
-  
+	// the eq and transient blocks below are made from the climate when first used
+	eqready = false;
+	trready = false;
+	drvcached = false;
 };
- 
+
+//ta degC, prec mm/mon, vap Pa (mbar in the climate data)
+void Atmosphere::getMonth(const int & iy, const int & im, float & ta, float & prec, float & vap){
+	ta   = clm->get(CLM_TAIR, iy, im);
+	prec = clm->get(CLM_PREC, iy, im);
+	vap  = clm->get(CLM_VAPO, iy, im);
+	vap *=100; // convert from mbar to pa
+};
+
+void Atmosphere::getMonthRadiation(const int & iy, const int & im, float & girrm, float & nirrm,
+		float & cld, float & par){
+	girrm = girr[im];
+	nirrm = clm->get(CLM_NIRR, iy, im);
+	cld = getCLDS(girrm, nirrm);
+	par = getPAR(cld, nirrm);
+};
+
 void Atmosphere::prepareDayDrivingData(){
-    	// first for equilibrium 
+	day_winyr = -1;
+	day_winm  = -1;
+	vector<DayDrivers>().swap(day_all);
+};
+
+void Atmosphere::prepareEqDrivingData(){
+	if (drvcache!=NULL && drvcache->isOn() && drvcache->find(ed->gd->clmid, clmhash, clm->years())) {
+		prepareCachedDrivingData();
+		return;
+	}
+	makeEqDrivingData();
+	eqready = true;
+};
+
+// equilibrium (normal) driving data, from the first 30 yrs averaged
+void Atmosphere::makeEqDrivingData(){
     	float tad1[31], vapd1[31], precd1[31];
     	int dinm[] ={31,28,31,30,31,30,31,31,30,31,30,31};
     	float pvalt, cvalt, nvalt;
     	float pvalv, cvalv, nvalv;
-    	float pvalp, cvalp, nvalp;
+    	float cvalp;
     	int dinmprev, dinmcurr, dinmnext;
     	
+	for(int im =0; im<12; im++){
+		eq.ta[im]=0.;
+		eq.prec[im]=0.;
+		eq.rain[im]=0.;
+		eq.snow[im]=0.;
+		eq.nirr[im]=0.;
+		eq.vap[im]=0.;
+	}
+
+	//a year at a time, as the climate may be read a window of years at a time
+	for(int iy=0; iy<MAX_ATM_NOM_YR;iy++){    //Yuan: average over the first 30 yrs atm data
+		for(int im =0; im<12; im++){
+			float ta, prec, vap, rain, snow;
+			getMonth(iy, im, ta, prec, vap);
+			precsplt(ta, prec, snow, rain); // distinguish prec as snow or rainfall
+
+			eq.ta[im] += ta/MAX_ATM_NOM_YR;
+			eq.prec[im] += prec/MAX_ATM_NOM_YR;
+			eq.rain[im] += rain/MAX_ATM_NOM_YR;
+			eq.snow[im] += snow/MAX_ATM_NOM_YR;
+			eq.nirr[im] += clm->get(CLM_NIRR, iy, im)/MAX_ATM_NOM_YR;
+			eq.vap[im] += vap/MAX_ATM_NOM_YR;
+		}
+	}
+
+   	for(int im=0; im<12;im++){
+	    	eq.girr[im] = girr[im];
+	    	eq.cld[im] = getCLDS(eq.girr[im], eq.nirr[im]);
+	    	eq.par[im] = getPAR( eq.cld[im],  eq.nirr[im] );
+    	}
+    
+    	
     	for(int im =0; im<12;im++){
-    		cvalt = eq_ta[im];
-    		cvalv = eq_vap[im];
-    		cvalp = eq_prec[im];
+    		cvalt = eq.ta[im];
+    		cvalv = eq.vap[im];
+    		cvalp = eq.prec[im];
     		dinmcurr = dinm[im];
     		if(im==0){
-    		  	  pvalt = eq_ta[11];
-    		  	  pvalv = eq_vap[11];
-    		  	  pvalp = eq_prec[11];
+    		  	  pvalt = eq.ta[11];
+    		  	  pvalv = eq.vap[11];
     		  	  
-    		  	  nvalt = eq_ta[im+1];
-    		  	  nvalv = eq_vap[im+1];
-    		  	  nvalp = eq_prec[im+1];
+    		  	  nvalt = eq.ta[im+1];
+    		  	  nvalv = eq.vap[im+1];
     		  	  
     		  	  dinmnext = dinm[im+1];
     		  	  dinmprev = dinm[11];
     		  	  
     		  	  
     		}else if (im==11){
-    		  	  pvalt = eq_ta[im-1];
-    		  	  pvalv = eq_vap[im-1];
-    		  	  pvalp = eq_prec[im-1];
+    		  	  pvalt = eq.ta[im-1];
+    		  	  pvalv = eq.vap[im-1];
     		  	  
-    		  	  nvalt = eq_ta[0];
-    		  	  nvalv = eq_vap[0];
-    		  	  nvalp = eq_prec[0];
+    		  	  nvalt = eq.ta[0];
+    		  	  nvalv = eq.vap[0];
     		  	  
     		  	  dinmnext = dinm[0];
     		  	  dinmprev = dinm[im-1];
     		  	  
     		}else{
-    		  	  pvalt = eq_ta[im-1];
-    		  	  pvalv = eq_vap[im-1];
-    		  	  pvalp = eq_prec[im-1];
+    		  	  pvalt = eq.ta[im-1];
+    		  	  pvalv = eq.vap[im-1];
     		  	  
-    		  	  nvalt = eq_ta[im+1];
-    		  	  nvalv = eq_vap[im+1];
-    		  	  nvalp = eq_prec[im+1];
+    		  	  nvalt = eq.ta[im+1];
+    		  	  nvalv = eq.vap[im+1];
     		  	  
     		  	  dinmnext = dinm[im+1];
     		  	  dinmprev = dinm[im-1];
@@ -167,59 +157,142 @@ void Atmosphere::prepareDayDrivingData(){
   			autil.updateDailyPrec(precd1, dinmcurr, cvalt, cvalp);
   		   	
   		   	for (int id =0; id<31; id++){
-  		      	eq_ta_d[im][id] = tad1[id];
-  		      	eq_vap_d[im][id] = vapd1[id];
-  		      	precsplt(eq_ta_d[im][id], precd1[id], eq_snow_d[im][id], eq_rain_d[im][id]);
-  		      
-  		      	eq_rhoa_d[im][id] = getDensity(tad1[id]);
-  		      	eq_svp_d[im][id] = getSatVP(tad1[id]);
-  		       	eq_vpd_d[im][id] = getVPD(eq_svp_d[im][id], eq_vap_d[im][id]);
+  		      	eq.ta_d[im][id] = tad1[id];
+  		      	eq.vap_d[im][id] = vapd1[id];
+  		      	precsplt(eq.ta_d[im][id], precd1[id], eq.snow_d[im][id], eq.rain_d[im][id]);
+#ifndef SIMDDAYDRIVERS
+  		      	eq.rhoa_d[im][id] = getDensity(tad1[id]);
+  		      	eq.svp_d[im][id] = getSatVP(tad1[id]);
+  		       	eq.vpd_d[im][id] = getVPD(eq.svp_d[im][id], eq.vap_d[im][id]);
   		       
-  		      	eq_dersvp_d[im][id] = getDerSVP(tad1[id], eq_svp_d[im][id]);
-  		      	eq_abshd_d[im][id] = getAbsHumDeficit(eq_svp_d[im][id], eq_vap_d[im][id], tad1[id]);
+  		      	eq.dersvp_d[im][id] = getDerSVP(tad1[id], eq.svp_d[im][id]);
+  		      	eq.abshd_d[im][id] = getAbsHumDeficit(eq.svp_d[im][id], eq.vap_d[im][id], tad1[id]);
+#endif
   		   	}
+#ifdef SIMDDAYDRIVERS
+  		   	autil.updateDailyDerived(31, eq.ta_d[im], eq.vap_d[im],
+  		   			eq.rhoa_d[im], eq.svp_d[im], eq.vpd_d[im], eq.dersvp_d[im], eq.abshd_d[im]);
+#endif
   		   
     	}
     	
-    	///for runs, using the recent 30-yrs averaged
+};
+
+// transient driving data: the daily drivers of all years if not 'daywindow' (the monthly
+// data are read from the climate as used)
+void Atmosphere::prepareTransientDrivingData(){
+	if (drvcache!=NULL && drvcache->isOn()) {
+		prepareCachedDrivingData();
+		return;
+	}
+
+	if (!daywindow) {
+		day_all.resize(clm->years()*12);
+		for(int iy=0; iy<clm->years(); iy++){
+			for(int im =0; im<12;im++){
+				makeDayDrivers(iy, im, day_all[iy*12+im]);
+			}
+		}
+	}
+	trready = true;
+};
+
+// the eq block and the daily drivers of all years from the driver cache; made (the eq block
+// unless made already), and written there, if not in it (or not made from the same climate)
+void Atmosphere::prepareCachedDrivingData(){
+	if (!drvcache->find(ed->gd->clmid, clmhash, clm->years())) {
+		if (!eqready) makeEqDrivingData();
+		vector<DayDrivers> days(clm->years()*12);
+		for(int iy=0; iy<clm->years(); iy++){
+			for(int im =0; im<12;im++){
+				makeDayDrivers(iy, im, days[iy*12+im]);
+			}
+		}
+
+		if (!drvcache->write(ed->gd->clmid, clmhash, eq, days)) {
+			day_all.swap(days);     //served from here, as not cached
+			eqready = true;
+			trready = true;
+			return;
+		}
+	}
+
+	eq = drvcache->normals();
+	drvcached = true;
+	eqready = true;
+	trready = true;
+};
+
+// driving data of the recent (last 30 yrs) climate averaged (ca); no stage reads it at
+// present, so it is made only when asked for
+void Atmosphere::prepareRecentDrivingData(){
+    	float tad1[31], vapd1[31], precd1[31];
+    	int dinm[] ={31,28,31,30,31,30,31,31,30,31,30,31};
+    	float pvalt, cvalt, nvalt;
+    	float pvalv, cvalv, nvalv;
+    	float cvalp;
+    	int dinmprev, dinmcurr, dinmnext;
+	for(int im =0; im<12; im++){
+		ca.ta[im]=0.;
+		ca.prec[im]=0.;
+		ca.rain[im]=0.;
+    		ca.snow[im]=0.;
+    		ca.nirr[im]=0.;
+    		ca.vap[im]=0.;
+	}
+	for(int iy=clm->years()-MAX_ATM_NOM_YR; iy<clm->years();iy++){    //Yuan: average over  the last 30 yrs atm data
+		for(int im =0; im<12; im++){
+			float ta, prec, vap, rain, snow;
+			getMonth(iy, im, ta, prec, vap);
+			precsplt(ta, prec, snow, rain);
+
+    			ca.ta[im] += ta/MAX_ATM_NOM_YR;
+    			ca.prec[im] += prec/MAX_ATM_NOM_YR;
+    			ca.rain[im] += rain/MAX_ATM_NOM_YR;
+    			ca.snow[im] += snow/MAX_ATM_NOM_YR;
+    			ca.nirr[im] += clm->get(CLM_NIRR, iy, im)/MAX_ATM_NOM_YR;
+    			ca.vap[im] += vap/MAX_ATM_NOM_YR;
+    		}
+	}
+   
+    	for(int im=0; im<12;im++){
+		ca.girr[im] = girr[im];
+		ca.cld[im] = getCLDS(ca.girr[im], ca.nirr[im]);
+	    	ca.par[im] = getPAR( ca.cld[im],  ca.nirr[im] );
+    	}
+  
     	for(int im =0; im<12;im++){
-    		cvalt = ca_ta[im];
-    		cvalv = ca_vap[im];
-    		cvalp = ca_prec[im];
+    		cvalt = ca.ta[im];
+    		cvalv = ca.vap[im];
+    		cvalp = ca.prec[im];
     		dinmcurr = dinm[im];
     		if(im==0){
-    		  	  pvalt = ca_ta[11];
-    		  	  pvalv = ca_vap[11];
-    		  	  pvalp = ca_prec[11];
+    		  	  pvalt = ca.ta[11];
+    		  	  pvalv = ca.vap[11];
     		  	  
-    		  	  nvalt = ca_ta[im+1];
-    		  	  nvalv = ca_vap[im+1];
-    		  	  nvalp = ca_prec[im+1];
+    		  	  nvalt = ca.ta[im+1];
+    		  	  nvalv = ca.vap[im+1];
     		  	  
     		  	  dinmnext = dinm[im+1];
     		  	  dinmprev = dinm[11];
     		  	  
     		  	  
     		}else if (im==11){
-    		  	  pvalt = ca_ta[im-1];
-    		  	  pvalv = ca_vap[im-1];
-    		  	  pvalp = ca_prec[im-1];
+    		  	  pvalt = ca.ta[im-1];
+    		  	  pvalv = ca.vap[im-1];
     		  	  
-    		  	  nvalt = ca_ta[0];
-    		  	  nvalv = ca_vap[0];
-    		  	  nvalp = ca_prec[0];
+    		  	  nvalt = ca.ta[0];
+    		  	  nvalv = ca.vap[0];
     		  	  
     		  	  dinmnext = dinm[0];
     		  	  dinmprev = dinm[im-1];
     		  	  
     		}else{
-    		  	  pvalt = ca_ta[im-1];
-    		  	  pvalv = ca_vap[im-1];
-    		  	  pvalp = ca_prec[im-1];
+    		  	  pvalt = ca.ta[im-1];
+    		  	  pvalv = ca.vap[im-1];
     		  	  
-    		  	  nvalt = ca_ta[im+1];
-    		  	  nvalv = ca_vap[im+1];
-    		  	  nvalp = ca_prec[im+1];
+    		  	  nvalt = ca.ta[im+1];
+    		  	  nvalv = ca.vap[im+1];
     		  	  
     		  	  dinmnext = dinm[im+1];
     		  	  dinmprev = dinm[im-1];
@@ -231,101 +304,113 @@ void Atmosphere::prepareDayDrivingData(){
                      dinmprev, dinmcurr, dinmnext);
   			autil.updateDailyPrec(precd1, dinmcurr, cvalt, cvalp);
   		    for (int id =0; id<31; id++){
-  		      ca_ta_d[im][id] = tad1[id];
-  		      ca_vap_d[im][id] = vapd1[id];
-  		      precsplt(ca_ta_d[im][id], precd1[id], ca_snow_d[im][id], ca_rain_d[im][id]);
+  		      ca.ta_d[im][id] = tad1[id];
+  		      ca.vap_d[im][id] = vapd1[id];
+  		      precsplt(ca.ta_d[im][id], precd1[id], ca.snow_d[im][id], ca.rain_d[im][id]);
   		      
-  		      ca_rhoa_d[im][id] = getDensity(tad1[id]);
-  		      ca_svp_d[im][id] = getSatVP(tad1[id]);
-  		      ca_vpd_d[im][id] = getVPD(ca_svp_d[im][id], ca_vap_d[im][id]*0.1);
-  		      ca_dersvp_d[im][id] = getDerSVP(tad1[id], ca_svp_d[im][id]);
-  		      ca_abshd_d[im][id] = getAbsHumDeficit(ca_svp_d[im][id], ca_vap_d[im][id]*0.1, tad1[id]);
+  		      ca.rhoa_d[im][id] = getDensity(tad1[id]);
+  		      ca.svp_d[im][id] = getSatVP(tad1[id]);
+  		      ca.vpd_d[im][id] = getVPD(ca.svp_d[im][id], ca.vap_d[im][id]*0.1);
+  		      ca.dersvp_d[im][id] = getDerSVP(tad1[id], ca.svp_d[im][id]);
+  		      ca.abshd_d[im][id] = getAbsHumDeficit(ca.svp_d[im][id], ca.vap_d[im][id]*0.1, tad1[id]);
 
   		   	}
   		   
   		   
     	} 
   
-  //// for transient
-    	for(int iy=0; iy<ed->gd->act_atm_drv_yr; iy++){
-      		for(int im =0; im<12;im++){
-    		 	cvalt = ta[iy][im];
-    		 	cvalv = vap[iy][im];
-    		 	cvalp = prec[iy][im];
-    		 	dinmcurr = dinm[im];
-    		  	if(im==0){
-    		  	  	if(iy==0){
-    		  	  		pvalt = ta[0][0];
-    		  	  		pvalv = vap[0][0];
-    		  	  		pvalp = prec[0][0];
-    		  	  	}else{
-    		  	  		pvalt = ta[iy-1][11];
-    		  	  		pvalv = vap[iy-1][11];
-    		  	  		pvalp = prec[iy-1][11];
-    		  	  	}
-    		  	  	nvalt = ta[iy][im+1];
-    		  	  	nvalv = vap[iy][im+1];
-    		  	  	nvalp = prec[iy][im+1];
-    		  	  	dinmnext = dinm[im+1];
-    		  	  	dinmprev = dinm[11];
-    		  	  
-    		  	  
-    		  	}else if (im==11){
-    		  	  	pvalt = ta[iy][im-1];
-    		  	  	pvalv = vap[iy][im-1];
-    		  	  	pvalp = prec[iy][im-1];
-    		  	 	if(iy==ed->gd->act_atm_drv_yr-1){
-    		  	  		nvalt = ta[iy][11];
-    		  	  		nvalv = vap[iy][11];
-    		  	  		nvalp = prec[iy][11];
-    		  	  	}else{
-    		  	  		nvalt = ta[iy+1][0];
-    		  	  		nvalv = vap[iy+1][0];
-    		  	  		nvalp = prec[iy+1][0];
-    		  	  	}
-    		  	  	dinmnext = dinm[0];
-    		  	  	dinmprev = dinm[im-1];
-    		  	  
-    		  	}else{
-    		  	  	pvalt = ta[iy][im-1];
-    		  	  	pvalv = vap[iy][im-1];
-    		  	  	pvalp = prec[iy][im-1];
-    		  	  
-    		  	  	nvalt = ta[iy][im+1];
-    		  	  	nvalv = vap[iy][im+1];
-    		  	  	nvalp = prec[iy][im+1];
-    		  	  
-    		  	  	dinmnext = dinm[im+1];
-    		  	  	dinmprev = dinm[im-1];
-    		  	  
-    		  	}
-                autil.updateDailyDriver(tad1, pvalt ,cvalt, nvalt,
-                       dinmprev, dinmcurr, dinmnext);
-  				autil.updateDailyDriver(vapd1,  pvalv ,cvalv, nvalv,
-                     dinmprev, dinmcurr, dinmnext);
-  				autil.updateDailyPrec(precd1, dinmcurr, cvalt, cvalp);
-  		   		
-  		   		for (int id =0; id<dinmcurr; id++){
-  		      		ta_d[iy][im][id] = tad1[id];
-  		      		vap_d[iy][im][id] = vapd1[id];
-  		      		precsplt(ta_d[iy][im][id], precd1[id],snow_d[iy][im][id], rain_d[iy][im][id]);
-  		      
-  		      		rhoa_d[iy][im][id] = getDensity(tad1[id]);
-  		      		svp_d[iy][im][id] = getSatVP(tad1[id]);
-  		      		vpd_d[iy][im][id] = getVPD(svp_d[iy][im][id], vap_d[iy][im][id]   );
-  		      		dersvp_d[iy][im][id] = getDerSVP(tad1[id], svp_d[iy][im][id]);
-  		      		abshd_d[iy][im][id] = getAbsHumDeficit(svp_d[iy][im][id], vap_d[iy][im][id] , tad1[id]); 		      
-  		   		} //id
-    		}//im
-  
-    	}//iy
-    
-}; 
+};
+
+// the daily drivers of month 'im' of year 'iy', interpolated from the monthly data of
+// the month and its neighbours (the first and last month of the data repeat themselves)
+void Atmosphere::makeDayDrivers(const int & iy, const int & im, DayDrivers & dd){
+	float tad1[31], vapd1[31], precd1[31];
+	int dinm[] ={31,28,31,30,31,30,31,31,30,31,30,31};
+	float pvalt, cvalt, nvalt;
+	float pvalv, cvalv, nvalv;
+	float cvalp;
+	int dinmprev, dinmcurr, dinmnext;
+
+	float precv;
+
+	getMonth(iy, im, cvalt, cvalp, cvalv);
+	dinmcurr = dinm[im];
+	if(im==0){
+		if(iy==0){
+			getMonth(0, 0, pvalt, precv, pvalv);
+		}else{
+			getMonth(iy-1, 11, pvalt, precv, pvalv);
+		}
+		getMonth(iy, im+1, nvalt, precv, nvalv);
+		dinmnext = dinm[im+1];
+		dinmprev = dinm[11];
+
+	}else if (im==11){
+		getMonth(iy, im-1, pvalt, precv, pvalv);
+		if(iy==clm->years()-1){
+			getMonth(iy, 11, nvalt, precv, nvalv);
+		}else{
+			getMonth(iy+1, 0, nvalt, precv, nvalv);
+		}
+		dinmnext = dinm[0];
+		dinmprev = dinm[im-1];
+
+	}else{
+		getMonth(iy, im-1, pvalt, precv, pvalv);
+
+		getMonth(iy, im+1, nvalt, precv, nvalv);
+
+		dinmnext = dinm[im+1];
+		dinmprev = dinm[im-1];
+	}
+	autil.updateDailyDriver(tad1, pvalt ,cvalt, nvalt,
+			dinmprev, dinmcurr, dinmnext);
+	autil.updateDailyDriver(vapd1,  pvalv ,cvalv, nvalv,
+			dinmprev, dinmcurr, dinmnext);
+	autil.updateDailyPrec(precd1, dinmcurr, cvalt, cvalp);
+
+	for (int id =0; id<dinmcurr; id++){
+		dd.ta[id] = tad1[id];
+		dd.vap[id] = vapd1[id];
+		precsplt(dd.ta[id], precd1[id], dd.snow[id], dd.rain[id]);
+#ifndef SIMDDAYDRIVERS
+		dd.rhoa[id] = getDensity(tad1[id]);
+		dd.svp[id] = getSatVP(tad1[id]);
+		dd.vpd[id] = getVPD(dd.svp[id], dd.vap[id]);
+		dd.dersvp[id] = getDerSVP(tad1[id], dd.svp[id]);
+		dd.abshd[id] = getAbsHumDeficit(dd.svp[id], dd.vap[id], tad1[id]);
+#endif
+	}
+#ifdef SIMDDAYDRIVERS
+	autil.updateDailyDerived(dinmcurr, dd.ta, dd.vap, dd.rhoa, dd.svp, dd.vpd, dd.dersvp, dd.abshd);
+#endif
+
+	float cld;
+	getMonthRadiation(iy, im, dd.girr, dd.nirr, cld, dd.par);
+};
+
+const DayDrivers & Atmosphere::getDayDrivers(const int & iy, const int & im){
+	if (drvcached) return drvcache->days(iy, im);
+	if (!day_all.empty()) return day_all[iy*12+im];
+
+	if (iy!=day_winyr || im!=day_winm) {
+		makeDayDrivers(iy, im, day_win);
+		day_winyr = iy;
+		day_winm  = im;
+	}
+	return day_win;
+};
+
+void Atmosphere::setDayWindow(const bool & window){
+	daywindow = window;
+};
 
 //Yuan: climate/co2 change option
 void Atmosphere::beginOfMonth(const int & curyrcnt ,const int& currmind,const int& dinmcurr, const bool & normal, const bool & changeclm, const bool & changeco2){
+	PHASE_SCOPE("Atmosphere::beginOfMonth");
 
 	if(normal){  //using normalized weather data of first 30 yrs (modified in inc/timeconst.h)
+		if (!eqready) prepareEqDrivingData();
 
   		if (changeco2) {
   			ed->m_atms.co2  = ed->rd->co2[curyrcnt%ed->rd->act_co2_drv_yr];   //Yuan: this reuse CO2 data sets
@@ -333,18 +418,19 @@ void Atmosphere::beginOfMonth(const int & curyrcnt ,const int& currmind,const in
   	    		ed->m_atms.co2  = ed->initco2;
   		}
 
-  		ed->m_atms.ta   = eq_ta[currmind];
+  		ed->m_atms.ta   = eq.ta[currmind];
 		//if (currmind==6) cout<<"atm->beginOfMonth - m_atms.ta= "<<ed->m_atms.ta<<"\n";
-  		ed->m_atms.clds = eq_cld[currmind];
-		ed->m_atmd.vp   = eq_vap[currmind];
-		ed->m_a2l.prec  = eq_prec[currmind];
-		ed->m_a2l.rnfl  = eq_rain[currmind];
-		ed->m_a2l.snfl  = eq_snow[currmind];
-   		ed->m_a2l.girr  = eq_girr[currmind];
-		ed->m_a2l.nirr  = eq_nirr[currmind];
-		ed->m_a2l.par   = eq_par[currmind];
+  		ed->m_atms.clds = eq.cld[currmind];
+		ed->m_atmd.vp   = eq.vap[currmind];
+		ed->m_a2l.prec  = eq.prec[currmind];
+		ed->m_a2l.rnfl  = eq.rain[currmind];
+		ed->m_a2l.snfl  = eq.snow[currmind];
+   		ed->m_a2l.girr  = eq.girr[currmind];
+		ed->m_a2l.nirr  = eq.nirr[currmind];
+		ed->m_a2l.par   = eq.par[currmind];
 
   	}else {
+		if (!trready) prepareTransientDrivingData();
 
   		if (changeco2) {
   			if (curyrcnt<MAX_CO2_DRV_YR) {
@@ -359,20 +445,26 @@ void Atmosphere::beginOfMonth(const int & curyrcnt ,const int& currmind,const in
 
   		int yrind;
   		if (changeclm) {
-    			yrind = curyrcnt%ed->gd->act_atm_drv_yr;    //Yuan: this will reuse the whole atm data set
+    			yrind = curyrcnt%clm->years();    //Yuan: this will reuse the whole atm data set
   		} else {
-    			yrind = curyrcnt%(min(30, ed->gd->act_atm_drv_yr));    //Yuan: this will reuse the atm data of first 30 yrs
+    			yrind = curyrcnt%(min(30, clm->years()));    //Yuan: this will reuse the atm data of first 30 yrs
   		}
 
-		ed->m_atms.ta   = ta[yrind][currmind];
-  		ed->m_atms.clds = cld[yrind][currmind];
-    		ed->m_atmd.vp   = vap[yrind][currmind];
-    		ed->m_a2l.prec  = prec[yrind][currmind];
-    		ed->m_a2l.rnfl  = rain[yrind][currmind];
-    		ed->m_a2l.snfl  = snow[yrind][currmind];
-    		ed->m_a2l.girr  = girr[yrind][currmind];
-    		ed->m_a2l.nirr  = nirr[yrind][currmind];
-    		ed->m_a2l.par   = par[yrind][currmind];
+		float ta, prec, vap, rain, snow;
+		float girrm, nirrm, cld, par;
+		getMonth(yrind, currmind, ta, prec, vap);
+		precsplt(ta, prec, snow, rain); // distinguish prec as snow or rainfall
+		getMonthRadiation(yrind, currmind, girrm, nirrm, cld, par);
+
+		ed->m_atms.ta   = ta;
+  		ed->m_atms.clds = cld;
+    		ed->m_atmd.vp   = vap;
+    		ed->m_a2l.prec  = prec;
+    		ed->m_a2l.rnfl  = rain;
+    		ed->m_a2l.snfl  = snow;
+    		ed->m_a2l.girr  = girrm;
+    		ed->m_a2l.nirr  = nirrm;
+    		ed->m_a2l.par   = par;
 	}
 
 //if (currmind == 5) cout << "beginOfMonth / ed->m_atms.ta(5)" << ed->m_atms.ta << "\n";
@@ -381,48 +473,53 @@ void Atmosphere::beginOfMonth(const int & curyrcnt ,const int& currmind,const in
 };
 
 void Atmosphere::updateDailyEnviron(const int &yrcnt, const int & mid, const int & dayid, const bool & normal, const bool & changeclm){
+	PHASE_SCOPE("Atmosphere::updateDailyEnviron");
 
     if(normal){ //using normalized climatic driving
+		if (!eqready) prepareEqDrivingData();
    
 		ed->d_atms.co2 = ed->m_atms.co2;
-		ed->d_atms.ta  = eq_ta_d[mid][dayid];
-		ed->d_a2l.rnfl = eq_rain_d[mid][dayid];
-		ed->d_a2l.snfl = eq_snow_d[mid][dayid];
-		ed->d_a2l.par  = eq_par[mid];
-		ed->d_a2l.nirr = eq_nirr[mid];
-		ed->d_a2l.girr = eq_girr[mid];
-		ed->d_atmd.vp  = eq_vap_d[mid][dayid] ;              //Pa
-		ed->d_atmd.rhoa = eq_rhoa_d[mid][dayid];
-		ed->d_atmd.svp  = eq_svp_d[mid][dayid];
-		ed->d_atmd.vpd  = eq_vpd_d[mid][dayid];                
-		ed->d_atmd.dersvp = eq_dersvp_d[mid][dayid];
-		ed->d_atmd.abshd  = eq_abshd_d[mid][dayid];
+		ed->d_atms.ta  = eq.ta_d[mid][dayid];
+		ed->d_a2l.rnfl = eq.rain_d[mid][dayid];
+		ed->d_a2l.snfl = eq.snow_d[mid][dayid];
+		ed->d_a2l.par  = eq.par[mid];
+		ed->d_a2l.nirr = eq.nirr[mid];
+		ed->d_a2l.girr = eq.girr[mid];
+		ed->d_atmd.vp  = eq.vap_d[mid][dayid] ;              //Pa
+		ed->d_atmd.rhoa = eq.rhoa_d[mid][dayid];
+		ed->d_atmd.svp  = eq.svp_d[mid][dayid];
+		ed->d_atmd.vpd  = eq.vpd_d[mid][dayid];                
+		ed->d_atmd.dersvp = eq.dersvp_d[mid][dayid];
+		ed->d_atmd.abshd  = eq.abshd_d[mid][dayid];
 		if (mid==6) { 
 			//if (dayid==30) cout<< "ta"<< ed->d_atms.ta <<"\n";
 		}
     	
     }else {
+		if (!trready) prepareTransientDrivingData();
     	
   		int yrind;
   		if (changeclm) {
-    	    yrind = yrcnt%ed->gd->act_atm_drv_yr;    //Yuan: this will reuse the whole atm data set
+    	    yrind = yrcnt%clm->years();    //Yuan: this will reuse the whole atm data set
   		} else {
-    	    yrind = yrcnt%ed->gd->act_atm_drv_yr;    //Yuan: this will reuse the atm data of first 30 yrs
+    	    yrind = yrcnt%clm->years();    //Yuan: this will reuse the atm data of first 30 yrs
   		}
 
+		const DayDrivers & dd = getDayDrivers(yrind, mid);
+
 		ed->d_atms.co2 = ed->m_atms.co2;
-		ed->d_atms.ta  = ta_d[yrind][mid][dayid];
-		ed->d_a2l.rnfl = rain_d[yrind][mid][dayid];
-		ed->d_a2l.snfl = snow_d[yrind][mid][dayid] ;
-		ed->d_a2l.par  = par[yrind][mid];
-		ed->d_a2l.nirr = nirr[yrind][mid];
-		ed->d_a2l.girr = girr[yrind][mid];
-		ed->d_atmd.vp  = vap_d[yrind][mid][dayid] ;
-		ed->d_atmd.rhoa = rhoa_d[yrind][mid][dayid];
-		ed->d_atmd.svp  = svp_d[yrind][mid][dayid];
-		ed->d_atmd.vpd  = vpd_d[yrind][mid][dayid];
-		ed->d_atmd.dersvp = dersvp_d[yrind][mid][dayid];
-		ed->d_atmd.abshd  = abshd_d[yrind][mid][dayid];
+		ed->d_atms.ta  = dd.ta[dayid];
+		ed->d_a2l.rnfl = dd.rain[dayid];
+		ed->d_a2l.snfl = dd.snow[dayid] ;
+		ed->d_a2l.par  = dd.par;
+		ed->d_a2l.nirr = dd.nirr;
+		ed->d_a2l.girr = dd.girr;
+		ed->d_atmd.vp  = dd.vap[dayid] ;
+		ed->d_atmd.rhoa = dd.rhoa[dayid];
+		ed->d_atmd.svp  = dd.svp[dayid];
+		ed->d_atmd.vpd  = dd.vpd[dayid];
+		ed->d_atmd.dersvp = dd.dersvp[dayid];
+		ed->d_atmd.abshd  = dd.abshd[dayid];
 
     }
 	
@@ -495,54 +592,8 @@ float Atmosphere::getAirDensity(float const & ta){
 	float rhoa;
 	rhoa = 1.292 - (0.00428 * ta);
 	return rhoa;
-}; 
- 
-// Monthly solar radition at the top of atmosphere
-float Atmosphere::getGIRR(const float &lat, const int& dinm ){
-
-  	const float pi = 3.141592654;                // Greek "pi"
-  	const float sp = 1368.0 * 3600.0 / 41860.0;  // solar constant
-
-  	float lambda;
-  	float sumd;
-  	float sig;
-  	float eta;
-  	float sinbeta;
-  	float sb;
-  	float sotd;
-  	int day;
-  	int hour;
-  	float gross;
-
-  	lambda = lat * pi / 180.0;
-  	gross = 0.0;
-  	for ( day = 0; day < dinm; day++ ) {
-    	++yrsumday;
-    	sumd = 0;
-    	sig = -23.4856*cos(2 * pi * (yrsumday + 10.0)/365.25);
-    	sig *= pi / 180.0;
-
-    	for ( hour = 0; hour < 24; hour++ ){
-      		eta = (float) ((hour+1) - 12) * pi / 12.0;
-      		sinbeta = sin(lambda)*sin(sig) + cos(lambda)*cos(sig)*cos(eta);
-      		sotd = 1 - (0.016729 * cos(0.9856 * (yrsumday - 4.0) 
-             * pi / 180.0));
-
-      		sb = sp * sinbeta / pow((double)sotd,2.0);
-      		if (sb >= 0.0) { sumd += sb; }
-    	}
-
-    	gross += sumd;
-  	}
-
-  	gross /= (float) dinm;
-  	gross *= 0.484; // convert from cal/cm2day to W/m2
- 
-  	return gross;
-
 };
 
-
 float Atmosphere::getAbsHumDeficit(const float & svp, const float &vp, const float & ta){
 	const float Mw = 18; // g/mol;
 	const float R = 8.3143; // J/mol/k
@@ -615,3 +666,26 @@ void Atmosphere::setEnvData(EnvData* edp){
 	ed = edp;
 };
 
+void Atmosphere::setClimateSource(ClimateSource* src){
+	clm = src;
+};
+
+void Atmosphere::setDriverCache(DriverCache* cache){
+	drvcache = cache;
+};
+
+// of the climate as the cohorts of the grid read it (so after any climate scenario); made
+// once for a climate cell (at a latitude), as the hash goes over all years
+void Atmosphere::hashClimate(){
+	if (drvcache==NULL || !drvcache->isOn()) return;
+
+	map<int, pair<float, unsigned long> >::iterator ih = clmhashes.find(ed->gd->clmid);
+	if (ih!=clmhashes.end() && ih->second.first==ed->gd->lat) {
+		clmhash = ih->second.second;
+		return;
+	}
+
+	clmhash = DriverCache::climateHash(clm, ed->gd->lat);
+	clmhashes[ed->gd->clmid] = make_pair(ed->gd->lat, clmhash);
+};
+
@@ -2,15 +2,68 @@
 #define ATMOSPHERE_H_
 
 #include "../inc/timeconst.h"
+#include "../TEMMOD.h"
 
 #include "AtmosUtil.h"
+#include "SolarCache.h"
 #include "../data/EnvData.h"
 #include "../data/GridData.h"
+#include "../data/ClimateSource.h"
 #include "../data/RegionData.h"
 
 #include <iostream>
 #include <cmath>
+#include <map>
+#include <vector>
+#include "../util/PhaseTimer.h"
 using namespace std;
+
+// daily climate drivers of one month (the days after the month's end are not set)
+struct DayDrivers{
+	float ta[31];
+	float rain[31];
+	float snow[31];
+	float vap[31];
+
+	float rhoa[31];
+	float svp[31];
+	float dersvp[31];
+	float abshd[31];
+	float vpd[31];
+
+	float girr;                //of the month
+	float nirr;
+	float par;
+};
+
+// climate of 30 yrs averaged, and its daily drivers (the days after a month's end are not set)
+struct NormalDrivers{
+	float ta[12];
+	float prec[12];
+	float cld[12];
+	float vap[12];
+	float rain[12];
+	float snow[12];
+
+	float par[12];
+	float ppfd[12];
+	float nirr[12];
+	float girr[12];
+
+	float ta_d[12][31];
+	float rain_d[12][31];
+	float snow_d[12][31];
+	float vap_d[12][31];
+
+	float rhoa_d[12][31];
+	float svp_d[12][31];
+	float dersvp_d[12][31];
+	float abshd_d[12][31];
+	float vpd_d[12][31];
+};
+
+class DriverCache;
+
 class Atmosphere{
    public:
    		Atmosphere();
@@ -19,9 +72,14 @@ class Atmosphere{
 		void updateDailyEnviron(const int &yrcnt, const int & mid, const int & dayid,
 				const bool & normal, const bool & changeclm);
 	
-    	void prepareMonthDrivingData();
+    	void prepareMonthDrivingData();   //the monthly data of the cohort; the rest is made when first used
     	void prepareDayDrivingData();
+    	void prepareRecentDrivingData();
 		void setEnvData(EnvData* edp);
+		void setClimateSource(ClimateSource* src);
+		void setDriverCache(DriverCache* cache);
+		void hashClimate();               //the key of the grid's cached drivers, once per climate cell
+		void setDayWindow(const bool & window);
 
     	float tam[12];
 
@@ -30,77 +88,47 @@ class Atmosphere{
  	
 	private:									            
 	
-	// monthly
-     
-		float ta[MAX_ATM_DRV_YR][12];
-		float prec[MAX_ATM_DRV_YR][12];
-		float cld[MAX_ATM_DRV_YR][12];
-		float snow[MAX_ATM_DRV_YR][12];
-		float rain[MAX_ATM_DRV_YR][12];
-		float vap[MAX_ATM_DRV_YR][12];
-		float par[MAX_ATM_DRV_YR][12];
-		float ppfd[MAX_ATM_DRV_YR][12];
-		float nirr[MAX_ATM_DRV_YR][12];
-		float girr[MAX_ATM_DRV_YR][12];
-	// daily
-		float ta_d[MAX_ATM_DRV_YR][12][31];
-		float rain_d[MAX_ATM_DRV_YR][12][31];
-		float snow_d[MAX_ATM_DRV_YR][12][31];
-		float vap_d[MAX_ATM_DRV_YR][12][31];
-	
-		float rhoa_d[MAX_ATM_DRV_YR][12][31];
-		float svp_d[MAX_ATM_DRV_YR][12][31];
-		float dersvp_d[MAX_ATM_DRV_YR][12][31];
-		float abshd_d[MAX_ATM_DRV_YR][12][31];
-		float vpd_d[MAX_ATM_DRV_YR][12][31];
+	// monthly, read from the grid's climate when used (vap in Pa, prec split into rain/snow,
+	// clouds and par from nirr), so no years of climate are held here
+		ClimateSource * clm;
+		float girr[12];            //the same each year, of the grid's latitude
+
+		void getMonth(const int & iy, const int & im, float & ta, float & prec, float & vap);
+		void getMonthRadiation(const int & iy, const int & im, float & girr, float & nirr,
+				float & cld, float & par);
+
+	// made on the first month of a stage that needs them: the eq block by an equilibrium
+	// (normal) month, the transient one (day_all) by any other
+		bool eqready;
+		bool trready;
+		void prepareEqDrivingData();
+		void prepareTransientDrivingData();
+		void makeEqDrivingData();
+
+	// or both blocks at once from the driver cache, if set (see DriverCache): read by any
+	// stage, made and written by a transient one only
+		DriverCache * drvcache;
+		bool drvcached;            //the cohort's blocks mapped from drvcache
+		unsigned long clmhash;     //of the grid's climate
+		map<int, pair<float, unsigned long> > clmhashes;   //clmid -> latitude, hash
+		void prepareCachedDrivingData();
+
+	// daily, either all years (12 months each, made by prepareTransientDrivingData) or,
+	// with 'daywindow', only the month in use, made when its first day is asked for
+		bool daywindow;
+		vector<DayDrivers> day_all;
+		DayDrivers day_win;
+		int day_winyr;             //year and month in day_win, -1 if none
+		int day_winm;
+
+		void makeDayDrivers(const int & iy, const int & im, DayDrivers & dd);
+		const DayDrivers & getDayDrivers(const int & iy, const int & im);
 
 	// for Equilibrium run, using the first 30 yrs-averaged
-		float eq_ta[12];
-		float eq_prec[12];
-		float eq_cld[12];
-		float eq_vap[12];
-		float eq_rain[12];
-		float eq_snow[12];
-	
-		float eq_par[12];
-		float eq_ppfd[12];
-		float eq_nirr[12];
-		float eq_girr[12];
-	
-		float eq_ta_d[12][31];
-		float eq_rain_d[12][31];
-		float eq_snow_d[12][31];
-		float eq_vap_d[12][31];
-	
-		float eq_rhoa_d[12][31];
-		float eq_svp_d[12][31];
-		float eq_dersvp_d[12][31];
-		float eq_abshd_d[12][31];
-		float eq_vpd_d[12][31];
+		NormalDrivers eq;
 
 	// for run, using the current last 30 yrs-averaged
-		float ca_ta[12];
-		float ca_prec[12];
-		float ca_cld[12];
-		float ca_vap[12];
-		float ca_rain[12];
-		float ca_snow[12];
-	
-		float ca_par[12];
-		float ca_ppfd[12];
-		float ca_nirr[12];
-		float ca_girr[12];
-	
-		float ca_ta_d[12][31];
-		float ca_rain_d[12][31];
-		float ca_snow_d[12][31];
-		float ca_vap_d[12][31];
-	
-		float ca_rhoa_d[12][31];
-		float ca_svp_d[12][31];
-		float ca_dersvp_d[12][31];
-		float ca_abshd_d[12][31];
-		float ca_vpd_d[12][31];
+		NormalDrivers ca;
 		
 		AtmosUtil autil;
 	
@@ -109,13 +137,11 @@ class Atmosphere{
 		float getAbsHumDeficit(const float & svp, const float &vp, const float & ta);
 		float wetdays ;
 
-		float yrsumday;
 		void precsplt(const float & tair,const float & prec, float & snfl, float & rnfl);
 
    		EnvData * ed;
    	         
     	float getPET( const float & nirr, const float & tair,const int & dinm );
-		float getGIRR( const float &lat, const int& dinm);			
 		float getNIRR( const float& clds, const float& girr );				
 		float getPAR( const float& clds, const float& nirr );	
 		float getCLDS( const float& girr, const float& nirr );
@@ -0,0 +1,206 @@
+#include "DriverCache.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+const char DRIVERCACHE_MAGIC[8] = {'D','O','S','T','E','M','D','C'};
+const long DRIVERCACHE_ALIGN = 64;
+
+DriverCache::DriverCache(){
+	dir     = "";
+	on      = false;
+	fd      = -1;
+	base    = NULL;
+	mapsize = 0;
+	mapclmid = -1;
+	maphash  = 0;
+	mapnyr   = 0;
+};
+
+DriverCache::~DriverCache(){
+	unmap();
+};
+
+void DriverCache::setDirectory(const string & cachedir){
+	dir = cachedir;
+	if (dir!="" && dir[dir.size()-1]!='/') dir += "/";
+	on = (dir!="");
+};
+
+bool DriverCache::isOn(){
+	return on;
+};
+
+string DriverCache::fileOf(const int & clmid){
+	char name[32];
+	sprintf(name, "clm%d.drv", clmid);
+	return dir+name;
+};
+
+void DriverCache::unmap(){
+	if (base!=NULL) munmap(base, mapsize);
+	if (fd>=0) ::close(fd);
+	base    = NULL;
+	fd      = -1;
+	mapsize = 0;
+	mapclmid = -1;
+};
+
+// FNV-1a (64 bits)
+static void hashBytes(unsigned long & hash, const void * vals, const size_t & n){
+	const unsigned char * p = (const unsigned char*)vals;
+	for (size_t ib=0; ib<n; ib++) {
+		hash = (hash^p[ib])*1099511628211UL;
+	}
+};
+
+unsigned long DriverCache::climateHash(ClimateSource * clm, const float & lat){
+	unsigned long hash = 14695981039346656037UL;
+
+	int head[4];
+	head[0] = DRIVERCACHE_VERSION;
+	head[1] = (int)sizeof(DayDrivers);
+#ifdef SIMDDAYDRIVERS
+	head[2] = 1;
+#else
+	head[2] = 0;
+#endif
+	head[3] = clm->years();
+	hashBytes(hash, head, sizeof(head));
+	hashBytes(hash, &lat, sizeof(lat));
+
+	//a year at a time, as the climate may be read a window of years at a time
+	float vals[CLM_NVAR][12];
+	for (int iy=0; iy<clm->years(); iy++) {
+		for (int iv=0; iv<CLM_NVAR; iv++) {
+			for (int im=0; im<12; im++) {
+				vals[iv][im] = clm->get(iv, iy, im);
+			}
+		}
+		hashBytes(hash, vals, sizeof(vals));
+	}
+	return hash;
+};
+
+unsigned long DriverCache::checksumOf(const void * normals, const void * days, const long & ndays){
+	unsigned long sum = 14695981039346656037UL;
+	hashBytes(sum, normals, sizeof(NormalDrivers));
+	hashBytes(sum, days, ndays*sizeof(DayDrivers));
+	return sum;
+};
+
+bool DriverCache::find(const int & clmid, const unsigned long & hash, const int & nyr){
+	PHASE_SCOPE("DriverCache::find");
+
+	if (base!=NULL && clmid==mapclmid && hash==maphash && nyr==mapnyr) return true;
+
+	unmap();
+	if (!on) return false;
+
+	string file = fileOf(clmid);
+	fd = ::open(file.c_str(), O_RDONLY);
+	struct stat st;
+	if (fd<0 || fstat(fd, &st)!=0 || st.st_size<(long)sizeof(DriverCacheHeader)) {
+		unmap();
+		return false;
+	}
+
+	mapsize = st.st_size;
+	void * map = mmap(NULL, mapsize, PROT_READ, MAP_SHARED, fd, 0);
+	if (map==MAP_FAILED) {
+		base = NULL;
+		unmap();
+		return false;
+	}
+	base = (char*)map;
+
+	//anything else is made again (and the file written over)
+	const DriverCacheHeader * hd = (const DriverCacheHeader*)base;
+	if (memcmp(hd->magic, DRIVERCACHE_MAGIC, 8)!=0 || hd->version!=DRIVERCACHE_VERSION
+			|| hd->byteorder!=0x01020304 || hd->sizeoflong!=(int)sizeof(long)
+			|| hd->sizeofday!=(int)sizeof(DayDrivers) || hd->clmid!=clmid
+			|| hd->nyr!=nyr || hd->hash!=hash
+			|| hd->dayoffset+nyr*12*(long)sizeof(DayDrivers)>mapsize
+			|| hd->checksum!=checksumOf(base+hd->normaloffset, base+hd->dayoffset, nyr*12)) {
+		unmap();
+		return false;
+	}
+
+	mapclmid = clmid;
+	maphash  = hash;
+	mapnyr   = nyr;
+	return true;
+};
+
+bool DriverCache::write(const int & clmid, const unsigned long & hash, const NormalDrivers & eq,
+		const vector<DayDrivers> & days){
+	PHASE_SCOPE("DriverCache::write");
+
+	unmap();
+	if (!on) return false;
+
+	DriverCacheHeader hd;
+	memset(&hd, 0, sizeof(hd));
+	memcpy(hd.magic, DRIVERCACHE_MAGIC, 8);
+	hd.version    = DRIVERCACHE_VERSION;
+	hd.byteorder  = 0x01020304;
+	hd.sizeoflong = (int)sizeof(long);
+	hd.clmid      = clmid;
+	hd.nyr        = days.size()/12;
+	hd.sizeofday  = (int)sizeof(DayDrivers);
+	hd.hash       = hash;
+	hd.checksum   = checksumOf(&eq, &days[0], days.size());
+	long align = DRIVERCACHE_ALIGN;
+	hd.normaloffset = ((long)sizeof(hd)+align-1)/align*align;
+	hd.dayoffset    = (hd.normaloffset+(long)sizeof(NormalDrivers)+align-1)/align*align;
+
+	//a temporary file of this writer only, as other runs may be writing the same file
+	string file = fileOf(clmid);
+	string tmpfile = file+".XXXXXX";
+	vector<char> tmpname(tmpfile.begin(), tmpfile.end());
+	tmpname.push_back('\0');
+	int tmpfd = mkstemp(&tmpname[0]);
+	tmpfile = &tmpname[0];
+	FILE * out = NULL;
+	if (tmpfd>=0) {
+		fchmod(tmpfd, 0644);
+		out = fdopen(tmpfd, "wb");
+		if (out==NULL) ::close(tmpfd);
+	}
+	bool ok = (out!=NULL);
+	if (ok) {
+		char pad[DRIVERCACHE_ALIGN];
+		memset(pad, 0, sizeof(pad));
+		size_t npad1 = hd.normaloffset-sizeof(hd);
+		size_t npad2 = hd.dayoffset-hd.normaloffset-sizeof(eq);
+		ok = fwrite(&hd, sizeof(hd), 1, out)==1
+			&& fwrite(pad, 1, npad1, out)==npad1
+			&& fwrite(&eq, sizeof(eq), 1, out)==1
+			&& fwrite(pad, 1, npad2, out)==npad2
+			&& fwrite(&days[0], sizeof(DayDrivers), days.size(), out)==days.size();
+		ok = (fclose(out)==0) && ok;
+		ok = ok && rename(tmpfile.c_str(), file.c_str())==0;
+	}
+
+	if (!ok) {
+		LOG(LOG_WARN) <<"cannot write "<<file<<" - no more climate drivers cached in this run\n";
+		if (tmpfd>=0) remove(tmpfile.c_str());
+		on = false;
+		return false;
+	}
+
+	return find(clmid, hash, hd.nyr);
+};
+
+const NormalDrivers & DriverCache::normals(){
+	const DriverCacheHeader * hd = (const DriverCacheHeader*)base;
+	return *(const NormalDrivers*)(base+hd->normaloffset);
+};
+
+const DayDrivers & DriverCache::days(const int & iy, const int & im){
+	const DriverCacheHeader * hd = (const DriverCacheHeader*)base;
+	return ((const DayDrivers*)(base+hd->dayoffset))[iy*12+im];
+};
@@ -0,0 +1,94 @@
+#ifndef DRIVERCACHE_H_
+#define DRIVERCACHE_H_
+
+/*! the derived climate drivers of a climate cell kept in a directory between runs
+ *  ('drivercache <dir>' in the control file), and served back from a read-only memory map
+ * \file
+ *
+ *  one file per climate cell, <dir>/clm<CLMID>.drv (native byte order, checked when mapped):
+ *     DriverCacheHeader | NormalDrivers (the eq block) | DayDrivers[nyr*12] (all months)
+ *  each part 64-byte aligned.
+ *
+ *  the header has a hash of what the drivers are made from - the monthly climate of all
+ *  years, the latitude, DRIVERCACHE_VERSION and the build flags of the daily drivers - so a
+ *  file made from other inputs (a new climate file, a climate scenario) is made again, and
+ *  the drivers are exactly those made without the cache. DRIVERCACHE_VERSION goes up with
+ *  any change of how the drivers are made. The hash is made once per climate cell (see
+ *  Atmosphere::hashClimate), and a file is only made by a transient stage, so an eq-only
+ *  run reads the cache but makes no daily drivers for it.
+ *
+ *  a file is written whole to a temporary file of its own writer (<file>.XXXXXX, mkstemp)
+ *  and renamed over <file>, so runs sharing the directory see either no file or a whole one.
+ *  The header also has a checksum of the drivers, checked when mapped, so a file not as
+ *  written (cut short, or written over) is made again. If the directory cannot be written,
+ *  the cache is off for the rest of the run.
+ */
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+using namespace std;
+
+#include "Atmosphere.h"
+#include "../data/ClimateSource.h"
+#include "../util/Logger.h"
+#include "../util/PhaseTimer.h"
+#include "../TEMMOD.h"
+
+const int DRIVERCACHE_VERSION = 2;
+
+struct DriverCacheHeader{
+	char magic[8];           // "DOSTEMDC"
+	int version;
+	int byteorder;           // 0x01020304 as written
+	int sizeoflong;
+	int clmid;
+	int nyr;
+	int sizeofday;           // sizeof(DayDrivers)
+	unsigned long hash;
+	unsigned long checksum;  // of the NormalDrivers and DayDrivers parts, as written
+	long normaloffset;       // bytes from the start of file
+	long dayoffset;
+};
+
+class DriverCache{
+	public:
+		DriverCache();
+		~DriverCache();
+
+		void setDirectory(const string & dir);
+		bool isOn();
+
+		static unsigned long climateHash(ClimateSource * clm, const float & lat);
+
+		//maps the file of 'clmid' if made from inputs with 'hash', and of 'nyr' years (kept
+		//mapped, and not checked again, while asked for the same)
+		bool find(const int & clmid, const unsigned long & hash, const int & nyr);
+		//writes the drivers of 'clmid' and maps them; false (and the cache off) if not written
+		bool write(const int & clmid, const unsigned long & hash, const NormalDrivers & eq,
+				const vector<DayDrivers> & days);
+
+		//of the file mapped by the last find() or write()
+		const NormalDrivers & normals();
+		const DayDrivers & days(const int & iy, const int & im);
+
+	private:
+
+		string dir;
+		bool on;
+
+		int fd;
+		char * base;
+		long mapsize;
+		int mapclmid;              //of the file mapped (and checked), -1 if none
+		unsigned long maphash;
+		int mapnyr;
+
+		string fileOf(const int & clmid);
+		void unmap();
+		static unsigned long checksumOf(const void * normals, const void * days, const long & ndays);
+
+};
+
+#endif /*DRIVERCACHE_H_*/
@@ -0,0 +1,80 @@
+#include "SolarCache.h"
+
+map<float, SolarTable> SolarCache::tables;
+
+// more latitudes than a domain has rows; past it the cache starts over
+const unsigned int SOLARCACHE_MAX = 4096;
+
+const SolarTable & SolarCache::get(const float & lat){
+	map<float, SolarTable>::iterator it = tables.find(lat);
+	if (it!=tables.end()) return it->second;
+
+	if (tables.size()>=SOLARCACHE_MAX) tables.clear();
+	SolarTable & st = tables[lat];
+	make(lat, st);
+	return st;
+};
+
+void SolarCache::clear(){
+	tables.clear();
+};
+
+void SolarCache::make(const float & lat, SolarTable & st){
+	int dinm[] ={31,28,31,30,31,30,31,31,30,31,30,31};
+
+	float yrsumday = 0;           //day of the year, counted on by getGIRR
+	for(int im=0; im<12;im++){
+		st.girr[im] = getGIRR(lat, dinm[im], yrsumday);
+	}
+
+	double ampl;
+	for (int id=0; id<365; id++){
+		ampl = exp(7.42 +0.045 *lat)/3600.;
+		st.daylength[id] = ampl * (sin ((id -79) *0.01721)) +12.0;
+	}
+};
+
+// Monthly solar radition at the top of atmosphere
+float SolarCache::getGIRR(const float & lat, const int & dinm, float & yrsumday){
+
+  	const float pi = 3.141592654;                // Greek "pi"
+  	const float sp = 1368.0 * 3600.0 / 41860.0;  // solar constant
+
+  	float lambda;
+  	float sumd;
+  	float sig;
+  	float eta;
+  	float sinbeta;
+  	float sb;
+  	float sotd;
+  	int day;
+  	int hour;
+  	float gross;
+
+  	lambda = lat * pi / 180.0;
+  	gross = 0.0;
+  	for ( day = 0; day < dinm; day++ ) {
+    	++yrsumday;
+    	sumd = 0;
+    	sig = -23.4856*cos(2 * pi * (yrsumday + 10.0)/365.25);
+    	sig *= pi / 180.0;
+
+    	for ( hour = 0; hour < 24; hour++ ){
+      		eta = (float) ((hour+1) - 12) * pi / 12.0;
+      		sinbeta = sin(lambda)*sin(sig) + cos(lambda)*cos(sig)*cos(eta);
+      		sotd = 1 - (0.016729 * cos(0.9856 * (yrsumday - 4.0) 
+             * pi / 180.0));
+
+      		sb = sp * sinbeta / pow((double)sotd,2.0);
+      		if (sb >= 0.0) { sumd += sb; }
+    	}
+
+    	gross += sumd;
+  	}
+
+  	gross /= (float) dinm;
+  	gross *= 0.484; // convert from cal/cm2day to W/m2
+ 
+  	return gross;
+
+};
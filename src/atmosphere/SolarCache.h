@@ -0,0 +1,32 @@
+#ifndef SOLARCACHE_H_
+#define SOLARCACHE_H_
+//the radiation and day-length tables of a latitude, made once per process and
+//shared by all the cohorts on that latitude (a row of a regional domain)
+
+#include <map>
+#include <cmath>
+using namespace std;
+
+//tables depending on the latitude only
+struct SolarTable{
+	float girr[12];            //monthly gross irradiance at the top of the atmosphere (W/m2)
+	float daylength[365];      //hours
+};
+
+class SolarCache{
+	public:
+
+		//the tables of 'lat', made on its first use; the reference holds till the next get()
+		static const SolarTable & get(const float & lat);
+		static void clear();
+
+	private:
+
+		//keyed by the latitude as read, so a cohort gets exactly the values it would compute
+		static map<float, SolarTable> tables;
+
+		static void make(const float & lat, SolarTable & st);
+		static float getGIRR(const float & lat, const int & dinm, float & yrsumday);
+
+};
+#endif /*SOLARCACHE_H_*/
@@ -1,4 +1,5 @@
 #include "BgcData.h"
+#include "../util/Logger.h"
 
 BgcData::BgcData(){
 	baseline =0;
@@ -152,12 +153,12 @@ void BgcData::endOfMonth(const int & currmind){
  	y_a2v.innpp += m_a2v.innpp;
 	
 	if (currmind==11) {
-		cout <<"-- Aboveground C --"<<"\n";
-		cout <<"GPP "<<y_a2v.gpp<<"\n";
-		cout <<"NPP "<<y_a2v.npp<<"\n";
-		cout <<"VEGC "<<y_vegs.c<<"\n";
-		cout <<"INNPP "<<y_a2v.innpp<<"\n";
-		cout <<"DEADC "<<y_vegs.deadc<<"\n";
+		LOG(LOG_DEBUG) <<"-- Aboveground C --"<<"\n";
+		LOG(LOG_DEBUG) <<"GPP "<<y_a2v.gpp<<"\n";
+		LOG(LOG_DEBUG) <<"NPP "<<y_a2v.npp<<"\n";
+		LOG(LOG_DEBUG) <<"VEGC "<<y_vegs.c<<"\n";
+		LOG(LOG_DEBUG) <<"INNPP "<<y_a2v.innpp<<"\n";
+		LOG(LOG_DEBUG) <<"DEADC "<<y_vegs.deadc<<"\n";
 	}
 
  	y_v2soi.ltrfalc += m_v2soi.ltrfalc;
@@ -202,10 +203,10 @@ void BgcData::endOfMonth(const int & currmind){
 //   	y_soid.minec += m_soid.minec/12;
 
  	if (currmind==11) {
-		cout <<"-- Belowground C --"<<"\n";
-		cout <<"SHLWC "<<y_soid.shlwc<<"\n";
-		cout <<"DEEPC "<<y_soid.deepc<<"\n";
-		cout <<"MINEC "<<y_soid.minec<<"\n";
+		LOG(LOG_DEBUG) <<"-- Belowground C --"<<"\n";
+		LOG(LOG_DEBUG) <<"SHLWC "<<y_soid.shlwc<<"\n";
+		LOG(LOG_DEBUG) <<"DEEPC "<<y_soid.deepc<<"\n";
+		LOG(LOG_DEBUG) <<"MINEC "<<y_soid.minec<<"\n";
 	}
   
  	for (int il =0; il<MAX_SOI_LAY; il++){
@@ -246,13 +247,13 @@ void BgcData::endOfMonth(const int & currmind){
 
 
  	if (currmind==11) {
-		cout <<"-- N cycle --"<<"\n";
-		cout <<"VEGN "<<vegn<<"\n";
-		cout <<"NUPTAKE "<<y_soi2v.nuptake<<"\n";
-		cout <<"AVLN "<<y_sois.avln<<"\n";
-		cout <<"ORGN "<<y_sois.orgn<<"\n";
-		cout <<"WDEBRIS "<<y_sois.wdebris<<"\n";
-		cout <<"WDRH "<<y_soi2a.wdrh<<"\n";
+		LOG(LOG_DEBUG) <<"-- N cycle --"<<"\n";
+		LOG(LOG_DEBUG) <<"VEGN "<<vegn<<"\n";
+		LOG(LOG_DEBUG) <<"NUPTAKE "<<y_soi2v.nuptake<<"\n";
+		LOG(LOG_DEBUG) <<"AVLN "<<y_sois.avln<<"\n";
+		LOG(LOG_DEBUG) <<"ORGN "<<y_sois.orgn<<"\n";
+		LOG(LOG_DEBUG) <<"WDEBRIS "<<y_sois.wdebris<<"\n";
+		LOG(LOG_DEBUG) <<"WDRH "<<y_soi2a.wdrh<<"\n";
 	}
 
  
@@ -276,7 +277,7 @@ void BgcData::endOfMonth(const int & currmind){
  	y_vegd.raq10+= m_vegd.raq10/12;
 
   	if (currmind==11) {
-		cout <<"LAI "<<y_vegd.lai<<"\n";
+		LOG(LOG_DEBUG) <<"LAI "<<y_vegd.lai<<"\n";
 	}
 };
 
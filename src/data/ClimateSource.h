@@ -0,0 +1,52 @@
+#ifndef CLIMATESOURCE_H_
+#define CLIMATESOURCE_H_
+
+/*! the monthly climate of a grid as the atmosphere reads it, a value at a time
+ * \file
+ *
+ *  either all the years held in GridData (GridClimate, the default), or a window of years
+ *  read from the climate file as the run goes (ClimateStream, 'climatewindow' in the
+ *  control file); the values are as in the climate file (degC, mm/mon, W/m2, mbar)
+ */
+
+#include "GridData.h"
+
+enum CLMVAR { CLM_TAIR = 0, CLM_PREC = 1, CLM_NIRR = 2, CLM_VAPO = 3 };
+const int CLM_NVAR = 4;
+
+class ClimateSource{
+	public:
+		virtual ~ClimateSource(){};
+
+		virtual int years()=0;          //years of climate of the grid
+		virtual float get(const int & var, const int & iy, const int & im)=0;
+};
+
+class GridClimate : public ClimateSource{
+	public:
+		GridClimate(){
+			gd = NULL;
+		};
+
+		void setGridData(GridData* gdp){
+			gd = gdp;
+		};
+
+		int years(){
+			return gd->act_atm_drv_yr;
+		};
+
+		float get(const int & var, const int & iy, const int & im){
+			switch (var) {
+				case CLM_TAIR: return gd->ta[iy][im];
+				case CLM_PREC: return gd->prec[iy][im];
+				case CLM_NIRR: return gd->nirr[iy][im];
+				default:       return gd->vap[iy][im];
+			}
+		};
+
+	private:
+		GridData* gd;
+};
+
+#endif /*CLIMATESOURCE_H_*/
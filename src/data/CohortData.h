@@ -2,9 +2,19 @@
 #define COHORTDATA_H_
 
 #include <algorithm>
+#include <vector>
+using namespace std;
 
 #include "../inc/timeconst.h"
 
+//one fire of a cohort's fire history
+struct FireEvent {
+	int year;     // calendar year of burn
+	int month;    // month of burn (0~11)
+	int date;     // day of burn
+	int area;     // area of burn
+};
+
 class CohortData{
   	public:
   		CohortData();
@@ -34,20 +44,10 @@ class CohortData{
 //		int spseason[MAX_SP_FIR_OCR_NUM];
 //		int spseverity[MAX_SP_FIR_OCR_NUM];   //Yuan: modified
 
-		int spfireyear[MAX_SP_YR];
-		int spfiremonth[MAX_SP_YR];
-		int spfiredate[MAX_SP_YR];
-		int spfirearea[MAX_SP_YR];
-
-		int trfireyear[MAX_TR_YR];
-		int trfiremonth[MAX_TR_YR];
-		int trfiredate[MAX_TR_YR];
-		int trfirearea[MAX_TR_YR];
-
-		int scfireyear[MAX_SC_YR];
-		int scfiremonth[MAX_SC_YR];
-		int scfiredate[MAX_SC_YR];
-		int scfirearea[MAX_SC_YR];
+		//fire histories of the cohort, only years with a fire, sorted by year
+		vector<FireEvent> spfire;
+		vector<FireEvent> trfire;
+		vector<FireEvent> scfire;
 	
 };
 
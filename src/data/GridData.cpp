@@ -2,7 +2,7 @@
 #include <iostream>
 
 GridData::GridData(){
-	
+	clmid = -1;
 };
 
 GridData::~GridData(){
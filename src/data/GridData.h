@@ -11,6 +11,7 @@ class GridData{
   	~GridData();
   
     	int gid;
+    	int clmid;          //id of the climate cell (CLMID)
     	float lat;
     	float lon;
     	float alldaylengths[365]; 
@@ -1,4 +1,5 @@
 #include "WildFire.h"
+#include "../util/Logger.h"
 
 WildFire::WildFire(){
 	VSMburn =0.90; // a threshold value of VWC for burn organic layers
@@ -40,9 +41,9 @@ void WildFire::initializeState(){
 void WildFire::initializeState5restart(RestartData *resin){
 	
 	fd->ysf = resin->ysf; //resin->getYSF(fd->ysf, fd->cd->reschtid);
-cout <<"ysf : " << fd->ysf << "\n";
+LOG(LOG_DEBUG) <<"ysf : " << fd->ysf << "\n";
 	fd->y_a2soi.orgn=resin->burnedn; //resin->getBURNEDN(fd->y_a2soi.orgn, fd->cd->reschtid);
-cout <<"In - resin->burnedn : " << resin->burnedn << "\n";
+LOG(LOG_DEBUG) <<"In - resin->burnedn : " << resin->burnedn << "\n";
 };
 
 //Yuan: modifying the following method, return the first fire year, if any
@@ -64,7 +65,6 @@ void WildFire::prepareDrivingData(const bool runeq, const bool runsp, const bool
 	//Yuan: season's month index order (0~11):
 	//int morder[12] = {1,2,3, 4,5,6, 7,8,9, 10,11,0};  //Yuan: season: 1, 2(early fire), 3(late fire), and 4 with 3 months in the order
 
-	int calyr =0;
 	firstfireyr = -1;  //Yuan: first fire year specified in sp/tr: fire.nc
 /*
 	if (runsp || runtr) {
@@ -98,76 +98,30 @@ void WildFire::prepareDrivingData(const bool runeq, const bool runsp, const bool
 
 	if (runsp){
 		firstfireyr = END_SP_YR; 
-		for(int in =0; in<END_SP_YR; in++){
-			calyr = fd->cd->spfireyear[in];
-			if(calyr != -1){     
-    			if (firstfireyr>=calyr) firstfireyr=calyr;
-    			occur[in] = calyr-BEG_SP_YR;        
-				firedate[in] = fd->cd->spfiredate[in];
-				firemonth[in] = fd->cd->spfiremonth[in];
-				firearea[in] = fd->cd->spfirearea[in];
- 	    		if (fd->gd->fireyear[0] > calyr) {
-   					firesize[in]  = fd->gd->firesize[0]; 
-	    		} else {
-	    			for (int ifs=0; ifs<MAX_FSIZE_DRV_YR; ifs++) {
-	    				if (fd->gd->fireyear[ifs] < calyr) {
-	    					firesize[in]  = fd->gd->firesize[ifs];
-	    					break;
-						}
-					}					
-				}
-			}
-		}
+		if (!fd->cd->spfire.empty()) firstfireyr = min(firstfireyr, fd->cd->spfire[0].year);
 	}
 
 	if (runtr) {
 		firstfireyr = END_TR_YR; 
-		for(int in =0; in<MAX_TR_YR; in++){
-			calyr = fd->cd->trfireyear[in];
-  			if(calyr != -1){ 
-    				if (firstfireyr>=calyr) firstfireyr=calyr;
-				occur[in] = fd->cd->trfireyear[in]-BEG_TR_YR;
-				firedate[in] = fd->cd->trfiredate[in];
-				firemonth[in] = fd->cd->trfiremonth[in];
-				firearea[in] = fd->cd->trfirearea[in];
-  	    			if (fd->gd->fireyear[0] > calyr) {
-   					firesize[in]  = fd->gd->firesize[0]; 
-	    			} else {
-	    				for (int ifs=0; ifs<MAX_FSIZE_DRV_YR; ifs++) {
-	    					if (fd->gd->fireyear[ifs] < calyr) {
-	    						firesize[in]  = fd->gd->firesize[ifs];
-	    						break;
-						}
-					}					
-				}
-	  		}
-   		}
+		if (!fd->cd->trfire.empty()) firstfireyr = min(firstfireyr, fd->cd->trfire[0].year);
    	}
 
 	if (runsc) {
 		firstfireyr = END_SC_YR; 
-		for(int in =0; in<MAX_SC_YR; in++){
-			calyr = fd->cd->scfireyear[in];
-   			if(calyr != -1){ 
-    				if (firstfireyr>=calyr) firstfireyr=calyr;
-				occur[in] = fd->cd->scfireyear[in]-BEG_SC_YR;
-				firedate[in] = fd->cd->scfiredate[in];
-				firemonth[in] = fd->cd->scfiremonth[in];
-				firearea[in] = fd->cd->scfirearea[in];
-  	    			if (fd->gd->fireyear[0] > calyr) {
-   					firesize[in]  = fd->gd->firesize[0]; 
-	    			} else {
-	    				for (int ifs=0; ifs<MAX_FSIZE_DRV_YR; ifs++) {
-	    					if (fd->gd->fireyear[ifs] < calyr) {
-	    						firesize[in]  = fd->gd->firesize[ifs];
-	    						break;
-						}
-					}					
-				}
-	  		}
-   		}
+		if (!fd->cd->scfire.empty()) firstfireyr = min(firstfireyr, fd->cd->scfire[0].year);
    	}
 
+	//same stage priority as in getOccur() and burn()
+	if (runsp) {
+		indexFireEvents(fd->cd->spfire, BEG_SP_YR);
+	} else if (runtr) {
+		indexFireEvents(fd->cd->trfire, BEG_TR_YR);
+	} else if (runsc) {
+		indexFireEvents(fd->cd->scfire, BEG_SC_YR);
+	} else {
+		indexFireEvents(vector<FireEvent>(), 0);
+	}
+
 /*
 	if (runtr) {
 		int beg_fire_yr = BEG_TR_YR;
@@ -199,6 +153,25 @@ void WildFire::prepareDrivingData(const bool runeq, const bool runsp, const bool
 
 
 
+};
+
+//'events' sorted by year; years before 'begyr' are never reached by a year index
+void WildFire::indexFireEvents(const vector<FireEvent> & events, const int & begyr){
+	fireevents.clear();
+	for (unsigned int i=0; i<events.size(); i++) {
+		if (events[i].year>=begyr) fireevents.push_back(events[i]);
+	}
+
+	int numyr = fireevents.empty() ? 0 : fireevents.back().year-begyr+1;
+	fireyrbeg.assign(numyr+1, 0);
+	firemonths.assign(numyr, 0);
+	for (unsigned int i=0; i<fireevents.size(); i++) {
+		int iy = fireevents[i].year-begyr;
+		fireyrbeg[iy+1]++;
+		int im = fireevents[i].month;
+		if (im>=0 && im<12) firemonths[iy] |= (1<<im);
+	}
+	for (int iy=0; iy<numyr; iy++) fireyrbeg[iy+1] += fireyrbeg[iy];
 };
 
 int WildFire::getOccur(const int &yrind, const int & mind, const bool & friderived){
@@ -213,35 +186,8 @@ int WildFire::getOccur(const int &yrind, const int & mind, const bool & frideriv
 			}
 		}
 
-	}else if (onerunsp) {
-		for (int i=0; i<MAX_SP_YR; i++){
-			if(occur[i]==yrind){
-				if (firemonth[i] == mind){
-					occ=1;
-					return occ;
-				}
-			}
-		}
-	}else if (oneruntr) {
-		for (int i=0; i<MAX_TR_YR; i++){
-			if(occur[i]==yrind){
-				if (firemonth[i] == mind){
-					occ=1;
-					return occ;
-				}
-			}
-		}
-	}else if (onerunsc) {
-		for (int i=0; i<MAX_SC_YR; i++){
-//cout << "occur["<<i<<"]: "<< occur[i] <<"\n";
-//cout << "yrind: "<<yrind<<" \n";
-			if(occur[i]==yrind){
-				if (firemonth[i] == mind){
-					occ=1;
-					return occ;
-				}
-			}
-		}
+	}else if (yrind>=0 && yrind<(int)firemonths.size() && mind>=0 && mind<12) {
+		occ = (firemonths[yrind]>>mind) & 1;
 	}
 
 /*
@@ -281,62 +227,26 @@ void WildFire::burn(const int & yrind, const bool & friderived){
 
 
  	if(!friderived){
-		if (onerunsp) {
-			for(int in =0; in<MAX_SP_YR; in++){
-				if(occur[in]==yrind){
-					onefiredate = fd->cd->spfiredate[in];
-					onefiremonth = fd->cd->spfiremonth[in];
-					onefirearea = fd->cd->spfirearea[in];
-					onefiresize = fd->gd->firesize[yrind];
-					if (onefiremonth==1 || onefiremonth==2 || onefiremonth==3) {
-						onefireseason=1;
-					} else if (onefiremonth==4 || onefiremonth==5 || onefiremonth==6) {
-						onefireseason=2;
-					} else if (onefiremonth==7 || onefiremonth==8 || onefiremonth==9) {
-						onefireseason=3;
-					} else if (onefiremonth==10 || onefiremonth==11 || onefiremonth==0) {
-						onefireseason=4;
-			    		break;
-					}
-				}
-			}
-		} else if (oneruntr) {
-			for(int in =0; in<MAX_TR_YR; in++){
-				if(occur[in]==yrind){
-					onefiredate = fd->cd->trfiredate[in];
-					onefiremonth = fd->cd->trfiremonth[in];
-					onefirearea = fd->cd->trfirearea[in];
-					onefiresize = fd->gd->firesize[yrind];
-					if (onefiremonth==1 || onefiremonth==2 || onefiremonth==3) {
-						onefireseason=1;
-					} else if (onefiremonth==4 || onefiremonth==5 || onefiremonth==6) {
-						onefireseason=2;
-					} else if (onefiremonth==7 || onefiremonth==8 || onefiremonth==9) {
-						onefireseason=3;
-					} else if (onefiremonth==10 || onefiremonth==11 || onefiremonth==0) {
-						onefireseason=4;
-			    		break;
-					}
-				}
-			}
-		} else if (onerunsc) {
-			for(int in =0; in<MAX_SC_YR; in++){
-				if(occur[in]==yrind){
-					onefiredate = fd->cd->scfiredate[in];
-					onefiremonth = fd->cd->scfiremonth[in];
-					onefirearea = fd->cd->scfirearea[in];
-					onefiresize = fd->gd->firesize[yrind];
-					if (onefiremonth==1 || onefiremonth==2 || onefiremonth==3) {
-						onefireseason=1;
-					} else if (onefiremonth==4 || onefiremonth==5 || onefiremonth==6) {
-						onefireseason=2;
-					} else if (onefiremonth==7 || onefiremonth==8 || onefiremonth==9) {
-						onefireseason=3;
-					} else if (onefiremonth==10 || onefiremonth==11 || onefiremonth==0) {
-						onefireseason=4;
-			    		break;
-					}
-				}
+		int ibeg = 0;
+		int iend = 0;
+		if (yrind>=0 && yrind+1<(int)fireyrbeg.size()) {
+			ibeg = fireyrbeg[yrind];
+			iend = fireyrbeg[yrind+1];
+		}
+		for(int in =ibeg; in<iend; in++){
+			onefiredate = fireevents[in].date;
+			onefiremonth = fireevents[in].month;
+			onefirearea = fireevents[in].area;
+			onefiresize = fd->gd->firesize[yrind];
+			if (onefiremonth==1 || onefiremonth==2 || onefiremonth==3) {
+				onefireseason=1;
+			} else if (onefiremonth==4 || onefiremonth==5 || onefiremonth==6) {
+				onefireseason=2;
+			} else if (onefiremonth==7 || onefiremonth==8 || onefiremonth==9) {
+				onefireseason=3;
+			} else if (onefiremonth==10 || onefiremonth==11 || onefiremonth==0) {
+				onefireseason=4;
+	    		break;
 			}
 		}
 
@@ -354,18 +264,18 @@ void WildFire::burn(const int & yrind, const bool & friderived){
 			onefireseason = 2;
 			onefiresize = fd->gd->firesize[n];
 
-cout <<"onefiredate " << onefiredate<< "\n";
-cout <<"onefirearea " << onefirearea << "\n";
-cout <<"onefiremonth " << onefiremonth<< "\n";
-cout <<"onefireseason " << onefireseason<< "\n";
-cout <<"onefiresize " <<onefiresize << "\n";
+LOG(LOG_DEBUG) <<"onefiredate " << onefiredate<< "\n";
+LOG(LOG_DEBUG) <<"onefirearea " << onefirearea << "\n";
+LOG(LOG_DEBUG) <<"onefiremonth " << onefiremonth<< "\n";
+LOG(LOG_DEBUG) <<"onefireseason " << onefireseason<< "\n";
+LOG(LOG_DEBUG) <<"onefiresize " <<onefiresize << "\n";
 
 		}
 	}
 	// for soil part and root burning
  	updateBurnThickness(yrind, friderived);	
 
-cout <<"fd->y_soid.OLR: "<<fd->y_soid.OLR<<"\n";
+LOG(LOG_DEBUG) <<"fd->y_soid.OLR: "<<fd->y_soid.OLR<<"\n";
 	
 	double burndepth = fd->y_soid.burnthick;
  	double totbotdepth =0.;
@@ -637,14 +547,14 @@ double WildFire::getBurnThick(const int & yrind, const bool & friderived){
 				bthick = 0.48 * totorg;	
 				OLR=0.48;
 			}
-cout << "OLR: " << OLR <<"\n";
+LOG(LOG_DEBUG) <<"OLR: " << OLR <<"\n";
 		} else {
 			if(fd->gd->slope<2){
 				OLR=0.1276966713-0.0319397467*fd->gd->slope+0.0020914862*onefiredate+0.0127016155* log (onefirearea);
 			}else if(fd->gd->slope>=2){
 				OLR=-0.2758306315+0.0117609336*fd->gd->slope-0.0744057680*cos ( fd->gd->aspect * 3.14159265 / 180 ) +0.0260221684*ed->m_sois.tshlw+0.0011413114*onefiredate+0.0336302905*log (onefirearea);
 			}
-cout << "OLR: " << OLR <<"\n";
+LOG(LOG_DEBUG) <<"OLR: " << OLR <<"\n";
 			
 			if (OLR > 1) OLR=1;
 			if (OLR < 0) OLR=0;
@@ -688,7 +598,7 @@ cout << "OLR: " << OLR <<"\n";
 	if(totorg-bthick<0.02){ //there are at least 2 cm orgnanic left
 		bthick = totorg-0.02;
 	}
-cout << "bthick: " << bthick <<"\n";
+LOG(LOG_DEBUG) <<"bthick: " << bthick <<"\n";
 fd->y_soid.OLR=OLR;
 
 	return bthick;
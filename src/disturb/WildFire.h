@@ -9,6 +9,7 @@ using namespace std;
 
 #include "../data/EnvData.h"
 #include "../data/FirData.h"
+#include "../data/CohortData.h"
 #include "../data/BgcData.h"
 #include "../data/RestartData.h"
 
@@ -86,12 +87,14 @@ class WildFire{
 		int severity[MAX_FIR_OCR_NUM];
 */
 
-		int occur[MAX_YR];
-		int firedate[MAX_YR];
-		int firemonth[MAX_YR];
-		int firearea[MAX_YR];
-		int fireseason[MAX_YR];
-		int firesize[MAX_YR];
+		//fire events of the run stage used by getOccur() and burn(), indexed by year from the
+		// stage's beginning: events of year index 'iy' are fireevents[fireyrbeg[iy]] to
+		// fireevents[fireyrbeg[iy+1]-1], and bit 'im' of firemonths[iy] is set for a fire in month 'im'
+		vector<FireEvent> fireevents;
+		vector<int> fireyrbeg;
+		vector<int> firemonths;
+
+		void indexFireEvents(const vector<FireEvent> & events, const int & begyr);
 
      	CohortLookup * chtlu;
    	EnvData* ed;
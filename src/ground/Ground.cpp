@@ -51,6 +51,7 @@ Ground::~Ground(){
 //////////////////////////////////////////////////////////////////////////////
 int Ground::updateDaily(const int & yrcnt, const int & year,
 			 const int & mind, const int & id, const double & tdrv2, const double & dayl){
+	PHASE_SCOPE("Ground::updateDaily");
 
 	int error = 0;
 
@@ -31,6 +31,7 @@ using namespace std;
 #include "../data/BgcData.h"
 
 #include "../data/RestartData.h"
+#include "../util/PhaseTimer.h"
 
 class Ground: public DoubleLinkedList {
 
@@ -1,4 +1,5 @@
 #include "Mineral.h"
+#include "../util/Logger.h"
 
 Mineral::Mineral(){
 	
@@ -31,7 +32,7 @@ void Mineral::initThicknesses(const double & thickness){
 void Mineral::updateClay(int clays[], const int & numtype){
 	for(int i=0; i<numtype;i++){
 		 clay[i] = clays[i];
-cout << "clay[i]: " << clay[i]<< "\n";
+LOG(LOG_DEBUG) <<"clay[i]: " << clay[i]<< "\n";
 	};
 
 };
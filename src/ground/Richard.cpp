@@ -7,6 +7,17 @@ Richard::Richard(){
      TSTEPORG = 0.1;
           
      ttole =1;  
+
+     resetStats();
+};
+
+void Richard::resetStats(){
+	stats.calls      = 0;
+	stats.substeps   = 0;
+	stats.iterations = 0;
+	stats.halvings   = 0;
+	stats.bailouts   = 0;
+	stats.mintstep   = TSTEPMAX;
 };
 
 Richard::~Richard(){
@@ -38,6 +49,8 @@ void Richard::updateSoilStructure(Layer* fstsoill){
 
 void Richard::update(Layer * frontl, Layer *backl, Layer *fstsoill, Layer* drainl,  double & drain,
  	       const double & trans, const double & evap,const double & infil, const double & zwt){
+	PHASE_SCOPE("Richard::update");
+	TRACE_SCOPE("Richard::update");
  	// prepare arrays for variables which will not change during one day
     	// root fraction, temperature, ice
     	// it is assumed that all layers in Richard will be unfrozen       	
@@ -68,6 +81,7 @@ void Richard::update(Layer * frontl, Layer *backl, Layer *fstsoill, Layer* drain
 	    	}
 	    	currl = currl->nextl;	
 	}
+	TRACE_COUNTER("active layers", numal);
     
     	if(lstunfl==NULL){
     		return;	
@@ -132,6 +146,7 @@ void Richard::iterate(Layer *fstsoill,const double & trans, const double & evap,
 	tschanged = true;
 	tmld  = 0;    // tmld is time that is last determined	
 	itsum = 0;
+	stats.calls++;
 	tleft = 1;  // at beginning of update, tleft is one day
 	if(infil>0){
 		TSTEPORG =TSTEPMAX/5.;	
@@ -146,6 +161,7 @@ void Richard::iterate(Layer *fstsoill,const double & trans, const double & evap,
 	}
 
 	while(tmld<1){
+		TRACE_SCOPE("Richard substep");
 		//cout <<"TMLD " << tmld << " time step " << tstep << "\n";
 		for(int i=1; i<=numal; i++){
 	 		liqis[i] = liqld[i];	
@@ -155,17 +171,21 @@ void Richard::iterate(Layer *fstsoill,const double & trans, const double & evap,
 		int st = updateOneTimeStep(fstsoill, trans, evap, infil);
 		if(st==-1) {				
 			tstep = tstep/2;   // half the time step
+			stats.halvings++;
+			if(tstep<stats.mintstep) stats.mintstep = tstep;
 			if(tstep < 1.e-6){
 //				string msg = "tstep is too small in richard2 ";
 //				char* msgc = const_cast< char* > ( msg.c_str());
 //				throw Exception(msgc, I_WAT_TSTEP_SMALL);   //Yuan: this will break the model
 //				cout<<msg<<"\n";
+				stats.bailouts++;
 				return;
 			}
 			tschanged = true;
 		
 		} else if(st==0){   //advance to next timestep
 			
+			stats.substeps++;
 			tleft -= tstep;
 			tmld += tstep;
 		 
@@ -243,6 +263,7 @@ int Richard::updateOneIteration(Layer *fstsoill, const double & trans, const dou
     	SoilLayer* nexts, *thsl;
 	int ind=0;
 	itsum++;
+	stats.iterations++;
 	for(int il =0; il<MAX_SOI_LAY; il++){
 		dwat[il]=0.;	
 	}
@@ -13,6 +13,9 @@
 #include "../util/CrankNicholson.h"
 #include "../data/EnvData.h"
 #include "../util/Exception.h"
+#include "../util/PhaseTimer.h"
+#include "../util/TraceRecorder.h"
+#include "../inc/solverstats.h"
 
 class Richard{
 	public :
@@ -32,6 +35,9 @@ class Richard{
 		int itsum;
 		int itsumabv;
 		int itsumblw;
+
+		stepstats stats;      // solver counters since resetStats()
+		void resetStats();
 	
 
 	private:
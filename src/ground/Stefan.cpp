@@ -7,6 +7,17 @@ Stefan::Stefan(){
      
      ttole =0.05;  // don't change this threshold
      // I have tried 0.5 , and got some unrealistic results
+
+     resetStats();
+};
+
+void Stefan::resetStats(){
+	stats.calls      = 0;
+	stats.substeps   = 0;
+	stats.iterations = 0;
+	stats.halvings   = 0;
+	stats.bailouts   = 0;
+	stats.mintstep   = TSTEPORG;
 };
 
 Stefan::~Stefan(){
@@ -16,6 +27,8 @@ Stefan::~Stefan(){
 
 
 int Stefan::updateFronts(const double & tdrv, Layer *frontl, Layer *backl,Layer *fstsoill, Layer* lstminl, const int & mind){
+	PHASE_SCOPE("Stefan::updateFronts");
+	TRACE_SCOPE("Stefan::updateFronts");
 
 	int error = 0;
 
@@ -610,6 +623,8 @@ void  Stefan::processSoilLayer5Bot(const int &frozenstate, double const & tkres,
  
 void Stefan::updateTemps(const double & tdrv, Layer *frontl, Layer *backl ,Layer* fstsoill,
   						Layer* fstfntl, Layer *lstfntl ){
+	PHASE_SCOPE("Stefan::updateTemps");
+	TRACE_SCOPE("Stefan::updateTemps");
   	   
      itsumall =0;
      itsumabv =0;
@@ -983,6 +998,7 @@ void Stefan::iterate(const int &startind, const int &endind, const bool & lstlay
 	tmld =0; // tmld is time that is last determined
 	
 	itsum =0;
+	stats.calls++;
 	/* at beginning of update, tleft is one day*/
 	tleft = 1;
 	tstep =TSTEPORG; ;
@@ -993,6 +1009,7 @@ void Stefan::iterate(const int &startind, const int &endind, const bool & lstlay
 	}
 
 	while(tmld<1){
+		TRACE_SCOPE("Stefan substep");
 		//cout <<"TMLD " << tmld << " time step " << tstep << "\n";
 		for(int i=startind; i<=endind; i++){
 	 		tis[i] = tld[i];	
@@ -1002,14 +1019,18 @@ void Stefan::iterate(const int &startind, const int &endind, const bool & lstlay
 		if(st==-1) {
 	  	// half the time step	
 	  	 tstep = tstep/2;
+	  	 stats.halvings++;
+	  	 if(tstep<stats.mintstep) stats.mintstep = tstep;
 	  	 if(tstep < 1.e-6){
 //	  	   throw Exception("tstep is too small in Stefan", ERRORKEY(I_TEM_TSTEP_SMALL));
 //	  	   cout<<"tstep is too small in Stefan\n";
+	  	   stats.bailouts++;
 	  	   return;     //Yuan: don't break
 	  	 }
 	  	 tschanged = true;
 		}else if(st==0){
 		 // find one solution for one timestep, advance to next one
+		 stats.substeps++;
 		 tleft -= tstep;
 		 tmld += tstep;
 		 
@@ -1068,6 +1089,7 @@ int Stefan::updateOneTimeStep(const int startind, const int & endind, const bool
 /*! the main calculation will be done here*/
 int Stefan::updateOneIteration( const int startind, const int & endind, const bool & lstlaybot ,const bool & fstlaytop, Layer *frontl){
 	itsum++;
+	stats.iterations++;
 	double tself, tdown, tup, t1, t2;
 	double hclat;
     double dt = tstep *86400.;
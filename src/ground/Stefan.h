@@ -14,6 +14,9 @@
 #include "../inc/ErrorCode.h"
 #include "../inc/layerconst.h"
 #include "../util/Exception.h"
+#include "../util/PhaseTimer.h"
+#include "../util/TraceRecorder.h"
+#include "../inc/solverstats.h"
 
 class Stefan{
   public:
@@ -26,6 +29,9 @@ class Stefan{
   
   int checkFrontsValidity(Layer *fstsoill);
    int itsumall;
+
+   stepstats stats;      // solver counters since resetStats()
+   void resetStats();
   /*! the maximum allowable time step (double)*/
   private:
   	
@@ -7,7 +7,8 @@
  	   I_NIMMOB_RANGE=50,I_NUPTAKE_RANGE,
  	   I_BURN_ZERO =60, 
  	   I_LAYER_FIRST_DEEP=70, I_FRONT_STATE_INCON,  I_FRONT_POSITION,
- 	   I_NCFILE_NOT_EXIST=100, I_NCDIM_NOT_EXIST, I_NCVAR_NOT_EXIST, I_NCVAR_GET_ERROR};
+ 	   I_NCFILE_NOT_EXIST=100, I_NCDIM_NOT_EXIST, I_NCVAR_NOT_EXIST, I_NCVAR_GET_ERROR,
+ 	   I_INPACK_INVALID=110, I_INPACK_NO_SECTION, I_INPACK_RANGE};
 
 	#ifndef NULL
 		#define NULL   ((void *) 0)
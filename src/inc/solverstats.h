@@ -0,0 +1,29 @@
+/*
+ * \file
+ * defines struct for the counters of the numerical solvers, accumulated over a run stage of a cohort
+ */
+#ifndef SOLVERSTATS_H_
+	#define SOLVERSTATS_H_
+
+// adaptive daily time-stepping (Stefan, Richard)
+struct stepstats{
+	long calls;       // daily solutions, i.e. iterate() calls
+	long substeps;    // accepted (fractional day) time steps
+	long iterations;  // iterations over all time steps
+	long halvings;    // rejected time steps, i.e. time step halved
+	long bailouts;    // days given up with time step below 1e-6 day
+	double mintstep;  // smallest time step tried (day)
+};
+
+// adaptive monthly RKF45 integration (Integrator)
+struct rkfstats{
+	long calls;       // monthly integrations
+	long accepted;    // accepted steps
+	long rejected;    // rejected steps, i.e. step halved
+	long forced;      // steps accepted at the smallest step size (mflag)
+	long blackhol;    // months given up, with the state restored (blackhol)
+	long derivs;      // derivative evaluations, i.e. delta() calls (6 per rkf45 step tried)
+	double mindt;     // smallest step tried (month)
+};
+
+#endif /*SOLVERSTATS_H_*/
@@ -0,0 +1,200 @@
+#include "ClimateScenario.h"
+
+ClimateScenario::ClimateScenario(){
+	filename    = "";
+	firstyear   = BEG_TR_YR;
+	basefirstyr = -1;
+	baselastyr  = -1;
+	for (int iv=0; iv<CLM_NVAR; iv++) {
+		detrend[iv]   = false;
+		normalize[iv] = false;
+	}
+};
+
+ClimateScenario::~ClimateScenario(){
+
+};
+
+int ClimateScenario::varIndex(const string & name){
+	if (name=="TAIR") return 0;
+	if (name=="PREC") return 1;
+	if (name=="NIRR") return 2;
+	if (name=="VAPO") return 3;
+	return -1;
+};
+
+void ClimateScenario::error(const string & msg){
+	string emsg = msg+" in climate scenario "+filename;
+	char* msgc = const_cast< char* > ( emsg.c_str());
+	throw Exception(msgc, I_INPUT_INVALID);
+};
+
+void ClimateScenario::read(const string & file){
+	filename = file;
+	ifstream fin(file.c_str());
+	if (!fin) error("cannot open file");
+
+	int firstper = -1;        //period of the delta/ratio lines, all years if -1
+	int lastper  = -1;
+	string line;
+	int lineno = 0;
+	while (getline(fin, line)) {
+		lineno++;
+		size_t ic = line.find('#');
+		if (ic!=string::npos) line.erase(ic);
+		istringstream ls(line);
+		string key;
+		if (!(ls >> key)) continue;
+
+		ostringstream where;
+		where <<" at line "<<lineno;
+
+		if (key=="firstyear") {
+			if (!(ls >> firstyear)) error("no year"+where.str());
+		} else if (key=="baseline" || key=="period") {
+			int y1, y2;
+			if (!(ls >> y1 >> y2) || y2<y1) error("no first and last year"+where.str());
+			if (key=="baseline") {
+				basefirstyr = y1;
+				baselastyr  = y2;
+			} else {
+				firstper = y1;
+				lastper  = y2;
+			}
+		} else if (key=="detrend" || key=="normalize") {
+			string name;
+			int nvar = 0;
+			while (ls >> name) {
+				int iv = varIndex(name);
+				if (iv<0) error("unknown variable '"+name+"'"+where.str());
+				if (key=="detrend") {
+					detrend[iv] = true;
+				} else {
+					normalize[iv] = true;
+				}
+				nvar++;
+			}
+			if (nvar==0) error("no variable"+where.str());
+		} else if (key=="delta" || key=="ratio") {
+			string name;
+			MonthChange ch;
+			ls >> name;
+			ch.var = varIndex(name);
+			if (ch.var<0) error("unknown variable '"+name+"'"+where.str());
+			ch.ratio   = (key=="ratio");
+			ch.firstyr = firstper;
+			ch.lastyr  = lastper;
+			for (int im=0; im<12; im++) {
+				if (!(ls >> ch.value[im])) error("not 12 monthly values"+where.str());
+			}
+			changes.push_back(ch);
+		} else {
+			error("unknown entry '"+key+"'"+where.str());
+		}
+	}
+
+	bool norm = false;
+	for (int iv=0; iv<CLM_NVAR; iv++) norm = norm || normalize[iv];
+	if (norm && basefirstyr<0) error("'normalize' without 'baseline'");
+};
+
+// the monthly climate just read for a grid
+void ClimateScenario::apply(GridData * gd){
+	float (*clm[CLM_NVAR])[12] = {gd->ta, gd->prec, gd->nirr, gd->vap};
+	int nyr = gd->act_atm_drv_yr;
+
+	float base[MAX_ATM_DRV_YR][12];
+	for (int iv=0; iv<CLM_NVAR; iv++) {
+		if (normalize[iv]) copy(&clm[iv][0][0], &clm[iv][0][0]+nyr*12, &base[0][0]);
+		if (detrend[iv]) detrendVar(clm[iv], nyr);
+		if (normalize[iv]) normalizeVar(iv, clm[iv], base, nyr);
+	}
+
+	applyChanges(clm, 0, nyr);
+};
+
+bool ClimateScenario::needsAllYears(){
+	for (int iv=0; iv<CLM_NVAR; iv++) {
+		if (detrend[iv] || normalize[iv]) return true;
+	}
+	return false;
+};
+
+void ClimateScenario::applyChanges(float (*clm[CLM_NVAR])[12], const int & iy0, const int & nyr){
+	for (unsigned int ic=0; ic<changes.size(); ic++) {
+		changeVar(changes[ic], clm[changes[ic].var], iy0, nyr);
+	}
+
+	for (int iv=1; iv<CLM_NVAR; iv++) {
+		for (int iy=0; iy<nyr; iy++) {
+			for (int im=0; im<12; im++) {
+				if (clm[iv][iy][im]<0.) clm[iv][iy][im] = 0.;
+			}
+		}
+	}
+};
+
+// least squares line over the years of each calendar month, less its slope
+void ClimateScenario::detrendVar(float clm[][12], const int & nyr){
+	if (nyr<2) return;
+	double tmean = (nyr-1)/2.;
+	for (int im=0; im<12; im++) {
+		double xmean = 0.;
+		for (int iy=0; iy<nyr; iy++) xmean += clm[iy][im];
+		xmean /= nyr;
+
+		double sxy = 0.;
+		double sxx = 0.;
+		for (int iy=0; iy<nyr; iy++) {
+			sxy += (iy-tmean)*(clm[iy][im]-xmean);
+			sxx += (iy-tmean)*(iy-tmean);
+		}
+		double slope = sxy/sxx;
+		for (int iy=0; iy<nyr; iy++) clm[iy][im] -= slope*iy;
+	}
+};
+
+void ClimateScenario::normalizeVar(const int & var, float clm[][12], float base[][12], const int & nyr){
+	int iy1 = max(basefirstyr-firstyear, 0);
+	int iy2 = min(baselastyr-firstyear, nyr-1);
+	if (iy2<iy1) error("baseline period not in the climate data");
+
+	bool offset = (var==0 || var==3);
+	for (int im=0; im<12; im++) {
+		double basemean = 0.;
+		double mean = 0.;
+		for (int iy=iy1; iy<=iy2; iy++) {
+			basemean += base[iy][im];
+			mean += clm[iy][im];
+		}
+		basemean /= iy2-iy1+1;
+		mean /= iy2-iy1+1;
+
+		for (int iy=0; iy<nyr; iy++) {
+			if (offset) {
+				clm[iy][im] += basemean-mean;
+			} else if (mean>0.) {
+				clm[iy][im] *= basemean/mean;
+			}
+		}
+	}
+};
+
+// clm[0] is year 'iy0' of the climate data
+void ClimateScenario::changeVar(const MonthChange & ch, float clm[][12], const int & iy0, const int & nyr){
+	int iy1 = 0;
+	int iy2 = nyr-1;
+	if (ch.firstyr>=0) {
+		iy1 = max(ch.firstyr-firstyear-iy0, 0);
+		iy2 = min(ch.lastyr-firstyear-iy0, nyr-1);
+	}
+	for (int iy=iy1; iy<=iy2; iy++) {
+		for (int im=0; im<12; im++) {
+			if (ch.ratio) {
+				clm[iy][im] *= ch.value[im];
+			} else {
+				clm[iy][im] += ch.value[im];
+			}
+		}
+	}
+};
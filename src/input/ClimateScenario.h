@@ -0,0 +1,81 @@
+#ifndef CLIMATESCENARIO_H_
+#define CLIMATESCENARIO_H_
+
+/*! a climate scenario as a small parameter file on top of the base climate of a run
+ *  ('clmscenario <file>' in the control file), applied to the monthly climate of each grid
+ *  when it is read, instead of one detrended/rewritten set of netcdf files per scenario
+ * \file
+ *
+ *  the file has one entry per line, '#' to the end of a line is a comment:
+ *
+ *     firstyear 1901           calendar year of the first year of the climate data (default 1901)
+ *     detrend TAIR VAPO        remove the linear trend of each calendar month, keeping the
+ *                              value of the first year (as detrend.py)
+ *     baseline 1961 1990       baseline period of 'normalize'
+ *     normalize TAIR PREC      bring the mean of each calendar month over the baseline period
+ *                              back to that of the base climate (after 'detrend')
+ *     period 2010 2100         years of the 'delta'/'ratio' lines after it (default all)
+ *     delta TAIR  <12 values>  added to each month (degC, mbar)
+ *     ratio PREC  <12 values>  multiplying each month
+ *
+ *  variables are TAIR, PREC, NIRR and VAPO; TAIR and VAPO are normalized by an offset,
+ *  PREC and NIRR by a ratio. The transforms go in the order detrend, normalize, then the
+ *  delta/ratio lines in the order of the file; PREC, NIRR and VAPO are kept at 0 or above
+ */
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+using namespace std;
+
+#include "../data/GridData.h"
+#include "../data/ClimateSource.h"
+#include "../inc/timeconst.h"
+#include "../util/Exception.h"
+#include "../inc/ErrorCode.h"
+
+class ClimateScenario{
+	public:
+		ClimateScenario();
+		~ClimateScenario();
+
+		void read(const string & file);
+		void apply(GridData * gd);
+
+		//'detrend' and 'normalize' need all the years at once; the 'delta'/'ratio' lines
+		//(and the clamping) can also go on years 'iy0' to 'iy0+nyr-1' alone
+		bool needsAllYears();
+		void applyChanges(float (*clm[CLM_NVAR])[12], const int & iy0, const int & nyr);
+
+	private:
+
+		//one 'delta' or 'ratio' line
+		struct MonthChange{
+			int var;
+			bool ratio;
+			int firstyr;             //calendar years
+			int lastyr;
+			float value[12];
+		};
+
+		string filename;
+		int firstyear;
+		bool detrend[CLM_NVAR];
+		bool normalize[CLM_NVAR];
+		int basefirstyr;
+		int baselastyr;
+		vector<MonthChange> changes;
+
+		static int varIndex(const string & name);
+		void error(const string & msg);
+
+		void detrendVar(float clm[][12], const int & nyr);
+		void normalizeVar(const int & var, float clm[][12], float base[][12], const int & nyr);
+		void changeVar(const MonthChange & ch, float clm[][12], const int & iy0, const int & nyr);
+
+};
+
+#endif /*CLIMATESCENARIO_H_*/
@@ -0,0 +1,128 @@
+#include "ClimateStream.h"
+
+ClimateStream::ClimateStream(){
+	filename = "";
+	clmFile  = NULL;
+	numyr    = 0;
+	winyr    = 0;
+	clmrecid = -1;
+	firstyr  = 0;
+	nwinyr   = 0;
+	clmscen  = NULL;
+	for (int iv=0; iv<CLM_NVAR; iv++) {
+		clmV[iv] = NULL;
+		win[iv]  = NULL;
+	}
+};
+
+ClimateStream::~ClimateStream(){
+	for (int iv=0; iv<CLM_NVAR; iv++) {
+		delete [] win[iv];
+	}
+	delete clmFile;
+};
+
+void ClimateStream::open(const string & file, const int & nyear, const int & window){
+	NcError err(NcError::silent_nonfatal);
+
+	//a window has the year before the one asked for, and that year
+	if (window<2) {
+		string msg = "ClimateStream::open - climatewindow must be 2 years or more";
+		char* msgc = const_cast<char*> (msg.c_str());
+		throw Exception(msgc, I_INPUT_INVALID);
+	}
+
+	filename = file;
+	clmFile  = new NcFile(filename.c_str(), NcFile::ReadOnly);
+	if (!clmFile->is_valid()) {
+		string msg = filename+" is not valid";
+		char* msgc = const_cast<char*> (msg.c_str());
+		throw Exception(msgc, I_NCFILE_NOT_EXIST);
+	}
+
+	const char* names[CLM_NVAR] = {"TAIR", "PREC", "NIRR", "VAPO"};
+	for (int iv=0; iv<CLM_NVAR; iv++) {
+		clmV[iv] = clmFile->get_var(names[iv]);
+		if (clmV[iv]==NULL) {
+			string msg = "Cannot get "+string(names[iv])+" in ClimateStream::open";
+			char* msgc = const_cast<char*> (msg.c_str());
+			throw Exception(msgc, I_NCVAR_NOT_EXIST);
+		}
+	}
+
+	numyr = nyear;
+	winyr = min(window, numyr);
+	for (int iv=0; iv<CLM_NVAR; iv++) {
+		win[iv] = new float[winyr][12];
+	}
+	nwinyr = 0;
+};
+
+bool ClimateStream::isOpen(){
+	return clmFile!=NULL;
+};
+
+void ClimateStream::setRecord(const int & recid){
+	clmrecid = recid;
+	nwinyr   = 0;
+};
+
+// only the 'delta'/'ratio' lines can go on a window (see ClimateScenario::needsAllYears)
+void ClimateStream::setClimateScenario(ClimateScenario * scen){
+	if (scen->needsAllYears()) {
+		string msg = "ClimateStream - 'detrend'/'normalize' of a climate scenario need all the years of climate, not with 'climatewindow'";
+		char* msgc = const_cast<char*> (msg.c_str());
+		throw Exception(msgc, I_INPUT_INVALID);
+	}
+	clmscen = scen;
+};
+
+int ClimateStream::years(){
+	return numyr;
+};
+
+float ClimateStream::get(const int & var, const int & iy, const int & im){
+	if (iy<firstyr || iy>=firstyr+nwinyr) load(iy);
+	return win[var][iy-firstyr][im];
+};
+
+void ClimateStream::load(const int & iy){
+	PHASE_SCOPE("ClimateStream::load");
+
+	NcError err(NcError::silent_nonfatal);
+
+	if (iy<0 || iy>=numyr) {
+		string msg = "ClimateStream::load - year not in the climate data";
+		char* msgc = const_cast<char*> (msg.c_str());
+		throw Exception(msgc, I_INPUT_INVALID);
+	}
+
+	firstyr = max(min(iy-1, numyr-winyr), 0);
+	nwinyr  = 0;
+
+	for (int iv=0; iv<CLM_NVAR; iv++) {
+		clmV[iv]->set_cur(clmrecid, firstyr, 0);
+		if (!clmV[iv]->get(&win[iv][0][0], 1, winyr, 12)) {
+			string msg = "problem in reading "+string(clmV[iv]->name())+" in ClimateStream::load";
+			char* msgc = const_cast<char*> (msg.c_str());
+			throw Exception(msgc, I_NCVAR_GET_ERROR);
+		}
+	}
+
+	//as checked for all years by Grid::reinit without a window
+	for (int iv=0; iv<CLM_NVAR; iv++) {
+		for (int jy=0; jy<winyr; jy++) {
+			for (int im=0; im<12; im++) {
+				if (win[iv][jy][im]<=-999) {
+					string msg = "climate data error in ClimateStream::load";
+					char* msgc = const_cast<char*> (msg.c_str());
+					throw Exception(msgc, I_INPUT_INVALID);
+				}
+			}
+		}
+	}
+
+	if (clmscen!=NULL) clmscen->applyChanges(win, firstyr, winyr);
+
+	nwinyr = winyr;
+};
@@ -0,0 +1,68 @@
+#ifndef CLIMATESTREAM_H_
+#define CLIMATESTREAM_H_
+
+/*! the climate of a grid read from the climate file a window of years at a time
+ * \file
+ *
+ *  with 'climatewindow <years>' in the control file, the climate of the grid in use is read
+ *  'years' at a time as the run asks for it, instead of all years into GridData. The run
+ *  length is still that of the Timer (and of the CO2, fire and output arrays), so a climate
+ *  file with more years than a run goes through is refused (GridInputer::init), and
+ *  GridData keeps its arrays of MAX_ATM_DRV_YR years.
+ *
+ *  a window is read from the year before the one asked for (the daily drivers of January
+ *  need the December before), so a run going forward reads each year about once, with the
+ *  next years read ahead in the same call; going back (the eq averages, or the years reused
+ *  from the start) reads the window there again. A climate scenario is applied to each
+ *  window as read, so it can have only 'delta'/'ratio' lines.
+ */
+
+#include <string>
+#include <algorithm>
+using namespace std;
+
+#include <netcdfcpp.h>
+
+#include "../data/ClimateSource.h"
+#include "../util/Exception.h"
+#include "../inc/ErrorCode.h"
+#include "../util/PhaseTimer.h"
+
+#include "ClimateScenario.h"
+
+class ClimateStream : public ClimateSource{
+	public:
+		ClimateStream();
+		~ClimateStream();
+
+		//'file' with 'nyear' years, as checked by GridInputer::initClimate
+		void open(const string & file, const int & nyear, const int & window);
+		void setRecord(const int & recid);          //the grid from now on
+		void setClimateScenario(ClimateScenario * scen);
+
+		bool isOpen();
+
+		int years();
+		float get(const int & var, const int & iy, const int & im);
+
+	private:
+
+		string filename;
+		NcFile* clmFile;
+		NcVar* clmV[CLM_NVAR];
+
+		int numyr;
+		int winyr;                   //years read at a time
+		int clmrecid;
+
+		int firstyr;                 //years in the window, none if nwinyr is 0
+		int nwinyr;
+		float (*win[CLM_NVAR])[12];
+
+		ClimateScenario * clmscen;
+
+		void load(const int & iy);
+
+};
+
+#endif /*CLIMATESTREAM_H_*/
@@ -1,7 +1,9 @@
 #include "CohortInputer.h"
+#include "../util/Logger.h"
 
 CohortInputer::CohortInputer(){
 	useseverity =0;
+	pack = NULL;
 };
 
 CohortInputer::~CohortInputer(){
@@ -9,16 +11,28 @@ CohortInputer::~CohortInputer(){
 }
 
 void CohortInputer::init(){
-  	if(md!=NULL){
+  	if(md!=NULL && pack!=NULL){
+  		// all checking done when packing
+  		useseverity = md->useseverity;
+  		firesp_drv_yr = pack->getReclen("SP/YOB");
+  		firetr_drv_yr = pack->getReclen("TR/YOB");
+  		firesc_drv_yr = pack->getReclen("SC/YOB");
+  		if (firesp_drv_yr>MAX_SP_YR || firetr_drv_yr>MAX_TR_YR || firesc_drv_yr>MAX_SC_YR) {
+  			string msg = "CohortInputer::init - too many fire years in input pack";
+  			char* msgc = const_cast<char*> (msg.c_str());
+  			throw Exception(msgc, I_INPACK_INVALID);
+  		}
+
+  	} else if(md!=NULL){
                 useseverity = md->useseverity;
   		if(md->runsp){
-cout << "lala4 \n";		
+LOG(LOG_DEBUG) <<"lala4 \n";		
    			initEqChtidFile(md->eqchtinputdir);
-cout << "lala5 \n";		
+LOG(LOG_DEBUG) <<"lala5 \n";		
  			initSpChtidFile(md->spchtinputdir);
-cout << "lala6 \n";		
+LOG(LOG_DEBUG) <<"lala6 \n";		
    			initSpinupFire(md->spchtinputdir);
-cout << "lala7 \n";		
+LOG(LOG_DEBUG) <<"lala7 \n";		
 	  	}
   
   		if(md->runtr){
@@ -34,13 +48,13 @@ cout << "lala7 \n";
    			initScChtidFile(md->scchtinputdir);
   		}
 
-cout << "lala8 \n";		
+LOG(LOG_DEBUG) <<"lala8 \n";		
   		initEqChtidFile(md->eqchtinputdir);
-cout << "lala9 \n";		
+LOG(LOG_DEBUG) <<"lala9 \n";		
  		initVegetation(md->eqchtinputdir);
-cout << "lala10 \n";		
+LOG(LOG_DEBUG) <<"lala10 \n";		
   		initDrainage(md->eqchtinputdir);
-cout << "lala11 \n";		
+LOG(LOG_DEBUG) <<"lala11 \n";		
   
   	}else{
   		string msg = "inputer in CohortInputer::init is null";
@@ -272,6 +286,8 @@ void CohortInputer::initScenarioFire(string& dir){
 ///////////////////////////////////////////////////////////////////////
 //YUAN: recid - the order (from ZERO) in the .nc file, chtid - the cohort id
 int CohortInputer::getEqRecID(const int &chtid){
+	if (pack!=NULL) return pack->getRecID("EQ/EQCHTID", chtid);
+
 	NcError err(NcError::silent_nonfatal);
 
 	NcFile eqidFile(eqidfname.c_str(), NcFile::ReadOnly);
@@ -292,6 +308,11 @@ int CohortInputer::getEqRecID(const int &chtid){
 }
 
 void CohortInputer::getGrdID(int & grdid, const int &recid){
+	if (pack!=NULL) {
+		grdid = pack->getInt("EQ/GRDID", recid)[0];
+		return;
+	}
+
 	NcError err(NcError::silent_nonfatal);
 
 	NcFile idFile(eqidfname.c_str(), NcFile::ReadOnly);
@@ -308,6 +329,11 @@ void CohortInputer::getGrdID(int & grdid, const int &recid){
 }
 
 void CohortInputer::getVegetation(int & vtype,  const int &recid){
+	if (pack!=NULL) {
+		vtype = pack->getInt("EQ/VEGID", recid)[0];
+		return;
+	}
+
 	NcError err(NcError::silent_nonfatal);
 
 	NcFile vegetationFile(vegidfname.c_str(), NcFile::ReadOnly);
@@ -324,6 +350,11 @@ void CohortInputer::getVegetation(int & vtype,  const int &recid){
 }
 
 void CohortInputer::getDrainage(int & dtype, const int & recid){
+	if (pack!=NULL) {
+		dtype = pack->getInt("EQ/DRAINID", recid)[0];
+		return;
+	}
+
 	NcError err(NcError::silent_nonfatal);
 
 	NcFile drainageFile(drgidfname.c_str(), NcFile::ReadOnly);
@@ -340,6 +371,8 @@ void CohortInputer::getDrainage(int & dtype, const int & recid){
 }
 
 int CohortInputer::getSpRecID(const int &chtid){
+	if (pack!=NULL) return pack->getRecID("SP/SPCHTID", chtid);
+
 	NcError err(NcError::silent_nonfatal);
 
 
@@ -362,6 +395,8 @@ int CohortInputer::getSpRecID(const int &chtid){
 }
 
 int CohortInputer::getTrRecID(const int &chtid){
+	if (pack!=NULL) return pack->getRecID("TR/TRCHTID", chtid);
+
 	NcError err(NcError::silent_nonfatal);
 
 	NcFile trchtidFile(tridfname.c_str(), NcFile::ReadOnly);
@@ -383,6 +418,8 @@ int CohortInputer::getTrRecID(const int &chtid){
 }
 
 int CohortInputer::getScRecID(const int &chtid){
+	if (pack!=NULL) return pack->getRecID("SC/SCCHTID", chtid);
+
 	NcError err(NcError::silent_nonfatal);
 
 	NcFile scchtidFile(scidfname.c_str(), NcFile::ReadOnly);
@@ -404,6 +441,11 @@ int CohortInputer::getScRecID(const int &chtid){
 }
 
 void CohortInputer::getEqchtid5SpFile(int & eqchtid,  const int &recid){
+	if (pack!=NULL) {
+		eqchtid = pack->getInt("SP/EQCHTID", recid)[0];
+		return;
+	}
+
 	NcError err(NcError::silent_nonfatal);
 
 	NcFile spchtidFile(spidfname.c_str(), NcFile::ReadOnly);
@@ -420,6 +462,11 @@ void CohortInputer::getEqchtid5SpFile(int & eqchtid,  const int &recid){
 }
 
 void CohortInputer::getSpchtid5TrFile(int & spchtid,  const int &recid){
+	if (pack!=NULL) {
+		spchtid = pack->getInt("TR/SPCHTID", recid)[0];
+		return;
+	}
+
 	NcError err(NcError::silent_nonfatal);
 
 	NcFile trchtidFile(tridfname.c_str(), NcFile::ReadOnly);
@@ -437,6 +484,11 @@ void CohortInputer::getSpchtid5TrFile(int & spchtid,  const int &recid){
 
 
 void CohortInputer::getTrchtid5ScFile(int & trchtid,  const int &recid){
+	if (pack!=NULL) {
+		trchtid = pack->getInt("SC/TRCHTID", recid)[0];
+		return;
+	}
+
 	NcError err(NcError::silent_nonfatal);
 
 	NcFile scchtidFile(scidfname.c_str(), NcFile::ReadOnly);
@@ -457,6 +509,11 @@ void CohortInputer::getTrchtid5ScFile(int & trchtid,  const int &recid){
 
 void CohortInputer::getSpinupFire(int firedate[MAX_SP_YR], int firemonth[MAX_SP_YR],int fireyear[MAX_SP_YR],int firearea[MAX_SP_YR], const int &recid){
 
+	if (pack!=NULL) {
+		getPackFire("SP", firedate, firemonth, fireyear, firearea, firesp_drv_yr, recid);
+		return;
+	}
+
 
 	int numyr = firesp_drv_yr;
 	NcError err(NcError::silent_nonfatal);
@@ -508,6 +565,11 @@ void CohortInputer::getSpinupFire(int firedate[MAX_SP_YR], int firemonth[MAX_SP_
 
 void CohortInputer::getTransientFire(int firedate[MAX_TR_YR], int firemonth[MAX_TR_YR],int fireyear[MAX_TR_YR],int firearea[MAX_TR_YR], const int &recid){
 
+	if (pack!=NULL) {
+		getPackFire("TR", firedate, firemonth, fireyear, firearea, firetr_drv_yr, recid);
+		return;
+	}
+
 
 	int numyr = firetr_drv_yr;
 	NcError err(NcError::silent_nonfatal);
@@ -560,6 +622,11 @@ void CohortInputer::getTransientFire(int firedate[MAX_TR_YR], int firemonth[MAX_
 
 void CohortInputer::getScenarioFire(int firedate[MAX_SC_YR], int firemonth[MAX_SC_YR],int fireyear[MAX_SC_YR],int firearea[MAX_SC_YR], const int &recid){
 
+	if (pack!=NULL) {
+		getPackFire("SC", firedate, firemonth, fireyear, firearea, firesc_drv_yr, recid);
+		return;
+	}
+
 
 	int numyr = firesc_drv_yr;
 	NcError err(NcError::silent_nonfatal);
@@ -608,6 +675,56 @@ void CohortInputer::getScenarioFire(int firedate[MAX_SC_YR], int firemonth[MAX_S
 	
 }
 
+void CohortInputer::getSpinupFire(vector<FireEvent> & events, const int &recid){
+	if (pack!=NULL) {
+		compactFire(events, pack->getInt("SP/DOB", recid), pack->getInt("SP/MOB", recid),
+				pack->getInt("SP/YOB", recid), pack->getInt("SP/AOB", recid), firesp_drv_yr);
+		return;
+	}
+	getSpinupFire(firebuf[0], firebuf[1], firebuf[2], firebuf[3], recid);
+	compactFire(events, firebuf[0], firebuf[1], firebuf[2], firebuf[3], firesp_drv_yr);
+}
+
+void CohortInputer::getTransientFire(vector<FireEvent> & events, const int &recid){
+	if (pack!=NULL) {
+		compactFire(events, pack->getInt("TR/DOB", recid), pack->getInt("TR/MOB", recid),
+				pack->getInt("TR/YOB", recid), pack->getInt("TR/AOB", recid), firetr_drv_yr);
+		return;
+	}
+	getTransientFire(firebuf[0], firebuf[1], firebuf[2], firebuf[3], recid);
+	compactFire(events, firebuf[0], firebuf[1], firebuf[2], firebuf[3], firetr_drv_yr);
+}
+
+void CohortInputer::getScenarioFire(vector<FireEvent> & events, const int &recid){
+	if (pack!=NULL) {
+		compactFire(events, pack->getInt("SC/DOB", recid), pack->getInt("SC/MOB", recid),
+				pack->getInt("SC/YOB", recid), pack->getInt("SC/AOB", recid), firesc_drv_yr);
+		return;
+	}
+	getScenarioFire(firebuf[0], firebuf[1], firebuf[2], firebuf[3], recid);
+	compactFire(events, firebuf[0], firebuf[1], firebuf[2], firebuf[3], firesc_drv_yr);
+}
+
+static bool fireEarlier(const FireEvent & a, const FireEvent & b){
+	return a.year<b.year;
+}
+
+//keep the years with a fire only; stable, so that the fires of one year stay in file order
+void CohortInputer::compactFire(vector<FireEvent> & events, const int firedate[], const int firemonth[],
+		const int fireyear[], const int firearea[], const int & numyr){
+	events.clear();
+	for (int i=0; i<numyr; i++) {
+		if (fireyear[i]==-1) continue;
+		FireEvent fe;
+		fe.year  = fireyear[i];
+		fe.month = firemonth[i];
+		fe.date  = firedate[i];
+		fe.area  = firearea[i];
+		events.push_back(fe);
+	}
+	stable_sort(events.begin(), events.end(), fireEarlier);
+}
+
 
 /*
 void CohortInputer::getSpinupFireOccur(int spoccur[MAX_SP_FIR_OCR_NUM], const int &recid){
@@ -744,6 +861,12 @@ void CohortInputer::getTransientSeverity(int trsev[MAX_TR_FIR_OCR_NUM], const in
 
 
 void CohortInputer::getChtID(int & chtid,  const int & recid){
+	if (pack!=NULL) {
+		string stg = packStage();
+		chtid = pack->getInt(stg+"/"+stg+"CHTID", recid)[0];
+		return;
+	}
+
 	NcError err(NcError::silent_nonfatal);
 	string idFilename="";
 	string idVarname="";
@@ -776,6 +899,11 @@ void CohortInputer::getChtID(int & chtid,  const int & recid){
 }
 
 void CohortInputer::getClmID(int & clmid,  const int & recid){
+	if (pack!=NULL) {
+		clmid = pack->getInt(packStage()+"/CLMID", recid)[0];
+		return;
+	}
+
 	NcError err(NcError::silent_nonfatal);
 	string idFilename="";
 	if (md->runeq) {
@@ -805,3 +933,72 @@ void CohortInputer::getClmID(int & clmid,  const int & recid){
 void CohortInputer::setModelData(ModelData* mdp){
    md = mdp;
 };
+
+void CohortInputer::setInputPack(InputPack* packp){
+	pack = packp;
+};
+
+//the pack section prefix of the cohortid file used for current run stage (see getChtID())
+string CohortInputer::packStage(){
+	if (md->runeq) return "EQ";
+	if (md->runsp) return "SP";
+	if (md->runtr) return "TR";
+	return "SC";
+};
+
+void CohortInputer::getPackFire(const string & stg, int firedate[], int firemonth[], int fireyear[], int firearea[],
+		const int & numyr, const int &recid){
+	memcpy(firedate, pack->getInt(stg+"/DOB", recid), numyr*sizeof(int));
+	memcpy(firemonth, pack->getInt(stg+"/MOB", recid), numyr*sizeof(int));
+	memcpy(fireyear, pack->getInt(stg+"/YOB", recid), numyr*sizeof(int));
+	memcpy(firearea, pack->getInt(stg+"/AOB", recid), numyr*sizeof(int));
+};
+
+void CohortInputer::packFire(InputPack* packp, const string & stg, string & fname){
+	NcFile fireFile(fname.c_str(), NcFile::ReadOnly);
+	packp->addVar(fireFile, "DOB", stg+"/DOB", PACK_INT);
+	packp->addVar(fireFile, "MOB", stg+"/MOB", PACK_INT);
+	packp->addVar(fireFile, "YOB", stg+"/YOB", PACK_INT);
+	packp->addVar(fireFile, "AOB", stg+"/AOB", PACK_INT);
+};
+
+// same files as init() opens for the run stage(s), which must have been called
+void CohortInputer::packInputs(InputPack* packp){
+	NcError err(NcError::silent_nonfatal);
+	string stg = packStage();
+
+	NcFile eqidFile(eqidfname.c_str(), NcFile::ReadOnly);
+	packp->addVar(eqidFile, "EQCHTID", "EQ/EQCHTID", PACK_INT, true);
+	packp->addVar(eqidFile, "GRDID", "EQ/GRDID", PACK_INT);
+	if (stg=="EQ") packp->addVar(eqidFile, "CLMID", "EQ/CLMID", PACK_INT);
+
+	NcFile vegetationFile(vegidfname.c_str(), NcFile::ReadOnly);
+	packp->addVar(vegetationFile, "VEGID", "EQ/VEGID", PACK_INT);
+	NcFile drainageFile(drgidfname.c_str(), NcFile::ReadOnly);
+	packp->addVar(drainageFile, "DRAINID", "EQ/DRAINID", PACK_INT);
+
+	if (md->runsp || md->runtr || md->runsc) {
+		NcFile spchtidFile(spidfname.c_str(), NcFile::ReadOnly);
+		packp->addVar(spchtidFile, "SPCHTID", "SP/SPCHTID", PACK_INT, true);
+		packp->addVar(spchtidFile, "EQCHTID", "SP/EQCHTID", PACK_INT);
+		if (stg=="SP") packp->addVar(spchtidFile, "CLMID", "SP/CLMID", PACK_INT);
+	}
+	if (md->runsp) packFire(packp, "SP", spffname);
+
+	if (md->runtr || md->runsc) {
+		NcFile trchtidFile(tridfname.c_str(), NcFile::ReadOnly);
+		packp->addVar(trchtidFile, "TRCHTID", "TR/TRCHTID", PACK_INT, true);
+		packp->addVar(trchtidFile, "SPCHTID", "TR/SPCHTID", PACK_INT);
+		if (stg=="TR") packp->addVar(trchtidFile, "CLMID", "TR/CLMID", PACK_INT);
+	}
+	if (md->runtr) packFire(packp, "TR", trffname);
+
+	if (md->runsc) {
+		NcFile scchtidFile(scidfname.c_str(), NcFile::ReadOnly);
+		packp->addVar(scchtidFile, "SCCHTID", "SC/SCCHTID", PACK_INT, true);
+		packp->addVar(scchtidFile, "TRCHTID", "SC/TRCHTID", PACK_INT);
+		if (stg=="SC") packp->addVar(scchtidFile, "CLMID", "SC/CLMID", PACK_INT);
+		packFire(packp, "SC", scffname);
+	}
+
+};
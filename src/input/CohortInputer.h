@@ -16,6 +16,7 @@ using namespace std;
 
 //local header
 #include "../run/ModelData.h"
+#include "../data/CohortData.h"
 
 //from TEMcore.dll
 #include "../util/Exception.h"
@@ -23,6 +24,8 @@ using namespace std;
 #include "../inc/timeconst.h"
 #include "../inc/ErrorCode.h"
 
+#include "InputPack.h"
+
 class CohortInputer{
 	public:
 		CohortInputer();
@@ -56,14 +59,22 @@ class CohortInputer{
 		void getSpinupSeverity(int severity[MAX_SP_FIR_OCR_NUM], const int &spcid);  //Yuan:
 		void getTransientFireOccur(int year[MAX_TR_FIR_OCR_NUM], const int &trcid);
 		void getTransientFireSeason(int season[MAX_TR_FIR_OCR_NUM], const int &trcid);
-		void getTransientSeverity(int severity[MAX_TR_FIR_OCR_NUM], const int &trcid);  //Yuan:
+		void getTransientSeverity(int severity[MAX_TR_FIR_OCR_NUM], const int &trcid);  //Yuan:
 */
 		void getSpinupFire(int firedate[MAX_SP_YR], int firemonth[MAX_SP_YR],int fireyear[MAX_SP_YR],int firearea[MAX_SP_YR], const int &recid);
 		void getTransientFire(int firedate[MAX_TR_YR], int firemonth[MAX_TR_YR],int fireyear[MAX_TR_YR],int firearea[MAX_TR_YR], const int &recid);
 		void getScenarioFire(int firedate[MAX_SC_YR], int firemonth[MAX_SC_YR],int fireyear[MAX_SC_YR],int firearea[MAX_SC_YR], const int &recid);
 
+		//the same, as event lists of the years with a fire (YOB not -1), sorted by year
+		void getSpinupFire(vector<FireEvent> & events, const int &recid);
+		void getTransientFire(vector<FireEvent> & events, const int &recid);
+		void getScenarioFire(vector<FireEvent> & events, const int &recid);
+
 		void setModelData(ModelData* mdp);
 
+		void setInputPack(InputPack* packp);  //if set, all inputs come from the pack instead of netcdf files
+		void packInputs(InputPack* packp);    //write all cohort-level inputs of this run into a pack
+
 	private:
 	 
 		 int useseverity;
@@ -90,6 +101,16 @@ class CohortInputer{
 		 void initScenarioFire(string& dir);
 
 		 ModelData* md;
+		 InputPack* pack;
+
+		 string packStage();
+		 void packFire(InputPack* packp, const string & stg, string & fname);
+		 void getPackFire(const string & stg, int firedate[], int firemonth[], int fireyear[], int firearea[],
+				 const int & numyr, const int &recid);
+
+		 int firebuf[4][MAX_SP_YR];   //dense fire records read from netcdf files, before compacting
+		 void compactFire(vector<FireEvent> & events, const int firedate[], const int firemonth[],
+				 const int fireyear[], const int firearea[], const int & numyr);
 	
 };
 
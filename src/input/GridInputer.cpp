@@ -1,7 +1,7 @@
 #include "GridInputer.h"
 
 GridInputer::GridInputer(){
-	
+	pack = NULL;
 };
 
 GridInputer::~GridInputer(){
@@ -9,7 +9,17 @@ GridInputer::~GridInputer(){
 }
 
 void GridInputer::init(){
-  if(md!=NULL){
+  if(md!=NULL && pack!=NULL){
+	  // all checking done when packing
+	  atm_drv_yr   = pack->getReclen("CLM/TAIR")/12;
+	  fsize_drv_yr = pack->getReclen("FIRE/YEAR");
+	  if (atm_drv_yr>MAX_ATM_DRV_YR || fsize_drv_yr>MAX_FSIZE_DRV_YR) {
+		  string msg = "GridInputer::init - too many years in input pack";
+		  char* msgc = const_cast<char*> (msg.c_str());
+		  throw Exception(msgc,  I_INPACK_INVALID);
+	  }
+
+  } else if(md!=NULL){
 
 	  initLatlon(md->grdinputdir);
 	  initSoil(md->grdinputdir);
@@ -34,6 +44,22 @@ void GridInputer::init(){
 	  initFire(firefile);
 	  initClimate(clmfile);
 
+	  //a window of years at a time, or all years into GridData; the years a run goes through
+	  //are those of the Timer (BEG_TR_YR..END_TR_YR, or BEG_SC_YR..END_SC_YR for the
+	  //scenario file), so any more would never be read
+	  int runyr = (md->runsc && !md->runeq) ? MAX_SC_YR : MAX_TR_YR;
+	  if (md->climatewindow>0 && atm_drv_yr>runyr) {
+		  string msg = "GridInputer::init - more years in "+clmfilename+" than a run goes through";
+		  char* msgc = const_cast<char*> (msg.c_str());
+		  throw Exception(msgc,  I_INPUT_INVALID);
+	  } else if (md->climatewindow>0) {
+		  clmstream.open(clmfilename, atm_drv_yr, md->climatewindow);
+	  } else if (atm_drv_yr>MAX_ATM_DRV_YR) {
+		  string msg = "GridInputer::init - too many years in "+clmfilename;
+		  char* msgc = const_cast<char*> (msg.c_str());
+		  throw Exception(msgc,  I_INPUT_INVALID);
+	  }
+
   }else{
   	string msg = "GridInputer::init - ModelData is NULL";
 		char* msgc = const_cast<char*> (msg.c_str());
@@ -169,6 +195,8 @@ void GridInputer::initClimate(string& dirfile){
 
 //YUAN: recid - the order (from ZERO) in the .nc file, gid - the grid id
 int GridInputer::getGridRecID(const int &gid){
+	if (pack!=NULL) return pack->getRecID("GRD/GRDID", gid);
+
 	//netcdf error
 	NcError err(NcError::silent_nonfatal);
 
@@ -195,6 +223,8 @@ int GridInputer::getGridRecID(const int &gid){
 //            in cohortid.nc file, this id is named as "CLMID"
 // We need to hormonize this name confusion issue in the new version of model
 int GridInputer::getClmRecID(const int &clmid){
+	if (pack!=NULL) return pack->getRecID("CLM/CLMID", clmid);
+
 	//netcdf error
 	NcError err(NcError::silent_nonfatal);
 
@@ -220,6 +250,58 @@ int GridInputer::getClmRecID(const int &clmid){
 
 // read grid-level data (netcdf format) into GridData class
 void GridInputer::getGridData(GridData* gd, const int &grdrecid, const int&clmrecid){
+	PHASE_SCOPE("GridInputer::getGridData");
+
+	getGridSite(gd, grdrecid);
+
+	if (pack!=NULL) {
+	  	gd->act_atm_drv_yr = atm_drv_yr;
+	  	int nclm = atm_drv_yr*12;
+	  	memcpy(&gd->ta[0][0], pack->getFloat("CLM/TAIR", clmrecid), nclm*sizeof(float));
+	  	memcpy(&gd->prec[0][0], pack->getFloat("CLM/PREC", clmrecid), nclm*sizeof(float));
+	  	memcpy(&gd->nirr[0][0], pack->getFloat("CLM/NIRR", clmrecid), nclm*sizeof(float));
+	  	memcpy(&gd->vap[0][0], pack->getFloat("CLM/VAPO", clmrecid), nclm*sizeof(float));
+
+	  	int nfire = fsize_drv_yr*sizeof(int);
+	  	memcpy(gd->fireyear, pack->getInt("FIRE/YEAR", 0), nfire);
+	  	memcpy(gd->firesize, pack->getInt("FIRE/SIZE", 0), nfire);
+	  	memcpy(gd->fireAOB, pack->getInt("FIRE/AOB", 0), nfire);
+	  	memcpy(gd->fireseason, pack->getInt("FIRE/SEASON", 0), nfire);
+	  	memcpy(gd->fireDOB, pack->getInt("FIRE/DOB", 0), nfire);
+
+	  	return;
+	}
+
+  	if (clmstream.isOpen()) {
+  		gd->act_atm_drv_yr = 0;        //none in GridData, read by clmstream as the run goes
+  		clmstream.setRecord(clmrecid);
+  	} else {
+  		gd->act_atm_drv_yr = atm_drv_yr;
+  		getClimate(gd->ta, gd->prec, gd->nirr, gd->vap, clmrecid);
+  	}
+  	getFireSize(gd->fireyear, gd->fireseason, gd->fireDOB, gd->firesize, gd->fireAOB, 0);  //currently ONLY one fire size dataset available
+
+};
+
+// the location, soil and topography of a grid, without its climate and fire data
+void GridInputer::getGridSite(GridData* gd, const int &grdrecid){
+
+	if (pack!=NULL) {
+	  	gd->lat = pack->getFloat("GRD/LAT", grdrecid)[0];
+	  	gd->lon = pack->getFloat("GRD/LON", grdrecid)[0];
+	  	gd->topclay = pack->getInt("GRD/CLAYTOP", grdrecid)[0];
+	  	gd->botclay = pack->getInt("GRD/CLAYBOT", grdrecid)[0];
+	  	gd->topsand = pack->getInt("GRD/SANDTOP", grdrecid)[0];
+	  	gd->botsand = pack->getInt("GRD/SANDBOT", grdrecid)[0];
+	  	gd->topsilt = pack->getInt("GRD/SILTTOP", grdrecid)[0];
+	  	gd->botsilt = pack->getInt("GRD/SILTBOT", grdrecid)[0];
+	  	gd->elevation = pack->getFloat("GRD/ELEV", grdrecid)[0];
+	  	gd->slope = pack->getFloat("GRD/SLOPE", grdrecid)[0];
+	  	gd->aspect = pack->getFloat("GRD/ASP", grdrecid)[0];
+	  	gd->flowacc = pack->getFloat("GRD/FA", grdrecid)[0];
+	  	gd->fri = pack->getInt("GRD/FRI", grdrecid)[0];
+	  	return;
+	}
 
   	gd->lat = getLAT(grdrecid);
   	gd->lon = getLON(grdrecid);
@@ -234,12 +316,8 @@ void GridInputer::getGridData(GridData* gd, const int &grdrecid, const int&clmre
   	gd->slope = getSLOPE(grdrecid);
   	gd->aspect = getASPECT(grdrecid);
   	gd->flowacc = getFLOWACC(grdrecid);
-
-  	gd->act_atm_drv_yr = atm_drv_yr;
-  	getClimate(gd->ta, gd->prec, gd->nirr, gd->vap, clmrecid);
  	gd->fri = getFRI(grdrecid);
 		//cout<<"fri :"<<gd->fri<<"\n";
-  	getFireSize(gd->fireyear, gd->fireseason, gd->fireDOB, gd->firesize, gd->fireAOB, 0);  //currently ONLY one fire size dataset available
 
 };
 
@@ -613,6 +691,63 @@ void GridInputer::setModelData(ModelData* mdp){
 	md = mdp;
 };
 
+void GridInputer::setInputPack(InputPack* packp){
+	pack = packp;
+};
+
+ClimateStream* GridInputer::getClimateStream(){
+	if (!clmstream.isOpen()) return NULL;
+	return &clmstream;
+};
+
+// all netcdf files must have been checked by init()
+void GridInputer::packInputs(InputPack* packp){
+	NcError err(NcError::silent_nonfatal);
+
+	NcFile gridFile(grdfilename.c_str(), NcFile::ReadOnly);
+	packp->addVar(gridFile, "GRDID", "GRD/GRDID", PACK_INT, true);
+	packp->addVar(gridFile, "LAT", "GRD/LAT", PACK_FLOAT);
+	packp->addVar(gridFile, "LON", "GRD/LON", PACK_FLOAT);
+
+	NcFile soilFile(soilfilename.c_str(), NcFile::ReadOnly);
+	packp->addVar(soilFile, "CLAYTOP", "GRD/CLAYTOP", PACK_INT);
+	packp->addVar(soilFile, "CLAYBOT", "GRD/CLAYBOT", PACK_INT);
+	packp->addVar(soilFile, "SANDTOP", "GRD/SANDTOP", PACK_INT);
+	packp->addVar(soilFile, "SANDBOT", "GRD/SANDBOT", PACK_INT);
+	packp->addVar(soilFile, "SILTTOP", "GRD/SILTTOP", PACK_INT);
+	packp->addVar(soilFile, "SILTBOT", "GRD/SILTBOT", PACK_INT);
+
+	NcFile topoFile(topofilename.c_str(), NcFile::ReadOnly);
+	packp->addVar(topoFile, "ELEV", "GRD/ELEV", PACK_FLOAT);
+	packp->addVar(topoFile, "SLOPE", "GRD/SLOPE", PACK_FLOAT);
+	packp->addVar(topoFile, "ASP", "GRD/ASP", PACK_FLOAT);
+	packp->addVar(topoFile, "FA", "GRD/FA", PACK_FLOAT);
+
+	NcFile fireFile(firefilename.c_str(), NcFile::ReadOnly);
+	packp->addVar(fireFile, "FRI", "GRD/FRI", PACK_INT);
+
+	//only ONE fire size dataset (see getGridData), so packed as one record
+	int fyear[MAX_FSIZE_DRV_YR];
+	int fseason[MAX_FSIZE_DRV_YR];
+	int fDOB[MAX_FSIZE_DRV_YR];
+	int fsize[MAX_FSIZE_DRV_YR];
+	int fAOB[MAX_FSIZE_DRV_YR];
+	getFireSize(fyear, fseason, fDOB, fsize, fAOB, 0);
+	packp->addInt("FIRE/YEAR", fyear, 1, fsize_drv_yr);
+	packp->addInt("FIRE/SIZE", fsize, 1, fsize_drv_yr);
+	packp->addInt("FIRE/AOB", fAOB, 1, fsize_drv_yr);
+	packp->addInt("FIRE/SEASON", fseason, 1, fsize_drv_yr);
+	packp->addInt("FIRE/DOB", fDOB, 1, fsize_drv_yr);
+
+	NcFile climateFile(clmfilename.c_str(), NcFile::ReadOnly);
+	packp->addVar(climateFile, "CLMID", "CLM/CLMID", PACK_INT, true);
+	packp->addVar(climateFile, "TAIR", "CLM/TAIR", PACK_FLOAT);
+	packp->addVar(climateFile, "PREC", "CLM/PREC", PACK_FLOAT);
+	packp->addVar(climateFile, "NIRR", "CLM/NIRR", PACK_FLOAT);
+	packp->addVar(climateFile, "VAPO", "CLM/VAPO", PACK_FLOAT);
+
+};
+
 
 
 
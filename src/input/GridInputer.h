@@ -25,8 +25,12 @@ using namespace std;
 #include "../inc/ErrorCode.h"
 #include "../data/GridData.h"
 
+#include "InputPack.h"
+#include "ClimateStream.h"
+
 //local header
 #include "../run/ModelData.h"
+#include "../util/PhaseTimer.h"
 
 class GridInputer{
 	public:
@@ -47,9 +51,14 @@ class GridInputer{
     	int getGridRecID(const int & gid);
     	int getClmRecID(const int & clmid);
 		void getGridData(GridData* gd, const int &grdrecid, const int &clmrecid);  //Yuan: grd's recid may or may not be same as clm's recid
+		void getGridSite(GridData* gd, const int &grdrecid);   //no climate and fire data
 
     	void setModelData(ModelData* mdp);
 
+    	void setInputPack(InputPack* packp);  //if set, all inputs come from the pack instead of netcdf files
+    	void packInputs(InputPack* packp);    //write all grid-level inputs of this run into a pack
+
+    	ClimateStream* getClimateStream();    //NULL unless the climate is read a window at a time
 		
 	private:
 
@@ -101,6 +110,8 @@ class GridInputer{
      	NcVar* botsoilV;
 */
      	ModelData* md;
+     	InputPack* pack;
+     	ClimateStream clmstream;
 
 };
 
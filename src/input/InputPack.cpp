@@ -0,0 +1,274 @@
+#include "InputPack.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+const char PACK_MAGIC[8] = {'D','O','S','T','E','M','I','P'};
+const long PACK_ALIGN = 64;
+
+InputPack::InputPack(){
+	stage   = "";
+	fd      = -1;
+	base    = NULL;
+	mapsize = 0;
+	out     = NULL;
+};
+
+InputPack::~InputPack(){
+	if (out!=NULL) close();
+
+	if (base!=NULL) munmap(base, mapsize);
+	if (fd>=0) ::close(fd);
+};
+
+/////////////////////////////////////////////////////////////////
+// reading
+
+void InputPack::open(const string & packfile, const string & runstage){
+
+	filename = packfile;
+
+	fd = ::open(filename.c_str(), O_RDONLY);
+	struct stat st;
+	if (fd<0 || fstat(fd, &st)!=0 || st.st_size<(long)sizeof(PackHeader)) {
+		string msg = filename+" is not valid";
+		char* msgc = const_cast< char* > ( msg.c_str());
+		throw Exception(msgc, I_INPACK_INVALID);
+	}
+
+	mapsize = st.st_size;
+	void * map = mmap(NULL, mapsize, PROT_READ, MAP_SHARED, fd, 0);
+	if (map==MAP_FAILED) {
+		string msg = "cannot map "+filename+" in InputPack::open";
+		char* msgc = const_cast< char* > ( msg.c_str());
+		throw Exception(msgc, I_INPACK_INVALID);
+	}
+	base = (char*)map;
+
+	const PackHeader * hd = (const PackHeader*)base;
+	if (memcmp(hd->magic, PACK_MAGIC, 8)!=0 || hd->version!=PACK_VERSION
+			|| hd->byteorder!=0x01020304 || hd->sizeoflong!=(int)sizeof(long)
+			|| hd->tableoffset+hd->nsection*(long)sizeof(PackSection)>mapsize) {
+		string msg = filename+" is not an input pack of this version/platform";
+		char* msgc = const_cast< char* > ( msg.c_str());
+		throw Exception(msgc, I_INPACK_INVALID);
+	}
+
+	stage = string(hd->stage, strnlen(hd->stage, sizeof(hd->stage)));
+	if (stage!=runstage) {
+		string msg = filename+" was packed for run stage '"+stage+"', not '"+runstage+"'";
+		char* msgc = const_cast< char* > ( msg.c_str());
+		throw Exception(msgc, I_INPACK_INVALID);
+	}
+
+	const PackSection * sect = (const PackSection*)(base+hd->tableoffset);
+	for (int i=0; i<hd->nsection; i++) {
+		sections[string(sect[i].name, strnlen(sect[i].name, sizeof(sect[i].name)))] = sect[i];
+	}
+
+};
+
+bool InputPack::isOpen(){
+	return base!=NULL;
+};
+
+bool InputPack::has(const string & name){
+	return sections.find(name)!=sections.end();
+};
+
+const PackSection & InputPack::getSection(const string & name, const int & type){
+	map<string, PackSection>::const_iterator it = sections.find(name);
+	if (it==sections.end() || it->second.type!=type) {
+		string msg = "Cannot get "+name+" in "+filename;
+		char* msgc = const_cast< char* > ( msg.c_str());
+		throw Exception(msgc, I_INPACK_NO_SECTION);
+	}
+	return it->second;
+};
+
+int InputPack::getNrec(const string & name){
+	map<string, PackSection>::const_iterator it = sections.find(name);
+	if (it==sections.end()) return 0;
+	return it->second.nrec;
+};
+
+int InputPack::getReclen(const string & name){
+	map<string, PackSection>::const_iterator it = sections.find(name);
+	if (it==sections.end()) return 0;
+	return it->second.reclen;
+};
+
+const char * InputPack::getRecord(const string & name, const int & type, const int & recid){
+	const PackSection & sect = getSection(name, type);
+	if (recid<0 || recid>=sect.nrec) {
+		string msg = "record out of range for "+name+" in "+filename;
+		char* msgc = const_cast< char* > ( msg.c_str());
+		throw Exception(msgc, I_INPACK_RANGE);
+	}
+	return base + sect.offset + (long)recid*sect.reclen*4;
+};
+
+const int * InputPack::getInt(const string & name, const int & recid){
+	return (const int *)getRecord(name, PACK_INT, recid);
+};
+
+const float * InputPack::getFloat(const string & name, const int & recid){
+	return (const float *)getRecord(name, PACK_FLOAT, recid);
+};
+
+//recid - the order (from ZERO) of 'id' in variable 'name', as the netcdf inputers' getXXRecID();
+// the FIRST record if an id is duplicated, and -1 if not exists
+int InputPack::getRecID(const string & name, const int & id){
+	const PackSection & sect = getSection(name+".IDX", PACK_INT);
+	const int * idx = (const int *)(base + sect.offset);
+
+	long lo = 0;
+	long hi = sect.nrec;
+	while (lo<hi) {          // lower bound of id in the sorted (id, recid) pairs
+		long mid = (lo+hi)/2;
+		if (idx[2*mid]<id) {
+			lo = mid+1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	if (lo<sect.nrec && idx[2*lo]==id) return idx[2*lo+1];
+	return -1;
+};
+
+/////////////////////////////////////////////////////////////////
+// writing
+
+void InputPack::create(const string & packfile, const string & runstage){
+
+	filename = packfile;
+	stage    = runstage;
+
+	out = fopen(filename.c_str(), "wb");
+	if (out==NULL) {
+		string msg = "cannot create "+filename;
+		char* msgc = const_cast< char* > ( msg.c_str());
+		throw Exception(msgc, I_INPACK_INVALID);
+	}
+
+	PackHeader hd;                  //placeholder, re-written in close()
+	memset(&hd, 0, sizeof(hd));
+	fwrite(&hd, sizeof(hd), 1, out);
+	table.clear();
+
+};
+
+void InputPack::addSection(const string & name, const int & type, const void * vals,
+		const long & nrec, const int & reclen){
+
+	PackSection sect;
+	memset(&sect, 0, sizeof(sect));
+	strncpy(sect.name, name.c_str(), sizeof(sect.name)-1);
+	sect.type   = type;
+	sect.reclen = reclen;
+	sect.nrec   = nrec;
+
+	long pos = ftell(out);
+	sect.offset = (pos+PACK_ALIGN-1)/PACK_ALIGN*PACK_ALIGN;
+	for (long i=pos; i<sect.offset; i++) fputc(0, out);
+
+	long nval = nrec*reclen;
+	if (nval>0 && (long)fwrite(vals, 4, nval, out)!=nval) {
+		string msg = "problem in writing "+name+" to "+filename;
+		char* msgc = const_cast< char* > ( msg.c_str());
+		throw Exception(msgc, I_INPACK_INVALID);
+	}
+
+	table.push_back(sect);
+
+};
+
+void InputPack::addInt(const string & name, const int * vals, const long & nrec, const int & reclen,
+		const bool & indexed){
+
+	addSection(name, PACK_INT, vals, nrec, reclen);
+
+	if (indexed) {            //only for ID variables, one id per record
+		vector< pair<int, int> > pairs;
+		for (long i=0; i<nrec; i++) pairs.push_back(make_pair(vals[i*reclen], (int)i));
+		sort(pairs.begin(), pairs.end());
+
+		vector<int> idx;
+		for (unsigned int i=0; i<pairs.size(); i++) {
+			idx.push_back(pairs[i].first);
+			idx.push_back(pairs[i].second);
+		}
+		addSection(name+".IDX", PACK_INT, idx.empty() ? NULL : &idx[0], nrec, 2);
+	}
+
+};
+
+void InputPack::addFloat(const string & name, const float * vals, const long & nrec, const int & reclen){
+	addSection(name, PACK_FLOAT, vals, nrec, reclen);
+};
+
+//read in a whole netcdf variable, with the first dimension as the records
+void InputPack::addVar(NcFile & ncfile, const char* varname, const string & name,
+		const int & type, const bool & indexed){
+
+	NcVar* var = ncfile.get_var(varname);
+	if (var==NULL) {
+		string msg = "Cannot get "+string(varname)+" for "+name+" in InputPack::addVar";
+		char* msgc = const_cast< char* > ( msg.c_str());
+		throw Exception(msgc, I_NCVAR_NOT_EXIST);
+	}
+
+	long * edges = var->edges();
+	long nval = var->num_vals();
+	long nrec = (var->num_dims()>0) ? edges[0] : 1;
+	int reclen = (nrec>0) ? nval/nrec : 0;
+
+	NcBool nb = true;
+	if (type==PACK_INT) {
+		vector<int> vals(nval>0 ? nval : 1);
+		if (nval>0) nb = var->get(&vals[0], edges);
+		if (nb) addInt(name, &vals[0], nrec, reclen, indexed);
+	} else {
+		vector<float> vals(nval>0 ? nval : 1);
+		if (nval>0) nb = var->get(&vals[0], edges);
+		if (nb) addFloat(name, &vals[0], nrec, reclen);
+	}
+	delete [] edges;
+
+	if (!nb) {
+		string msg = "problem in reading "+string(varname)+" in InputPack::addVar";
+		char* msgc = const_cast< char* > ( msg.c_str());
+		throw Exception(msgc, I_NCVAR_GET_ERROR);
+	}
+
+};
+
+void InputPack::close(){
+
+	if (out==NULL) return;
+
+	PackHeader hd;
+	memset(&hd, 0, sizeof(hd));
+	memcpy(hd.magic, PACK_MAGIC, 8);
+	hd.version    = PACK_VERSION;
+	hd.byteorder  = 0x01020304;
+	strncpy(hd.stage, stage.c_str(), sizeof(hd.stage)-1);
+	hd.nsection   = table.size();
+	hd.sizeoflong = sizeof(long);
+
+	long pos = ftell(out);
+	hd.tableoffset = (pos+PACK_ALIGN-1)/PACK_ALIGN*PACK_ALIGN;
+	for (long i=pos; i<hd.tableoffset; i++) fputc(0, out);
+	if (!table.empty()) fwrite(&table[0], sizeof(PackSection), table.size(), out);
+
+	fseek(out, 0, SEEK_SET);
+	fwrite(&hd, sizeof(hd), 1, out);
+
+	fclose(out);
+	out = NULL;
+
+};
@@ -0,0 +1,105 @@
+#ifndef INPUTPACK_H_
+#define INPUTPACK_H_
+
+/*! this class is used to pack the netcdf input files of a run into ONE binary file,
+ *  and to serve them back by pointer from a read-only memory map of that file
+ * \file
+ *
+ *  layout (native byte order, checked when opening):
+ *     PackHeader | data sections, each 64-byte aligned | section table (PackSection[nsection])
+ *
+ *  each section is one input variable, stored columnar as [nrec][reclen] int or float values,
+ *  i.e. record 'recid' of a variable is one contiguous block. ID variables also get a
+ *  section "<name>.IDX" of (id, recid) pairs sorted by id, for the record id look-up.
+ *
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+using namespace std;
+
+#include <netcdfcpp.h>
+
+#include "../util/Exception.h"
+#include "../inc/ErrorCode.h"
+
+const int PACK_INT   = 0;
+const int PACK_FLOAT = 1;
+
+const int PACK_VERSION = 1;
+
+struct PackHeader {
+	char magic[8];       // "DOSTEMIP"
+	int version;
+	int byteorder;       // 0x01020304 as written
+	char stage[8];       // ModelData::runstages the pack was made for
+	int nsection;
+	int sizeoflong;
+	long tableoffset;    // bytes from the start of file
+};
+
+struct PackSection {
+	char name[32];
+	int type;            // PACK_INT or PACK_FLOAT
+	int reclen;          // number of values per record
+	long nrec;
+	long offset;         // bytes from the start of file
+};
+
+class InputPack {
+	public:
+		InputPack();
+		~InputPack();
+
+		string stage;
+
+		// reading (model run)
+		void open(const string & filename, const string & runstage);
+		bool isOpen();
+
+		bool has(const string & name);
+		int getNrec(const string & name);
+		int getReclen(const string & name);
+
+		const int * getInt(const string & name, const int & recid);
+		const float * getFloat(const string & name, const int & recid);
+
+		int getRecID(const string & name, const int & id);
+
+		// writing (converter)
+		void create(const string & filename, const string & runstage);
+		void addVar(NcFile & ncfile, const char* varname, const string & name,
+				const int & type, const bool & indexed=false);
+		void addInt(const string & name, const int * vals, const long & nrec, const int & reclen,
+				const bool & indexed=false);
+		void addFloat(const string & name, const float * vals, const long & nrec, const int & reclen);
+		void close();
+
+	private:
+
+		string filename;
+
+		// reading
+		int fd;
+		char * base;
+		long mapsize;
+		map<string, PackSection> sections;
+
+		const PackSection & getSection(const string & name, const int & type);
+		const char * getRecord(const string & name, const int & type, const int & recid);
+
+		// writing
+		FILE * out;
+		vector<PackSection> table;
+
+		void addSection(const string & name, const int & type, const void * vals,
+				const long & nrec, const int & reclen);
+
+};
+
+#endif /*INPUTPACK_H_*/
@@ -1,19 +1,37 @@
 #include "RegionInputer.h"
 
 RegionInputer::RegionInputer(){
-	
+	pack = NULL;
 };
 
 RegionInputer::~RegionInputer(){
 
 }
 
+string RegionInputer::getCO2filename(){
+	string filename = md->reginputdir +"co2.nc";
+	if (md->runsc) filename = md->reginputdir +"co2_sc.nc";  //Yuan: read in CO2 ppm from projection
+	return filename;
+}
+
 void RegionInputer::getCO2(RegionData *rd){
+	if (pack!=NULL) {
+		int yrs = pack->getNrec("REG/CO2");
+		if (yrs>MAX_CO2_DRV_YR) {
+			string msg = "too many CO2 years in input pack";
+			char* msgc = const_cast<char*> (msg.c_str());
+			throw Exception(msgc,  I_INPACK_INVALID);
+		}
+		rd->act_co2_drv_yr = yrs;
+		memcpy(rd->co2year, pack->getInt("REG/YEAR", 0), yrs*sizeof(int));
+		memcpy(rd->co2, pack->getFloat("REG/CO2", 0), yrs*sizeof(float));
+		return;
+	}
+
 	//netcdf error
 	NcError err(NcError::silent_nonfatal);
 
-	string filename = md->reginputdir +"co2.nc";
-	if (md->runsc) filename = md->reginputdir +"co2_sc.nc";  //Yuan: read in CO2 ppm from projection
+	string filename = getCO2filename();
 
 	NcFile co2File(filename.c_str(), NcFile::ReadOnly);
  	if(!co2File.is_valid()){
@@ -55,3 +73,22 @@ void RegionInputer::setModelData(ModelData* mdp){
    	md = mdp;
 };
 
+void RegionInputer::setInputPack(InputPack* packp){
+	pack = packp;
+};
+
+void RegionInputer::packInputs(InputPack* packp){
+	NcError err(NcError::silent_nonfatal);
+
+	string filename = getCO2filename();
+	NcFile co2File(filename.c_str(), NcFile::ReadOnly);
+ 	if(!co2File.is_valid()){
+ 		string msg = filename+" is not valid";
+ 		char* msgc = const_cast< char* > ( msg.c_str());
+ 		throw Exception(msgc, I_NCFILE_NOT_EXIST);
+ 	}
+
+	packp->addVar(co2File, "YEAR", "REG/YEAR", PACK_INT);
+	packp->addVar(co2File, "CO2", "REG/CO2", PACK_FLOAT);
+};
+
@@ -20,6 +20,8 @@ using namespace std;
 
 #include "../run/ModelData.h"
 
+#include "InputPack.h"
+
 class RegionInputer{
 	public:
 		RegionInputer();
@@ -30,9 +32,15 @@ class RegionInputer{
 		void getCO2(RegionData * rd);        //Yuan: modified
 	
 		void setModelData(ModelData* mdp);
+
+		void setInputPack(InputPack* packp);  //if set, CO2 comes from the pack instead of netcdf file
+		void packInputs(InputPack* packp);
 	
 	private:
 		ModelData* md;
+		InputPack* pack;
+
+		string getCO2filename();
 	
 };
 
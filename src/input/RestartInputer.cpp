@@ -1,8 +1,11 @@
 #include "RestartInputer.h"
+#include "../util/Logger.h"
 
 /*! constructor */
  RestartInputer::RestartInputer(){
- 
+ 	restartFile = NULL;
+ 	blocksize = 1;
+ 	block0 = -1;
 };
 
  RestartInputer::~RestartInputer(){
@@ -19,7 +22,7 @@ void RestartInputer::init(string & dirfile){
  	
 //	string filename =outputdir+ "restart.nc";
 	string filename =dirfile;    //Yuan: input file name with dir 
-cout <<"dirfile: " << filename << "\n";
+LOG(LOG_DEBUG) <<"dirfile: " << filename << "\n";
 	restartFile = new NcFile(filename.c_str(), NcFile::ReadOnly);
 	if(!restartFile->is_valid()){
  		string msg = filename+" is not valid";
@@ -433,19 +436,200 @@ cout <<"dirfile: " << filename << "\n";
 int RestartInputer::getRecordId(const int &chtid){
 
 	int chtno = (int)chtD->size();
-	int id;
+	if ((int)chtids.size()!=chtno) {     //the whole CHTID at once, for all later searching
+		readInt(chtidV, "chtid", 0, chtno, 1);
+		chtids = ibuf;
+	}
 	for (int i=0; i<chtno; i++){
-		getChtId(id, i);
-		if (id==chtid) return i;
+		if (chtids[i]==chtid) return i;
 	}
 
 	cout << "cohort "<< chtid<<" NOT exists in RestartInputer\n";	
 	return -1;
 }
 
+void RestartInputer::setBlockSize(const int & nrec){
+	blocksize = (nrec>1) ? nrec : 1;
+	block0 = -1;
+	block.clear();
+	blockerr.clear();
+}
+
+//all restart variables of one record into 'resid', from the block in bulk mode
+void RestartInputer::getRecord(RestartData & resid, const int &cid){
+	if (blocksize>1) {
+		loadBlock(cid);
+		resid = block[cid-block0];
+	} else {
+		int errcode;
+		getBlock(&resid, &errcode, cid, 1);
+	}
+}
+
+//the block of 'blocksize' records starting from 'cid', if 'cid' not in current block
+void RestartInputer::loadBlock(const int &cid){
+	int nrec = (int)block.size();
+	if (block0>=0 && cid>=block0 && cid<block0+nrec) return;
+
+	nrec = (int)chtD->size()-cid;
+	if (nrec>blocksize) nrec = blocksize;
+	if (cid<0 || nrec<=0) {
+	 	string msg = "record out of range in RestartInputer::loadBlock";
+		char* msgc = const_cast<char*> (msg.c_str());
+		throw Exception(msgc,  I_NCVAR_GET_ERROR);
+	}
+
+	block.resize(nrec);
+	blockerr.resize(nrec);
+	getBlock(&block[0], &blockerr[0], cid, nrec);
+	block0 = cid;
+}
+
+//one read per variable for 'nrec' consecutive records starting from 'cid'
+void RestartInputer::getBlock(RestartData resid[], int errcode[], const int &cid, const int &nrec){
+
+	readInt(chtidV, "chtid", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].chtid = ibuf[i];
+	readInt(errcodeV, "errcode", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) errcode[i] = ibuf[i];
+	readInt(permaV, "permafrost", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].perma = ibuf[i];
+	readInt(ysfV, "ysf", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].ysf = ibuf[i];
+
+	readDouble(DZsnowV, "DZsnow", cid, nrec, MAX_SNW_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].DZsnow, &dbuf[i*MAX_SNW_LAY], MAX_SNW_LAY*sizeof(double));
+	readDouble(TSsnowV, "TSsnow", cid, nrec, MAX_SNW_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].TSsnow, &dbuf[i*MAX_SNW_LAY], MAX_SNW_LAY*sizeof(double));
+	readDouble(ICEsnowV, "ICEsnow", cid, nrec, MAX_SNW_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].ICEsnow, &dbuf[i*MAX_SNW_LAY], MAX_SNW_LAY*sizeof(double));
+	readDouble(LIQsnowV, "LIQsnow", cid, nrec, MAX_SNW_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].LIQsnow, &dbuf[i*MAX_SNW_LAY], MAX_SNW_LAY*sizeof(double));
+	readDouble(AGEsnowV, "AGEsnow", cid, nrec, MAX_SNW_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].AGEsnow, &dbuf[i*MAX_SNW_LAY], MAX_SNW_LAY*sizeof(double));
+	readDouble(RHOsnowV, "RHOsnow", cid, nrec, MAX_SNW_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].RHOsnow, &dbuf[i*MAX_SNW_LAY], MAX_SNW_LAY*sizeof(double));
+
+	readDouble(TSsoilV, "TSsoil", cid, nrec, MAX_SOI_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].TSsoil, &dbuf[i*MAX_SOI_LAY], MAX_SOI_LAY*sizeof(double));
+	readDouble(DZsoilV, "DZsoil", cid, nrec, MAX_SOI_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].DZsoil, &dbuf[i*MAX_SOI_LAY], MAX_SOI_LAY*sizeof(double));
+	readDouble(LIQsoilV, "LIQsoil", cid, nrec, MAX_SOI_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].LIQsoil, &dbuf[i*MAX_SOI_LAY], MAX_SOI_LAY*sizeof(double));
+	readDouble(ICEsoilV, "ICEsoil", cid, nrec, MAX_SOI_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].ICEsoil, &dbuf[i*MAX_SOI_LAY], MAX_SOI_LAY*sizeof(double));
+	readInt(FROZENsoilV, "FROZENsoil", cid, nrec, MAX_SOI_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].FROZENsoil, &ibuf[i*MAX_SOI_LAY], MAX_SOI_LAY*sizeof(int));
+	readDouble(NONCsoilV, "NONCsoil", cid, nrec, MAX_SOI_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].NONCsoil, &dbuf[i*MAX_SOI_LAY], MAX_SOI_LAY*sizeof(double));
+	readDouble(REACsoilV, "REACsoil", cid, nrec, MAX_SOI_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].REACsoil, &dbuf[i*MAX_SOI_LAY], MAX_SOI_LAY*sizeof(double));
+	readInt(TYPEsoilV, "TYPEsoil", cid, nrec, MAX_SOI_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].TYPEsoil, &ibuf[i*MAX_SOI_LAY], MAX_SOI_LAY*sizeof(int));
+
+	readInt(CLAYminV, "CLAYmin", cid, nrec, MAX_MIN_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].CLAYmin, &ibuf[i*MAX_MIN_LAY], MAX_MIN_LAY*sizeof(int));
+	readInt(SANDminV, "SANDmin", cid, nrec, MAX_MIN_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].SANDmin, &ibuf[i*MAX_MIN_LAY], MAX_MIN_LAY*sizeof(int));
+	readInt(SILTminV, "SILTmin", cid, nrec, MAX_MIN_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].SILTmin, &ibuf[i*MAX_MIN_LAY], MAX_MIN_LAY*sizeof(int));
+
+	readDouble(DZrockV, "DZrock", cid, nrec, MAX_ROC_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].DZrock, &dbuf[i*MAX_ROC_LAY], MAX_ROC_LAY*sizeof(double));
+	readDouble(TSrockV, "TSrock", cid, nrec, MAX_ROC_LAY);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].TSrock, &dbuf[i*MAX_ROC_LAY], MAX_ROC_LAY*sizeof(double));
+
+	readDouble(frontZV, "frontZ", cid, nrec, MAX_NUM_FNT);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].frontZ, &dbuf[i*MAX_NUM_FNT], MAX_NUM_FNT*sizeof(double));
+	readInt(frontFTV, "frontFT", cid, nrec, MAX_NUM_FNT);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].frontFT, &ibuf[i*MAX_NUM_FNT], MAX_NUM_FNT*sizeof(int));
+
+	readDouble(solnV, "soln", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].soln = dbuf[i];
+	readDouble(avlnV, "avln", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].avln = dbuf[i];
+	readDouble(wdebrisV, "wdebris", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].wdebris = dbuf[i];
+	readDouble(strnV, "strn", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].strn = dbuf[i];
+	readDouble(stonV, "ston", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].ston = dbuf[i];
+	readDouble(vegcV, "vegc", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].vegc = dbuf[i];
+	readDouble(deadcV, "deadc", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].deadc = dbuf[i];
+	readDouble(deadnV, "deadn", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].deadn = dbuf[i];
+
+	readDouble(prveetmxV, "prveetmx", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].prveetmx = dbuf[i];
+	readDouble(prvpetmxV, "prvpetmx", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].prvpetmx = dbuf[i];
+	readDouble(foliagemxV, "foliagemx", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].foliagemx = dbuf[i];
+	readDouble(laiV, "lai", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].lai = dbuf[i];
+	readDouble(unnormleafV, "unnormleaf", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].unnormleaf = dbuf[i];
+	readDouble(prvunnormleafmxV, "prvunnormleafmx", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].prvunnormleafmx = dbuf[i];
+	readDouble(prvtoptV, "prvtopt", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].prvtopt = dbuf[i];
+	readDouble(c2nV, "c2n", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].c2n = dbuf[i];
+
+	readDouble(kdfibV, "kdfib", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].kdfib = dbuf[i];
+	readDouble(kdhumV, "kdhum", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].kdhum = dbuf[i];
+	readDouble(kdminV, "kdmin", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].kdmin = dbuf[i];
+	readDouble(kdslowV, "kdslow", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].kdslow = dbuf[i];
+
+	readDouble(burnednV, "burnedn", cid, nrec, 1);
+	for (int i=0; i<nrec; i++) resid[i].burnedn = dbuf[i];
+
+	readDouble(toptAV, "toptA", cid, nrec, 10);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].toptA, &dbuf[i*10], 10*sizeof(double));
+	readDouble(eetmxAV, "eetmxA", cid, nrec, 10);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].eetmxA, &dbuf[i*10], 10*sizeof(double));
+	readDouble(petmxAV, "petmxA", cid, nrec, 10);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].petmxA, &dbuf[i*10], 10*sizeof(double));
+	readDouble(unnormleafmxAV, "unnormleafmxA", cid, nrec, 10);
+	for (int i=0; i<nrec; i++) memcpy(resid[i].unnormleafmxA, &dbuf[i*10], 10*sizeof(double));
+
+}
+
+void RestartInputer::readDouble(NcVar* var, const char* name, const int &cid, const int &nrec, const int &nlay){
+	dbuf.resize(nrec*nlay);
+	var->set_cur(cid);
+	NcBool nb1 = (nlay>1) ? var->get(&dbuf[0], nrec, nlay) : var->get(&dbuf[0], nrec);
+	if(!nb1){
+	 	string msg = "problem in reading "+string(name)+" in  RestartInputer";
+		char* msgc = const_cast<char*> (msg.c_str());
+		throw Exception(msgc,  I_NCVAR_GET_ERROR);
+	}
+}
+
+void RestartInputer::readInt(NcVar* var, const char* name, const int &cid, const int &nrec, const int &nlay){
+	ibuf.resize(nrec*nlay);
+	var->set_cur(cid);
+	NcBool nb1 = (nlay>1) ? var->get(&ibuf[0], nrec, nlay) : var->get(&ibuf[0], nrec);
+	if(!nb1){
+	 	string msg = "problem in reading "+string(name)+" in  RestartInputer";
+		char* msgc = const_cast<char*> (msg.c_str());
+		throw Exception(msgc,  I_NCVAR_GET_ERROR);
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////
 //Yuan: the cid in the following is actually the record id
 
+int RestartInputer::getNumRecords(){
+	return chtD->size();
+}
+
 void RestartInputer::getChtId(int &chtid, const int &cid){       
 	chtidV->set_cur(cid);
 	NcBool nb1 = chtidV->get(&chtid,1);
@@ -457,6 +641,11 @@ void RestartInputer::getChtId(int &chtid, const int &cid){
 }
 
 void RestartInputer::getERRCODE(int & errcode, const int &cid){       	
+	if (blocksize>1) {
+		loadBlock(cid);
+		errcode = blockerr[cid-block0];
+		return;
+	}
 		
 	errcodeV->set_cur(cid);
 	NcBool nb1 = errcodeV->get(&errcode,1);
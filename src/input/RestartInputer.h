@@ -8,6 +8,8 @@
 #include <sstream>
 #include <ctime>
 #include <cstdlib>
+#include <cstring>
+#include <vector>
 using namespace std;
 #include <string>
 using std::string;
@@ -16,6 +18,7 @@ using std::string;
 #include "../inc/timeconst.h"
 #include "../inc/ErrorCode.h"
 #include "../util/Exception.h"
+#include "../data/RestartData.h"
 
 class RestartInputer {
 	public :
@@ -23,7 +26,11 @@ class RestartInputer {
 		void init(string & dir);
 		~RestartInputer();
 
+		void setBlockSize(const int & nrec);    //bulk mode: read 'nrec' consecutive records per disk access
+
 		int getRecordId(const int &chtid);
+		int getNumRecords();
+		void getRecord(RestartData & resid, const int &cid);  //all variables of one record
 		void getChtId(int & chtid, const int &cid);
 		void getERRCODE(int & errcode, const int &cid);
 		void getPERMAFROST(int & perma, const int &cid);
@@ -92,6 +99,20 @@ class RestartInputer {
 		void getUNNORMLEAFMXA(double SILTmin[], const int &cid);
 
     private:
+		vector<int> chtids;
+
+		int blocksize;
+		int block0;              //first record in block
+		vector<RestartData> block;
+		vector<int> blockerr;
+		vector<double> dbuf;
+		vector<int> ibuf;
+
+		void loadBlock(const int &cid);
+		void getBlock(RestartData resid[], int errcode[], const int &cid, const int &nrec);
+		void readDouble(NcVar* var, const char* name, const int &cid, const int &nrec, const int &nlay);
+		void readInt(NcVar* var, const char* name, const int &cid, const int &nrec, const int &nlay);
+
 		NcFile* restartFile;
 		NcDim * chtD;
 		NcDim * snowlayerD;
@@ -0,0 +1,433 @@
+#include "SyntheticInputs.h"
+
+// the regional output variables, in the order of RegnOutputer/outvarlist.txt
+const int NUM_OUTVAR = 64;
+const char* OUTVARNAMES[NUM_OUTVAR] = {
+	"BURNTHICK", "BURNSOIC", "BURNVEGC", "GROWSTART", "GROWEND", "PERMAFROST", "MOSSDZ", "SHLWDZ",
+	"DEEPDZ", "LAI", "VEGC", "VEGN", "GPP", "NPP", "RH", "LTRFALC",
+	"LTRFALN", "SHLWC", "DEEPC", "MINEC", "ORGN", "AVLN", "NETNMIN", "NUPTAKE",
+	"NINPUT", "NLOST", "EET", "PET", "DRAINAGE", "RUNOFF", "SNOWTHICK", "SWE",
+	"WATERTAB", "ALD", "VWCSHLW", "VWCDEEP", "VWCMINETOP", "VWCMINEBOT", "TSHLW", "TDEEP",
+	"TMINETOP", "TMINEBOT", "HKSHLW", "HKDEEP", "HKMINETOP", "HKMINEBOT", "TCSHLW", "TCDEEP",
+	"TCMINETOP", "TCMINEBOT", "TROCK34M", "SOMCALD", "VWCALD", "TALD", "SNOWSTART", "SNOWEND",
+	"BURNSOILN", "BURNVEGN", "NDEPO", "DEADC", "DEADN", "DWD", "DWDRH", "ORL"};
+
+SyntheticInputs::SyntheticInputs(){
+	numcht = 100;
+	numclm = 10;
+	fri    = 100;
+	seed   = 12345;
+	vegtypes.push_back(4);
+	drgtypes.push_back(0);
+};
+
+SyntheticInputs::~SyntheticInputs(){
+
+};
+
+void SyntheticInputs::write(const string & outdir){
+	dir = outdir;
+	if (dir!="" && dir[dir.size()-1]!='/') dir += "/";
+	rnd = seed;
+
+	if (numcht<1 || numclm<1 || fri<1 || vegtypes.empty() || drgtypes.empty()) {
+		string msg = "SyntheticInputs::write - no cohort, cell, fri, vegetation or drainage type";
+		char* msgc = const_cast<char*> (msg.c_str());
+		throw Exception(msgc, I_INPUT_INVALID);
+	}
+
+	NcError err(NcError::silent_nonfatal);
+
+	makeDir(dir);
+	writeRegion();
+	writeGrid();
+	writeCohorts();
+	writeRuncht();
+	writeConfig();
+};
+
+//linear congruential, the same sequence on all platforms
+double SyntheticInputs::uniform(){
+	rnd = rnd*1103515245u+12345u;
+	return ((rnd>>8) & 0xFFFFFF)/16777216.;
+};
+
+//cells evenly over 60~70N
+float SyntheticInputs::getLat(const int & ic){
+	return 60.+10.*(ic+0.5)/numclm;
+};
+
+int SyntheticInputs::getVegtype(const int & i){
+	return vegtypes[i%vegtypes.size()];
+};
+
+int SyntheticInputs::getDrgtype(const int & i){
+	return drgtypes[(i/vegtypes.size())%drgtypes.size()];
+};
+
+/////////////////////////////////////////////////////////////////
+// region
+
+void SyntheticInputs::writeRegion(){
+	makeDir(dir+"region/");
+	writeCO2(dir+"region/co2.nc", BEG_TR_YR, MAX_CO2_DRV_YR);
+	writeCO2(dir+"region/co2_sc.nc", BEG_SC_YR, MAX_SC_YR);
+};
+
+//observed-like rise to 2009, then about a high-emission projection
+void SyntheticInputs::writeCO2(const string & filename, const int & begyr, const int & numyr){
+	vector<int> year(numyr);
+	vector<float> co2(numyr);
+	for (int iy=0; iy<numyr; iy++) {
+		year[iy] = begyr+iy;
+		float t = year[iy]-BEG_TR_YR;
+		co2[iy] = 296.+0.0077*t*t;
+		float ts = year[iy]-END_TR_YR;
+		if (ts>0) co2[iy] = 387.+2.5*ts+0.012*ts*ts;
+	}
+
+	NcFile * ncfile = create(filename);
+	NcDim* yrD = ncfile->add_dim("YEAR", numyr);
+	NcVar* yrV  = ncfile->add_var("YEAR", ncInt, yrD);
+	NcVar* co2V = ncfile->add_var("CO2", ncFloat, yrD);
+	check(ncfile, yrV!=NULL && co2V!=NULL);
+	check(ncfile, yrV->put(&year[0], numyr) && co2V->put(&co2[0], numyr));
+	ncfile->close();
+	delete ncfile;
+};
+
+/////////////////////////////////////////////////////////////////
+// grid
+
+void SyntheticInputs::writeGrid(){
+	string gdir = dir+"grid/";
+	makeDir(gdir);
+
+	vector<int> grdid(numclm);
+	vector<float> lat(numclm), lon(numclm);
+	vector<int> claytop(numclm), claybot(numclm), sandtop(numclm), sandbot(numclm);
+	vector<int> silttop(numclm), siltbot(numclm);
+	vector<float> elev(numclm), slope(numclm), asp(numclm), fa(numclm);
+	for (int ic=0; ic<numclm; ic++) {
+		grdid[ic] = ic+1;
+		lat[ic]   = getLat(ic);
+		lon[ic]   = -160.+20.*uniform();
+
+		claytop[ic] = 10+(int)(20*uniform());
+		sandtop[ic] = 20+(int)(30*uniform());
+		silttop[ic] = 100-claytop[ic]-sandtop[ic];
+		claybot[ic] = 10+(int)(30*uniform());
+		sandbot[ic] = 20+(int)(30*uniform());
+		siltbot[ic] = 100-claybot[ic]-sandbot[ic];
+
+		elev[ic]  = 100.+800.*uniform();
+		slope[ic] = 10.*uniform();
+		asp[ic]   = 360.*uniform();
+		fa[ic]    = 1.+99.*uniform();
+	}
+
+	NcFile * ncfile = create(gdir+"latlon.nc");
+	NcDim* grdD = ncfile->add_dim("GRDID", numclm);
+	NcVar* grdidV = ncfile->add_var("GRDID", ncInt, grdD);
+	NcVar* latV   = ncfile->add_var("LAT", ncFloat, grdD);
+	NcVar* lonV   = ncfile->add_var("LON", ncFloat, grdD);
+	check(ncfile, grdidV!=NULL && latV!=NULL && lonV!=NULL);
+	check(ncfile, grdidV->put(&grdid[0], numclm) && latV->put(&lat[0], numclm)
+			&& lonV->put(&lon[0], numclm));
+	ncfile->close();
+	delete ncfile;
+
+	ncfile = create(gdir+"soil.nc");
+	grdD = ncfile->add_dim("GRDID", numclm);
+	const char* soilnames[6] = {"CLAYTOP", "CLAYBOT", "SANDTOP", "SANDBOT", "SILTTOP", "SILTBOT"};
+	int* soilvals[6] = {&claytop[0], &claybot[0], &sandtop[0], &sandbot[0], &silttop[0], &siltbot[0]};
+	for (int iv=0; iv<6; iv++) {
+		NcVar* soilV = ncfile->add_var(soilnames[iv], ncInt, grdD);
+		check(ncfile, soilV!=NULL && soilV->put(soilvals[iv], numclm));
+	}
+	ncfile->close();
+	delete ncfile;
+
+	ncfile = create(gdir+"topo.nc");
+	grdD = ncfile->add_dim("GRDID", numclm);
+	const char* toponames[4] = {"ELEV", "SLOPE", "ASP", "FA"};
+	float* topovals[4] = {&elev[0], &slope[0], &asp[0], &fa[0]};
+	for (int iv=0; iv<4; iv++) {
+		NcVar* topoV = ncfile->add_var(toponames[iv], ncFloat, grdD);
+		check(ncfile, topoV!=NULL && topoV->put(topovals[iv], numclm));
+	}
+	ncfile->close();
+	delete ncfile;
+
+	// eq: the normal climate, tr: warming by 1 degC over the century, sc: 3.6 degC more by 2100
+	writeClimate(gdir+"climate.nc", MAX_ATM_NOM_YR, 0., 0.);
+	writeClimate(gdir+"climate_tr.nc", MAX_TR_YR, 0., 0.01);
+	writeClimate(gdir+"climate_sc.nc", MAX_SC_YR, 0.01*MAX_TR_YR, 0.04);
+
+	writeGridFire(gdir+"fire.nc", MAX_FSIZE_DRV_YR);
+	writeGridFire(gdir+"fire_tr.nc", MAX_FSIZE_DRV_YR);
+	writeGridFire(gdir+"fire_sc.nc", MAX_FSIZE_DRV_YR);
+};
+
+// monthly means of a boreal/tundra climate, colder and drier to the north, with
+// year-to-year and month-to-month noise; NIRR is the top-of-atmosphere irradiance
+// at mid-month through 30~90% clouds (as Atmosphere::getCLDS takes it back)
+void SyntheticInputs::writeClimate(const string & filename, const int & numyr, const float & dt0,
+		const float & trend){
+
+	NcFile * ncfile = create(filename);
+	NcDim* clmD = ncfile->add_dim("CLMID", numclm);
+	NcDim* yrD  = ncfile->add_dim("YEAR", numyr);
+	NcDim* monD = ncfile->add_dim("MONTH", 12);
+	NcVar* clmidV = ncfile->add_var("CLMID", ncInt, clmD);
+	NcVar* taV    = ncfile->add_var("TAIR", ncFloat, clmD, yrD, monD);
+	NcVar* precV  = ncfile->add_var("PREC", ncFloat, clmD, yrD, monD);
+	NcVar* nirrV  = ncfile->add_var("NIRR", ncFloat, clmD, yrD, monD);
+	NcVar* vapV   = ncfile->add_var("VAPO", ncFloat, clmD, yrD, monD);
+	check(ncfile, clmidV!=NULL && taV!=NULL && precV!=NULL && nirrV!=NULL && vapV!=NULL);
+
+	const double pi = 3.141592654;
+	vector<float> ta(numyr*12), prec(numyr*12), nirr(numyr*12), vap(numyr*12);
+	for (int ic=0; ic<numclm; ic++) {
+		int clmid = ic+1;
+		clmidV->set_cur(ic);
+		check(ncfile, clmidV->put(&clmid, 1));
+
+		double lat   = getLat(ic);
+		double tmean = -3.-0.7*(lat-60.);
+		double tamp  = 16.+0.6*(lat-60.);
+		double phi   = lat*pi/180.;
+		for (int iy=0; iy<numyr; iy++) {
+			double tyr = tmean+dt0+trend*iy+2.*(uniform()-0.5);
+			for (int im=0; im<12; im++) {
+				int k = iy*12+im;
+				double season = cos(2.*pi*im/12.);     //1 in January, -1 in July
+				ta[k]   = tyr-tamp*season+3.*(uniform()-0.5);
+				prec[k] = (20.+20.*(1.-season))*(0.5+uniform());
+
+				int doy = im*365/12+15;
+				double decl = -23.44*pi/180.*cos(2.*pi*(doy+10)/365.);
+				double cosh0 = -tan(phi)*tan(decl);
+				double h0 = cosh0>=1. ? 0. : (cosh0<=-1. ? pi : acos(cosh0));
+				double girr = 1367./pi*(h0*sin(phi)*sin(decl)+cos(phi)*cos(decl)*sin(h0));
+				double clds = 0.3+0.6*uniform();
+				nirr[k] = max(0., girr)*(0.251+0.509*(1.-clds));
+
+				double svp = 6.112*exp(17.67*ta[k]/(ta[k]+243.5));    //mbar
+				vap[k] = svp*(0.6+0.25*uniform());
+			}
+		}
+
+		taV->set_cur(ic, 0, 0);
+		precV->set_cur(ic, 0, 0);
+		nirrV->set_cur(ic, 0, 0);
+		vapV->set_cur(ic, 0, 0);
+		check(ncfile, taV->put(&ta[0], 1, numyr, 12) && precV->put(&prec[0], 1, numyr, 12)
+				&& nirrV->put(&nirr[0], 1, numyr, 12) && vapV->put(&vap[0], 1, numyr, 12));
+	}
+
+	ncfile->close();
+	delete ncfile;
+};
+
+// FRI of every cell, and ONE fire size data set (GridInputer reads record 0 only)
+void SyntheticInputs::writeGridFire(const string & filename, const int & numyr){
+	vector<int> fris(numclm, fri);
+	vector<int> year(numyr), size(numyr), aob(numyr);
+	vector<int> season(numclm*numyr, 2), dob(numclm*numyr, 190);
+	for (int iy=0; iy<numyr; iy++) {
+		year[iy] = BEG_TR_YR+iy;
+		size[iy] = 1+(int)(4*uniform());
+		aob[iy]  = 50+(int)(2000*uniform());
+	}
+
+	NcFile * ncfile = create(filename);
+	NcDim* grdD = ncfile->add_dim("GRDID", numclm);
+	NcDim* yrD  = ncfile->add_dim("YEAR", numyr);
+	NcVar* friV    = ncfile->add_var("FRI", ncInt, grdD);
+	NcVar* yrV     = ncfile->add_var("YEAR", ncInt, yrD);
+	NcVar* sizeV   = ncfile->add_var("SIZE", ncInt, yrD);
+	NcVar* aobV    = ncfile->add_var("AOB", ncInt, yrD);
+	NcVar* seasonV = ncfile->add_var("SEASON", ncInt, grdD, yrD);
+	NcVar* dobV    = ncfile->add_var("DOB", ncInt, grdD, yrD);
+	check(ncfile, friV!=NULL && yrV!=NULL && sizeV!=NULL && aobV!=NULL && seasonV!=NULL && dobV!=NULL);
+	check(ncfile, friV->put(&fris[0], numclm) && yrV->put(&year[0], numyr)
+			&& sizeV->put(&size[0], numyr) && aobV->put(&aob[0], numyr)
+			&& seasonV->put(&season[0], numclm, numyr) && dobV->put(&dob[0], numclm, numyr));
+	ncfile->close();
+	delete ncfile;
+};
+
+/////////////////////////////////////////////////////////////////
+// cohorts
+
+void SyntheticInputs::writeCohorts(){
+	string edir = dir+"eq/";
+	makeDir(edir);
+
+	vector<int> chtid(numcht), grdid(numcht), vegid(numcht), drainid(numcht);
+	for (int i=0; i<numcht; i++) {
+		chtid[i]   = i+1;
+		grdid[i]   = i%numclm+1;
+		vegid[i]   = getVegtype(i);
+		drainid[i] = getDrgtype(i);
+	}
+
+	NcFile * ncfile = create(edir+"cohortid.nc");
+	NcDim* chtD = ncfile->add_dim("EQCHTID", numcht);
+	NcVar* chtidV = ncfile->add_var("EQCHTID", ncInt, chtD);
+	NcVar* grdidV = ncfile->add_var("GRDID", ncInt, chtD);
+	NcVar* clmidV = ncfile->add_var("CLMID", ncInt, chtD);
+	check(ncfile, chtidV!=NULL && grdidV!=NULL && clmidV!=NULL);
+	check(ncfile, chtidV->put(&chtid[0], numcht) && grdidV->put(&grdid[0], numcht)
+			&& clmidV->put(&grdid[0], numcht));
+	ncfile->close();
+	delete ncfile;
+
+	ncfile = create(edir+"vegetation.nc");
+	chtD = ncfile->add_dim("EQCHTID", numcht);
+	NcVar* vegV = ncfile->add_var("VEGID", ncInt, chtD);
+	check(ncfile, vegV!=NULL && vegV->put(&vegid[0], numcht));
+	ncfile->close();
+	delete ncfile;
+
+	ncfile = create(edir+"drainage.nc");
+	chtD = ncfile->add_dim("EQCHTID", numcht);
+	NcVar* drainV = ncfile->add_var("DRAINID", ncInt, chtD);
+	check(ncfile, drainV!=NULL && drainV->put(&drainid[0], numcht));
+	ncfile->close();
+	delete ncfile;
+
+	writeStageCohorts("sp", "SPCHTID", "EQCHTID");
+	writeStageCohorts("tr", "TRCHTID", "SPCHTID");
+	writeStageCohorts("sc", "SCCHTID", "TRCHTID");
+
+	writeStageFire("sp", "SPCHTID", MAX_SP_FIR_OCR_NUM, BEG_SP_YR);
+	writeStageFire("tr", "TRCHTID", MAX_TR_FIR_OCR_NUM, BEG_TR_YR);
+	writeStageFire("sc", "SCCHTID", MAX_TR_FIR_OCR_NUM, BEG_SC_YR);
+};
+
+// the same ids and record order in all stages, so that a cohort is one column through them
+void SyntheticInputs::writeStageCohorts(const string & stage, const string & chtname, const string & prvname){
+	makeDir(dir+stage+"/");
+
+	vector<int> chtid(numcht), clmid(numcht);
+	for (int i=0; i<numcht; i++) {
+		chtid[i] = i+1;
+		clmid[i] = i%numclm+1;
+	}
+
+	NcFile * ncfile = create(dir+stage+"/cohortid.nc");
+	NcDim* chtD = ncfile->add_dim(chtname.c_str(), numcht);
+	NcVar* chtidV = ncfile->add_var(chtname.c_str(), ncInt, chtD);
+	NcVar* prvidV = ncfile->add_var(prvname.c_str(), ncInt, chtD);
+	NcVar* clmidV = ncfile->add_var("CLMID", ncInt, chtD);
+	check(ncfile, chtidV!=NULL && prvidV!=NULL && clmidV!=NULL);
+	check(ncfile, chtidV->put(&chtid[0], numcht) && prvidV->put(&chtid[0], numcht)
+			&& clmidV->put(&clmid[0], numcht));
+	ncfile->close();
+	delete ncfile;
+};
+
+// one fire per cohort in mid-summer, within the first MAX_FSIZE_DRV_YR years of the stage,
+// since WildFire takes its size from the grid fire data by the stage year
+void SyntheticInputs::writeStageFire(const string & stage, const string & chtname, const int & numyr,
+		const int & begyr){
+	vector<int> dob(numcht*numyr, -1), mob(numcht*numyr, -1), yob(numcht*numyr, -1), aob(numcht*numyr, -1);
+	for (int i=0; i<numcht; i++) {
+		int k = i*numyr;
+		yob[k] = begyr+10+(int)(80*uniform());
+		mob[k] = 6;
+		dob[k] = 170+(int)(40*uniform());
+		aob[k] = 50+(int)(2000*uniform());
+	}
+
+	NcFile * ncfile = create(dir+stage+"/fire.nc");
+	NcDim* chtD = ncfile->add_dim(chtname.c_str(), numcht);
+	NcDim* yrD  = ncfile->add_dim("YEAR", numyr);
+	NcVar* dobV = ncfile->add_var("DOB", ncInt, chtD, yrD);
+	NcVar* mobV = ncfile->add_var("MOB", ncInt, chtD, yrD);
+	NcVar* yobV = ncfile->add_var("YOB", ncInt, chtD, yrD);
+	NcVar* aobV = ncfile->add_var("AOB", ncInt, chtD, yrD);
+	check(ncfile, dobV!=NULL && mobV!=NULL && yobV!=NULL && aobV!=NULL);
+	check(ncfile, dobV->put(&dob[0], numcht, numyr) && mobV->put(&mob[0], numcht, numyr)
+			&& yobV->put(&yob[0], numcht, numyr) && aobV->put(&aob[0], numcht, numyr));
+	ncfile->close();
+	delete ncfile;
+};
+
+void SyntheticInputs::writeRuncht(){
+	vector<int> chtid(numcht);
+	for (int i=0; i<numcht; i++) chtid[i] = i+1;
+
+	NcFile * ncfile = create(dir+"runcht.nc");
+	NcDim* chtD = ncfile->add_dim("CHTID", numcht);
+	NcVar* chtidV = ncfile->add_var("CHTID", ncInt, chtD);
+	check(ncfile, chtidV!=NULL && chtidV->put(&chtid[0], numcht));
+	ncfile->close();
+	delete ncfile;
+};
+
+/////////////////////////////////////////////////////////////////
+// config/, relative to the directory a run starts in (see Regioner and RunCohort::reinit)
+
+void SyntheticInputs::writeConfig(){
+	string cdir = dir+"config/";
+	makeDir(cdir);
+
+	ofstream ofs((cdir+"outvarlist.txt").c_str());
+	ofs <<"synthetic input set: all regional output variables, yearly\n";
+	ofs <<"switch (0 - off, 1 - yearly, 2 - monthly if available)  variable\n";
+	for (int iv=0; iv<NUM_OUTVAR; iv++) {
+		ofs <<"1\t"<<OUTVARNAMES[iv]<<"\n";
+	}
+	ofs.close();
+
+	// the calibrated parameters as the lookup defaults, so that they change nothing
+	CohortLookup chtlu;
+	chtlu.init();
+	for (unsigned int iv=0; iv<vegtypes.size(); iv++) {
+		for (unsigned int id=0; id<drgtypes.size(); id++) {
+			int vt = vegtypes[iv];
+			int dt = drgtypes[id];
+			ostringstream jcalfile;
+			jcalfile <<cdir<<"Jcalinput"<<vt<<dt<<".txt";
+			ofstream ofj(jcalfile.str().c_str());
+			ofj.precision(9);     //floats back exactly
+			ofj <<vt<<" "<<dt<<"\n";
+			ofj <<"0.1 0.2 "<<chtlu.initvegc[dt][vt]<<" "<<chtlu.initstrn[dt][vt]+chtlu.initston[dt][vt]
+				<<" "<<chtlu.initavln[dt][vt]<<" "<<chtlu.initsoln[dt][vt]<<"\n";
+			ofj <<chtlu.cmax[dt][vt]<<" "<<chtlu.nmax[dt][vt]<<" "<<chtlu.krb[dt][vt]<<" "<<chtlu.nup[dt][vt]<<"\n";
+			ofj <<chtlu.cfall[dt][vt]<<" "<<chtlu.nfall[dt][vt]<<"\n";
+			ofj <<chtlu.kdcfib[dt][vt]<<" "<<chtlu.kdchum[dt][vt]<<" "<<chtlu.kdcmin[dt][vt]<<" "
+				<<chtlu.kdcslow[dt][vt]<<"\n";
+			ofj.close();
+		}
+	}
+};
+
+/////////////////////////////////////////////////////////////////
+
+void SyntheticInputs::makeDir(const string & path){
+	mkdir(path.c_str(), 0755);    //may exist
+};
+
+NcFile * SyntheticInputs::create(const string & filename){
+	NcFile * ncfile = new NcFile(filename.c_str(), NcFile::Replace);
+	if (!ncfile->is_valid()) {
+		delete ncfile;
+		string msg = "cannot create "+filename;
+		char* msgc = const_cast<char*> (msg.c_str());
+		throw Exception(msgc, I_NCFILE_NOT_EXIST);
+	}
+	return ncfile;
+};
+
+void SyntheticInputs::check(NcFile * ncfile, const bool & ok){
+	if (ok) return;
+	string msg = "problem in writing a synthetic input file";
+	char* msgc = const_cast<char*> (msg.c_str());
+	ncfile->close();
+	delete ncfile;
+	throw Exception(msgc, I_NCVAR_GET_ERROR);
+};
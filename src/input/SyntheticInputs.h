@@ -0,0 +1,84 @@
+#ifndef SYNTHETICINPUTS_H_
+#define SYNTHETICINPUTS_H_
+
+/*! this class is used to write a synthetic, self-consistent set of regional input files
+ *  (the ones read by RegionInputer, GridInputer, CohortInputer and Regioner), for timing
+ *  and scaling runs without the real climate/fire data sets
+ * \file
+ *
+ *  layout under the directory given (each a directory for the control file):
+ *     region/   co2.nc, co2_sc.nc
+ *     grid/     latlon.nc, soil.nc, topo.nc, climate.nc, climate_tr.nc, climate_sc.nc,
+ *               fire.nc, fire_tr.nc, fire_sc.nc
+ *     eq/       cohortid.nc, vegetation.nc, drainage.nc
+ *     sp/ tr/ sc/  cohortid.nc, fire.nc
+ *     runcht.nc
+ *     config/   outvarlist.txt (all variables on), Jcalinput<veg><drg>.txt (lookup defaults)
+ *
+ *  'numclm' grid cells, each its own climate record (GRDID = CLMID = 1..numclm), carry
+ *  'numcht' cohorts in turn; cohort i (CHTID = i+1 in all stages) is on cell i%numclm.
+ *  All values come from a fixed pseudo-random sequence of 'seed', so a set is reproducible.
+ */
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <algorithm>
+#include <sys/stat.h>
+using namespace std;
+
+#include <netcdfcpp.h>
+
+#include "../util/Exception.h"
+#include "../inc/ErrorCode.h"
+#include "../inc/timeconst.h"
+#include "../inc/cohortconst.h"
+#include "../lookup/CohortLookup.h"
+
+class SyntheticInputs {
+	public:
+		SyntheticInputs();
+		~SyntheticInputs();
+
+		int numcht;
+		int numclm;
+		int fri;                 // fire return interval of all cells (yr); Grid::reinit now fixes it at 2000
+		unsigned int seed;
+		vector<int> vegtypes;    // cohorts take them in turn
+		vector<int> drgtypes;    // ... and these for each round of vegtypes
+
+		void write(const string & dir);
+
+	private:
+
+		string dir;
+		unsigned int rnd;
+
+		double uniform();
+
+		float getLat(const int & ic);
+		int getVegtype(const int & i);
+		int getDrgtype(const int & i);
+
+		void writeRegion();
+		void writeCO2(const string & filename, const int & begyr, const int & numyr);
+		void writeGrid();
+		void writeClimate(const string & filename, const int & numyr, const float & dt0,
+				const float & trend);
+		void writeGridFire(const string & filename, const int & numyr);
+		void writeCohorts();
+		void writeStageCohorts(const string & stage, const string & chtname, const string & prvname);
+		void writeStageFire(const string & stage, const string & chtname, const int & numyr,
+				const int & begyr);
+		void writeRuncht();
+		void writeConfig();
+
+		void makeDir(const string & path);
+		NcFile * create(const string & filename);
+		void check(NcFile * ncfile, const bool & ok);
+
+};
+
+#endif /*SYNTHETICINPUTS_H_*/
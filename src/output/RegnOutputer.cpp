@@ -6,6 +6,10 @@
 
 #include "RegnOutputer.h"
 
+//int16 packing: valid packed values are +/-QNT_SHORT_MAX, QNT_SHORT_FILL for missing or out-of-range data
+const short QNT_SHORT_MAX  = 32766;
+const short QNT_SHORT_FILL = -32767;
+
 RegnOutputer::RegnOutputer(){
 	 
 };
@@ -125,325 +129,327 @@ void RegnOutputer::init(string& outputdir, const int & myid, string & stage, int
 
 		//yearly only
 		if (regnod->outvarlist[0]>=1){
-			burnthickCYV = rFile->add_var("BURNTHICK", ncFloat, chtD, yearD);
+			burnthickCYV = addVar("BURNTHICK", 0, chtD, yearD);
 		}
 		if (regnod->outvarlist[1]>=1){
-			burnsoicCYV = rFile->add_var("BURNSOIC", ncFloat, chtD, yearD);
+			burnsoicCYV = addVar("BURNSOIC", 1, chtD, yearD);
 		}
 		if (regnod->outvarlist[2]>=1){
-			burnvegcCYV = rFile->add_var("BURNVEGC", ncFloat, chtD, yearD);
+			burnvegcCYV = addVar("BURNVEGC", 2, chtD, yearD);
 		}
 		if (regnod->outvarlist[3]>=1){
-			growstartCYV = rFile->add_var("GROWSTART", ncFloat, chtD, yearD);
+			growstartCYV = addVar("GROWSTART", 3, chtD, yearD);
 		}
 		if (regnod->outvarlist[4]>=1){
-			growendCYV   = rFile->add_var("GROWEND", ncFloat, chtD, yearD);
+			growendCYV   = addVar("GROWEND", 4, chtD, yearD);
 		}
 		if (regnod->outvarlist[5]>=1){
-			permCYV = rFile->add_var("PERMAFROST", ncFloat, chtD, yearD);
+			permCYV = addVar("PERMAFROST", 5, chtD, yearD);
 		}
 		if (regnod->outvarlist[6]>=1){
-			mossdzCYV = rFile->add_var("MOSSDZ", ncFloat, chtD, yearD);
+			mossdzCYV = addVar("MOSSDZ", 6, chtD, yearD);
 		}
 		if (regnod->outvarlist[7]>=1){
-			shlwdzCYV = rFile->add_var("SHLWDZ", ncFloat, chtD, yearD);
+			shlwdzCYV = addVar("SHLWDZ", 7, chtD, yearD);
 		}
 		if (regnod->outvarlist[8]>=1){
-			deepdzCYV = rFile->add_var("DEEPDZ", ncFloat, chtD, yearD);
+			deepdzCYV = addVar("DEEPDZ", 8, chtD, yearD);
 		}
 
 		//yearly or monthly
 		if (regnod->outvarlist[9]==1){
-			laiCYV  = rFile->add_var("LAI", ncFloat, chtD, yearD);
+			laiCYV  = addVar("LAI", 9, chtD, yearD);
 		} else if (regnod->outvarlist[9]==2) {
-			laiCYV  = rFile->add_var("LAI", ncFloat, chtD, yearD, monthD);
+			laiCYV  = addVar("LAI", 9, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[10]==1){
-			vegcCYV = rFile->add_var("VEGC", ncFloat, chtD, yearD);
+			vegcCYV = addVar("VEGC", 10, chtD, yearD);
 		} else if (regnod->outvarlist[10]==2) {
-			vegcCYV = rFile->add_var("VEGC", ncFloat, chtD, yearD, monthD);
+			vegcCYV = addVar("VEGC", 10, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[11]==1){
-			vegnCYV = rFile->add_var("VEGN", ncFloat, chtD, yearD);
+			vegnCYV = addVar("VEGN", 11, chtD, yearD);
 		} else if (regnod->outvarlist[11]==2) {
-			vegnCYV = rFile->add_var("VEGN", ncFloat, chtD, yearD, monthD);
+			vegnCYV = addVar("VEGN", 11, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[12]==1){
-			gppCYV = rFile->add_var("GPP", ncFloat, chtD, yearD);
+			gppCYV = addVar("GPP", 12, chtD, yearD);
 		} else if (regnod->outvarlist[12]==2) {
-			gppCYV = rFile->add_var("GPP", ncFloat, chtD, yearD, monthD);
+			gppCYV = addVar("GPP", 12, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[13]==1){
-			nppCYV = rFile->add_var("NPP", ncFloat, chtD, yearD);
+			nppCYV = addVar("NPP", 13, chtD, yearD);
 		} else if (regnod->outvarlist[13]==2) {
-			nppCYV = rFile->add_var("NPP", ncFloat, chtD, yearD, monthD);
+			nppCYV = addVar("NPP", 13, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[14]==1){
-			rhCYV  = rFile->add_var("RH", ncFloat, chtD, yearD);
+			rhCYV  = addVar("RH", 14, chtD, yearD);
 		} else if (regnod->outvarlist[14]==2) {
-			rhCYV  = rFile->add_var("RH", ncFloat, chtD, yearD, monthD);
+			rhCYV  = addVar("RH", 14, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[15]==1){
-			ltrfalcCYV = rFile->add_var("LTRFALC", ncFloat, chtD, yearD);
+			ltrfalcCYV = addVar("LTRFALC", 15, chtD, yearD);
 		} else if (regnod->outvarlist[15]==2) {
-			ltrfalcCYV = rFile->add_var("LTRFALC", ncFloat, chtD, yearD, monthD);
+			ltrfalcCYV = addVar("LTRFALC", 15, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[16]==1){
-			ltrfalnCYV = rFile->add_var("LTRFALN", ncFloat, chtD, yearD);
+			ltrfalnCYV = addVar("LTRFALN", 16, chtD, yearD);
 		} else if (regnod->outvarlist[16]==2) {
-			ltrfalnCYV = rFile->add_var("LTRFALN", ncFloat, chtD, yearD, monthD);
+			ltrfalnCYV = addVar("LTRFALN", 16, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[17]==1){
-			shlwcCYV = rFile->add_var("SHLWC", ncFloat, chtD, yearD);
+			shlwcCYV = addVar("SHLWC", 17, chtD, yearD);
 		} else if (regnod->outvarlist[17]==2) {
-			shlwcCYV = rFile->add_var("SHLWC", ncFloat, chtD, yearD, monthD);
+			shlwcCYV = addVar("SHLWC", 17, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[18]==1){
-			deepcCYV = rFile->add_var("DEEPC", ncFloat, chtD, yearD);
+			deepcCYV = addVar("DEEPC", 18, chtD, yearD);
 		} else if (regnod->outvarlist[18]==2) {
-			deepcCYV = rFile->add_var("DEEPC", ncFloat, chtD, yearD, monthD);
+			deepcCYV = addVar("DEEPC", 18, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[19]==1){
-			minecCYV  = rFile->add_var("MINEC", ncFloat, chtD, yearD);
+			minecCYV  = addVar("MINEC", 19, chtD, yearD);
 		} else if (regnod->outvarlist[19]==2) {
-			minecCYV  = rFile->add_var("MINEC", ncFloat, chtD, yearD, monthD);
+			minecCYV  = addVar("MINEC", 19, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[20]==1){
-			orgnCYV = rFile->add_var("ORGN", ncFloat, chtD, yearD);
+			orgnCYV = addVar("ORGN", 20, chtD, yearD);
 		} else if (regnod->outvarlist[20]==2) {
-			orgnCYV = rFile->add_var("ORGN", ncFloat, chtD, yearD, monthD);
+			orgnCYV = addVar("ORGN", 20, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[21]==1){
-			avlnCYV = rFile->add_var("AVLN", ncFloat, chtD, yearD);
+			avlnCYV = addVar("AVLN", 21, chtD, yearD);
 		} else if (regnod->outvarlist[21]==2) {
-			avlnCYV = rFile->add_var("AVLN", ncFloat, chtD, yearD, monthD);
+			avlnCYV = addVar("AVLN", 21, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[22]==1){
-			netnminCYV = rFile->add_var("NETNMIN", ncFloat, chtD, yearD);
+			netnminCYV = addVar("NETNMIN", 22, chtD, yearD);
 		} else if (regnod->outvarlist[22]==2) {
-			netnminCYV = rFile->add_var("NETNMIN", ncFloat, chtD, yearD, monthD);
+			netnminCYV = addVar("NETNMIN", 22, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[23]==1){
-			nuptakeCYV = rFile->add_var("NUPTAKE", ncFloat, chtD, yearD);
+			nuptakeCYV = addVar("NUPTAKE", 23, chtD, yearD);
 		} else if (regnod->outvarlist[23]==2) {
-			nuptakeCYV = rFile->add_var("NUPTAKE", ncFloat, chtD, yearD, monthD);
+			nuptakeCYV = addVar("NUPTAKE", 23, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[24]==1){
-			ninputCYV = rFile->add_var("NINPUT", ncFloat, chtD, yearD);
+			ninputCYV = addVar("NINPUT", 24, chtD, yearD);
 		} else if (regnod->outvarlist[24]==2) {
-			ninputCYV = rFile->add_var("NINPUT", ncFloat, chtD, yearD, monthD);
+			ninputCYV = addVar("NINPUT", 24, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[25]==1){
-			nlostCYV = rFile->add_var("NLOST", ncFloat, chtD, yearD);
+			nlostCYV = addVar("NLOST", 25, chtD, yearD);
 		} else if (regnod->outvarlist[25]==2) {
-			nlostCYV = rFile->add_var("NLOST", ncFloat, chtD, yearD, monthD);
+			nlostCYV = addVar("NLOST", 25, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[26]==1){
-			eetCYV  = rFile->add_var("EET", ncFloat, chtD, yearD);
+			eetCYV  = addVar("EET", 26, chtD, yearD);
 		} else if (regnod->outvarlist[26]==2) {
-			eetCYV  = rFile->add_var("EET", ncFloat, chtD, yearD, monthD);
+			eetCYV  = addVar("EET", 26, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[27]==1){
-			petCYV  = rFile->add_var("PET", ncFloat, chtD, yearD);
+			petCYV  = addVar("PET", 27, chtD, yearD);
 		} else if (regnod->outvarlist[27]==2) {
-			petCYV  = rFile->add_var("PET", ncFloat, chtD, yearD, monthD);
+			petCYV  = addVar("PET", 27, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[28]==1){
-			qdrainCYV  = rFile->add_var("DRAINAGE", ncFloat, chtD, yearD);
+			qdrainCYV  = addVar("DRAINAGE", 28, chtD, yearD);
 		} else if (regnod->outvarlist[28]==2) {
-			qdrainCYV  = rFile->add_var("DRAINAGE", ncFloat, chtD, yearD, monthD);
+			qdrainCYV  = addVar("DRAINAGE", 28, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[29]==1){
-			qrunoffCYV = rFile->add_var("RUNOFF", ncFloat, chtD, yearD);
+			qrunoffCYV = addVar("RUNOFF", 29, chtD, yearD);
 		} else if (regnod->outvarlist[29]==2) {
-			qrunoffCYV = rFile->add_var("RUNOFF", ncFloat, chtD, yearD, monthD);
+			qrunoffCYV = addVar("RUNOFF", 29, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[30]==1){
-			sthickCYV = rFile->add_var("SNOWTHICK", ncFloat, chtD, yearD);
+			sthickCYV = addVar("SNOWTHICK", 30, chtD, yearD);
 		} else if (regnod->outvarlist[30]==2) {
-			sthickCYV = rFile->add_var("SNOWTHICK", ncFloat, chtD, yearD, monthD);
+			sthickCYV = addVar("SNOWTHICK", 30, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[31]==1){
-			sweCYV    = rFile->add_var("SWE", ncFloat, chtD, yearD);
+			sweCYV    = addVar("SWE", 31, chtD, yearD);
 		} else if (regnod->outvarlist[31]==2) {
-			sweCYV    = rFile->add_var("SWE", ncFloat, chtD, yearD, monthD);
+			sweCYV    = addVar("SWE", 31, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[32]==1){
-			wtdCYV  = rFile->add_var("WATERTAB", ncFloat, chtD, yearD);
+			wtdCYV  = addVar("WATERTAB", 32, chtD, yearD);
 		} else if (regnod->outvarlist[32]==2) {
-			wtdCYV  = rFile->add_var("WATERTAB", ncFloat, chtD, yearD, monthD);
+			wtdCYV  = addVar("WATERTAB", 32, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[33]==1){
-			aldCYV  = rFile->add_var("ALD", ncFloat, chtD, yearD);
+			aldCYV  = addVar("ALD", 33, chtD, yearD);
 		} else if (regnod->outvarlist[33]==2) {
-			aldCYV  = rFile->add_var("ALD", ncFloat, chtD, yearD, monthD);
+			aldCYV  = addVar("ALD", 33, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[34]==1){
-			vwcshlwCYV  = rFile->add_var("VWCSHLW", ncFloat, chtD, yearD);
+			vwcshlwCYV  = addVar("VWCSHLW", 34, chtD, yearD);
 		} else if (regnod->outvarlist[34]==2) {
-			vwcshlwCYV  = rFile->add_var("VWCSHLW", ncFloat, chtD, yearD, monthD);
+			vwcshlwCYV  = addVar("VWCSHLW", 34, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[35]==1){
-			vwcdeepCYV  = rFile->add_var("VWCDEEP", ncFloat, chtD, yearD);
+			vwcdeepCYV  = addVar("VWCDEEP", 35, chtD, yearD);
 		} else if (regnod->outvarlist[35]==2) {
-			vwcdeepCYV  = rFile->add_var("VWCDEEP", ncFloat, chtD, yearD, monthD);
+			vwcdeepCYV  = addVar("VWCDEEP", 35, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[36]==1){
-			vwcminetopCYV = rFile->add_var("VWCMINETOP", ncFloat, chtD, yearD);
+			vwcminetopCYV = addVar("VWCMINETOP", 36, chtD, yearD);
 		} else if (regnod->outvarlist[36]==2) {
-			vwcminetopCYV = rFile->add_var("VWCMINETOP", ncFloat, chtD, yearD, monthD);
+			vwcminetopCYV = addVar("VWCMINETOP", 36, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[37]==1){
-			vwcminebotCYV = rFile->add_var("VWCMINEBOT", ncFloat, chtD, yearD);
+			vwcminebotCYV = addVar("VWCMINEBOT", 37, chtD, yearD);
 		} else if (regnod->outvarlist[37]==2) {
-			vwcminebotCYV = rFile->add_var("VWCMINEBOT", ncFloat, chtD, yearD, monthD);
+			vwcminebotCYV = addVar("VWCMINEBOT", 37, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[38]==1){
-			tshlwCYV  = rFile->add_var("TSHLW", ncFloat, chtD, yearD);
+			tshlwCYV  = addVar("TSHLW", 38, chtD, yearD);
 		} else if (regnod->outvarlist[38]==2) {
-			tshlwCYV  = rFile->add_var("TSHLW", ncFloat, chtD, yearD, monthD);
+			tshlwCYV  = addVar("TSHLW", 38, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[39]==1){
-			tdeepCYV  = rFile->add_var("TDEEP", ncFloat, chtD, yearD);
+			tdeepCYV  = addVar("TDEEP", 39, chtD, yearD);
 		} else if (regnod->outvarlist[39]==2) {
-			tdeepCYV  = rFile->add_var("TDEEP", ncFloat, chtD, yearD, monthD);
+			tdeepCYV  = addVar("TDEEP", 39, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[40]==1){
-			tminetopCYV = rFile->add_var("TMINETOP", ncFloat, chtD, yearD);
+			tminetopCYV = addVar("TMINETOP", 40, chtD, yearD);
 		} else if (regnod->outvarlist[40]==2) {
-			tminetopCYV = rFile->add_var("TMINETOP", ncFloat, chtD, yearD, monthD);
+			tminetopCYV = addVar("TMINETOP", 40, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[41]==1){
-			tminebotCYV = rFile->add_var("TMINEBOT", ncFloat, chtD, yearD);
+			tminebotCYV = addVar("TMINEBOT", 41, chtD, yearD);
 		} else if (regnod->outvarlist[41]==2) {
-			tminebotCYV = rFile->add_var("TMINEBOT", ncFloat, chtD, yearD, monthD);
+			tminebotCYV = addVar("TMINEBOT", 41, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[42]==1){
-			hkshlwCYV  = rFile->add_var("HKSHLW", ncFloat, chtD, yearD);
+			hkshlwCYV  = addVar("HKSHLW", 42, chtD, yearD);
 		} else if (regnod->outvarlist[42]==2) {
-			hkshlwCYV  = rFile->add_var("HKSHLW", ncFloat, chtD, yearD, monthD);
+			hkshlwCYV  = addVar("HKSHLW", 42, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[43]==1){
-			hkdeepCYV  = rFile->add_var("HKDEEP", ncFloat, chtD, yearD);
+			hkdeepCYV  = addVar("HKDEEP", 43, chtD, yearD);
 		} else if (regnod->outvarlist[43]==2) {
-			hkdeepCYV  = rFile->add_var("HKDEEP", ncFloat, chtD, yearD, monthD);
+			hkdeepCYV  = addVar("HKDEEP", 43, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[44]==1){
-			hkminetopCYV = rFile->add_var("HKMINETOP", ncFloat, chtD, yearD);
+			hkminetopCYV = addVar("HKMINETOP", 44, chtD, yearD);
 		} else if (regnod->outvarlist[44]==2) {
-			hkminetopCYV = rFile->add_var("HKMINETOP", ncFloat, chtD, yearD, monthD);
+			hkminetopCYV = addVar("HKMINETOP", 44, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[45]==1){
-			hkminebotCYV = rFile->add_var("HKMINEBOT", ncFloat, chtD, yearD);
+			hkminebotCYV = addVar("HKMINEBOT", 45, chtD, yearD);
 		} else if (regnod->outvarlist[45]==2) {
-			hkminebotCYV = rFile->add_var("HKMINEBOT", ncFloat, chtD, yearD, monthD);
+			hkminebotCYV = addVar("HKMINEBOT", 45, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[46]==1){
-			tcshlwCYV  = rFile->add_var("TCSHLW", ncFloat, chtD, yearD);
+			tcshlwCYV  = addVar("TCSHLW", 46, chtD, yearD);
 		} else if (regnod->outvarlist[46]==2) {
-			tcshlwCYV  = rFile->add_var("TCSHLW", ncFloat, chtD, yearD, monthD);
+			tcshlwCYV  = addVar("TCSHLW", 46, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[47]==1){
-			tcdeepCYV  = rFile->add_var("TCDEEP", ncFloat, chtD, yearD);
+			tcdeepCYV  = addVar("TCDEEP", 47, chtD, yearD);
 		} else if (regnod->outvarlist[47]==2) {
-			tcdeepCYV  = rFile->add_var("TCDEEP", ncFloat, chtD, yearD, monthD);
+			tcdeepCYV  = addVar("TCDEEP", 47, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[48]==1){
-			tcminetopCYV = rFile->add_var("TCMINETOP", ncFloat, chtD, yearD);
+			tcminetopCYV = addVar("TCMINETOP", 48, chtD, yearD);
 		} else if (regnod->outvarlist[48]==2) {
-			tcminetopCYV = rFile->add_var("TCMINETOP", ncFloat, chtD, yearD, monthD);
+			tcminetopCYV = addVar("TCMINETOP", 48, chtD, yearD, monthD);
 		}
 		if (regnod->outvarlist[49]==1){
-			tcminebotCYV = rFile->add_var("TCMINEBOT", ncFloat, chtD, yearD);
+			tcminebotCYV = addVar("TCMINEBOT", 49, chtD, yearD);
 		} else if (regnod->outvarlist[49]==2) {
-			tcminebotCYV = rFile->add_var("TCMINEBOT", ncFloat, chtD, yearD, monthD);
+			tcminebotCYV = addVar("TCMINEBOT", 49, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[50]==1){
-			trock34CYV = rFile->add_var("TROCK34M", ncFloat, chtD, yearD);
+			trock34CYV = addVar("TROCK34M", 50, chtD, yearD);
 		} else if (regnod->outvarlist[50]==2) {
-			trock34CYV = rFile->add_var("TROCK34M", ncFloat, chtD, yearD, monthD);
+			trock34CYV = addVar("TROCK34M", 50, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[51]==1){
-			somcaldCYV = rFile->add_var("SOMCALD", ncFloat, chtD, yearD);
+			somcaldCYV = addVar("SOMCALD", 51, chtD, yearD);
 		} else if (regnod->outvarlist[51]==2) {
-			somcaldCYV = rFile->add_var("SOMCALD", ncFloat, chtD, yearD, monthD);
+			somcaldCYV = addVar("SOMCALD", 51, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[52]==1){
-			vwcaldCYV = rFile->add_var("VWCALD", ncFloat, chtD, yearD);
+			vwcaldCYV = addVar("VWCALD", 52, chtD, yearD);
 		} else if (regnod->outvarlist[52]==2) {
-			vwcaldCYV = rFile->add_var("VWCALD", ncFloat, chtD, yearD, monthD);
+			vwcaldCYV = addVar("VWCALD", 52, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[53]==1){
-			taldCYV = rFile->add_var("TALD", ncFloat, chtD, yearD);
+			taldCYV = addVar("TALD", 53, chtD, yearD);
 		} else if (regnod->outvarlist[53]==2) {
-			taldCYV = rFile->add_var("TALD", ncFloat, chtD, yearD, monthD);
+			taldCYV = addVar("TALD", 53, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[54]>=1){
-			snowstartCYV = rFile->add_var("SNOWSTART", ncFloat, chtD, yearD);
+			snowstartCYV = addVar("SNOWSTART", 54, chtD, yearD);
 		}
 
 		if (regnod->outvarlist[55]>=1){
-			snowendCYV   = rFile->add_var("SNOWEND", ncFloat, chtD, yearD);
+			snowendCYV   = addVar("SNOWEND", 55, chtD, yearD);
 		}
 
 		if (regnod->outvarlist[56]>=1){
-			burnsoilnCYV   = rFile->add_var("BURNSOILN", ncFloat, chtD, yearD);
+			burnsoilnCYV   = addVar("BURNSOILN", 56, chtD, yearD);
 		}
 
 		if (regnod->outvarlist[57]>=1){
-			burnvegnCYV   = rFile->add_var("BURNVEGN", ncFloat, chtD, yearD);
+			burnvegnCYV   = addVar("BURNVEGN", 57, chtD, yearD);
 		}
 
 		if (regnod->outvarlist[58]>=1){
-			ndepoCYV   = rFile->add_var("NDEPO", ncFloat, chtD, yearD);
+			ndepoCYV   = addVar("NDEPO", 58, chtD, yearD);
 		}
 
 		if (regnod->outvarlist[59]==1){
-			deadcCYV = rFile->add_var("DEADC", ncFloat, chtD, yearD);
+			deadcCYV = addVar("DEADC", 59, chtD, yearD);
 		} else if (regnod->outvarlist[59]==2) {
-			deadcCYV = rFile->add_var("DEADC", ncFloat, chtD, yearD, monthD);
+			deadcCYV = addVar("DEADC", 59, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[60]==1){
-			deadnCYV = rFile->add_var("DEADN", ncFloat, chtD, yearD);
+			deadnCYV = addVar("DEADN", 60, chtD, yearD);
 		} else if (regnod->outvarlist[60]==2) {
-			deadnCYV = rFile->add_var("DEADN", ncFloat, chtD, yearD, monthD);
+			deadnCYV = addVar("DEADN", 60, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[61]==1){
-			dwdCYV = rFile->add_var("DWD", ncFloat, chtD, yearD);
+			dwdCYV = addVar("DWD", 61, chtD, yearD);
 		} else if (regnod->outvarlist[61]==2) {
-			dwdCYV = rFile->add_var("DWD", ncFloat, chtD, yearD, monthD);
+			dwdCYV = addVar("DWD", 61, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[62]==1){
-			dwdrhCYV = rFile->add_var("DWDRH", ncFloat, chtD, yearD);
+			dwdrhCYV = addVar("DWDRH", 62, chtD, yearD);
 		} else if (regnod->outvarlist[62]==2) {
-			dwdrhCYV = rFile->add_var("DWDRH", ncFloat, chtD, yearD, monthD);
+			dwdrhCYV = addVar("DWDRH", 62, chtD, yearD, monthD);
 		}
 
 		if (regnod->outvarlist[63]>=1){
-			ORLCYV   = rFile->add_var("ORL", ncFloat, chtD, yearD);
+			ORLCYV   = addVar("ORL", 63, chtD, yearD);
 		}
 
 };
 
 void RegnOutputer::outputYearCohortVars(const int & yrind, const int & chtcount){
+	PHASE_SCOPE("RegnOutputer::outputYearCohortVars");
+	TRACE_SCOPE("RegnOutputer::outputYearCohortVars");
 
    	chtidCYV->set_cur(chtcount);
    	chtidCYV->put(&regnod->chtid,1);
@@ -457,431 +463,431 @@ void RegnOutputer::outputYearCohortVars(const int & yrind, const int & chtcount)
 	//yearly only
 	if (regnod->outvarlist[0]>=1){
 		burnthickCYV->set_cur(chtcount, yrind);
-		burnthickCYV->put(&regnod->burnthick, 1, 1);
+		putVar(burnthickCYV, 0, &regnod->burnthick, 1, 1);
 	}
 	if (regnod->outvarlist[1]>=1){
 		burnsoicCYV->set_cur(chtcount, yrind);
-		burnsoicCYV->put(&regnod->burnsoic, 1, 1);
+		putVar(burnsoicCYV, 1, &regnod->burnsoic, 1, 1);
 	}
 	if (regnod->outvarlist[2]>=1){
 		burnvegcCYV->set_cur(chtcount, yrind);
-		burnvegcCYV->put(&regnod->burnvegc, 1, 1);
+		putVar(burnvegcCYV, 2, &regnod->burnvegc, 1, 1);
 	}
 	if (regnod->outvarlist[3]>=1){
 		growstartCYV->set_cur(chtcount, yrind);
-		growstartCYV->put(&regnod->growstart, 1, 1);
+		putVar(growstartCYV, 3, &regnod->growstart, 1, 1);
 	}
 	if (regnod->outvarlist[4]>=1){
 		growendCYV->set_cur(chtcount, yrind);
-		growendCYV->put(&regnod->growend, 1, 1);
+		putVar(growendCYV, 4, &regnod->growend, 1, 1);
 	}
 	if (regnod->outvarlist[5]>=1){
 		permCYV->set_cur(chtcount, yrind);
-		permCYV->put(&regnod->perm, 1, 1);
+		putVar(permCYV, 5, &regnod->perm, 1, 1);
 	}
 	if (regnod->outvarlist[6]>=1){
 		mossdzCYV->set_cur(chtcount, yrind);
-		mossdzCYV->put(&regnod->mossdz, 1, 1);
+		putVar(mossdzCYV, 6, &regnod->mossdz, 1, 1);
 	}
 	if (regnod->outvarlist[7]>=1){
 		shlwdzCYV->set_cur(chtcount, yrind);
-		shlwdzCYV->put(&regnod->shlwdz, 1, 1);
+		putVar(shlwdzCYV, 7, &regnod->shlwdz, 1, 1);
 	}
 	if (regnod->outvarlist[8]>=1){
 		deepdzCYV->set_cur(chtcount, yrind);
-		deepdzCYV->put(&regnod->deepdz, 1, 1);
+		putVar(deepdzCYV, 8, &regnod->deepdz, 1, 1);
 	}
 
 	//yearly or monthly
 	if (regnod->outvarlist[9]==1){
 	  	laiCYV->set_cur(chtcount, yrind);
-	   	laiCYV->put(&regnod->lai[0], 1, 1);
+	   	putVar(laiCYV, 9, &regnod->lai[0], 1, 1);
 	} else if (regnod->outvarlist[9]==2) {
 	  	laiCYV->set_cur(chtcount, yrind, 0);
-	   	laiCYV->put(&regnod->lai[0], 1, 1, 12);
+	   	putVar(laiCYV, 9, &regnod->lai[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[10]==1){
 		vegcCYV->set_cur(chtcount, yrind);
-	   	vegcCYV->put(&regnod->vegc[0], 1, 1);
+	   	putVar(vegcCYV, 10, &regnod->vegc[0], 1, 1);
 	} else if (regnod->outvarlist[10]==2) {
 		vegcCYV->set_cur(chtcount, yrind, 0);
-	   	vegcCYV->put(&regnod->vegc[0], 1, 1, 12);
+	   	putVar(vegcCYV, 10, &regnod->vegc[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[11]==1){
 		vegnCYV->set_cur(chtcount, yrind);
-	   	vegnCYV->put(&regnod->vegn[0], 1, 1);
+	   	putVar(vegnCYV, 11, &regnod->vegn[0], 1, 1);
 	} else if (regnod->outvarlist[11]==2) {
 		vegnCYV->set_cur(chtcount, yrind, 0);
-	   	vegnCYV->put(&regnod->vegn[0], 1, 1, 12);
+	   	putVar(vegnCYV, 11, &regnod->vegn[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[12]==1){
 		gppCYV->set_cur(chtcount, yrind);
-	   	gppCYV->put(&regnod->gpp[0], 1, 1);
+	   	putVar(gppCYV, 12, &regnod->gpp[0], 1, 1);
 	} else if (regnod->outvarlist[12]==2) {
 		gppCYV->set_cur(chtcount, yrind, 0);
-	   	gppCYV->put(&regnod->gpp[0], 1, 1, 12);
+	   	putVar(gppCYV, 12, &regnod->gpp[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[13]==1){
 		nppCYV->set_cur(chtcount, yrind);
-	   	nppCYV->put(&regnod->npp[0], 1, 1);
+	   	putVar(nppCYV, 13, &regnod->npp[0], 1, 1);
 	} else if (regnod->outvarlist[13]==2) {
 		nppCYV->set_cur(chtcount, yrind, 0);
-	   	nppCYV->put(&regnod->npp[0], 1, 1, 12);
+	   	putVar(nppCYV, 13, &regnod->npp[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[14]==1){
 		rhCYV->set_cur(chtcount, yrind);
-	   	rhCYV->put(&regnod->rh[0], 1, 1);
+	   	putVar(rhCYV, 14, &regnod->rh[0], 1, 1);
 	} else if (regnod->outvarlist[14]==2) {
 		rhCYV->set_cur(chtcount, yrind, 0);
-	   	rhCYV->put(&regnod->rh[0], 1, 1, 12);
+	   	putVar(rhCYV, 14, &regnod->rh[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[15]==1){
 		ltrfalcCYV->set_cur(chtcount, yrind);
-	   	ltrfalcCYV->put(&regnod->ltrfalc[0], 1, 1);
+	   	putVar(ltrfalcCYV, 15, &regnod->ltrfalc[0], 1, 1);
 	} else if (regnod->outvarlist[15]==2) {
 		ltrfalcCYV->set_cur(chtcount, yrind, 0);
-	   	ltrfalcCYV->put(&regnod->ltrfalc[0], 1, 1, 12);
+	   	putVar(ltrfalcCYV, 15, &regnod->ltrfalc[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[16]==1){
 		ltrfalnCYV->set_cur(chtcount, yrind);
-	   	ltrfalnCYV->put(&regnod->ltrfaln[0], 1, 1);
+	   	putVar(ltrfalnCYV, 16, &regnod->ltrfaln[0], 1, 1);
 	} else if (regnod->outvarlist[16]==2) {
 		ltrfalnCYV->set_cur(chtcount, yrind, 0);
-	   	ltrfalnCYV->put(&regnod->ltrfaln[0], 1, 1, 12);
+	   	putVar(ltrfalnCYV, 16, &regnod->ltrfaln[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[17]==1){
 		shlwcCYV->set_cur(chtcount, yrind);
-	   	shlwcCYV->put(&regnod->shlwc[0], 1, 1);
+	   	putVar(shlwcCYV, 17, &regnod->shlwc[0], 1, 1);
 	} else if (regnod->outvarlist[17]==2) {
 		shlwcCYV->set_cur(chtcount, yrind, 0);
-	   	shlwcCYV->put(&regnod->shlwc[0], 1, 1, 12);
+	   	putVar(shlwcCYV, 17, &regnod->shlwc[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[18]==1){
 		deepcCYV->set_cur(chtcount, yrind);
-	   	deepcCYV->put(&regnod->deepc[0], 1, 1);
+	   	putVar(deepcCYV, 18, &regnod->deepc[0], 1, 1);
 	} else if (regnod->outvarlist[18]==2) {
 		deepcCYV->set_cur(chtcount, yrind, 0);
-	   	deepcCYV->put(&regnod->deepc[0], 1, 1, 12);
+	   	putVar(deepcCYV, 18, &regnod->deepc[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[19]==1){
 		minecCYV->set_cur(chtcount, yrind);
-	   	minecCYV->put(&regnod->minec[0], 1, 1);
+	   	putVar(minecCYV, 19, &regnod->minec[0], 1, 1);
 	} else if (regnod->outvarlist[19]==2) {
 		minecCYV->set_cur(chtcount, yrind, 0);
-	   	minecCYV->put(&regnod->minec[0], 1, 1, 12);
+	   	putVar(minecCYV, 19, &regnod->minec[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[20]==1){
 		orgnCYV->set_cur(chtcount, yrind);
-	   	orgnCYV->put(&regnod->orgn[0], 1, 1);
+	   	putVar(orgnCYV, 20, &regnod->orgn[0], 1, 1);
 	} else if (regnod->outvarlist[20]==2) {
 		orgnCYV->set_cur(chtcount, yrind, 0);
-	   	orgnCYV->put(&regnod->orgn[0], 1, 1, 12);
+	   	putVar(orgnCYV, 20, &regnod->orgn[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[21]==1){
 		avlnCYV->set_cur(chtcount, yrind);
-	   	avlnCYV->put(&regnod->avln[0], 1, 1);
+	   	putVar(avlnCYV, 21, &regnod->avln[0], 1, 1);
 	} else if (regnod->outvarlist[21]==2) {
 		avlnCYV->set_cur(chtcount, yrind, 0);
-	   	avlnCYV->put(&regnod->avln[0], 1, 1, 12);
+	   	putVar(avlnCYV, 21, &regnod->avln[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[22]==1){
 		netnminCYV->set_cur(chtcount, yrind);
-	   	netnminCYV->put(&regnod->netnmin[0], 1, 1);
+	   	putVar(netnminCYV, 22, &regnod->netnmin[0], 1, 1);
 	} else if (regnod->outvarlist[22]==2) {
 		netnminCYV->set_cur(chtcount, yrind, 0);
-	   	netnminCYV->put(&regnod->netnmin[0], 1, 1, 12);
+	   	putVar(netnminCYV, 22, &regnod->netnmin[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[23]==1){
 		nuptakeCYV->set_cur(chtcount, yrind);
-	   	nuptakeCYV->put(&regnod->nuptake[0], 1, 1);
+	   	putVar(nuptakeCYV, 23, &regnod->nuptake[0], 1, 1);
 	} else if (regnod->outvarlist[23]==2) {
 		nuptakeCYV->set_cur(chtcount, yrind, 0);
-	   	nuptakeCYV->put(&regnod->nuptake[0], 1, 1, 12);
+	   	putVar(nuptakeCYV, 23, &regnod->nuptake[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[24]==1){
 		ninputCYV->set_cur(chtcount, yrind);
-	   	ninputCYV->put(&regnod->ninput[0], 1, 1);
+	   	putVar(ninputCYV, 24, &regnod->ninput[0], 1, 1);
 	} else if (regnod->outvarlist[24]==2) {
 		ninputCYV->set_cur(chtcount, yrind, 0);
-	   	ninputCYV->put(&regnod->ninput[0], 1, 1, 12);
+	   	putVar(ninputCYV, 24, &regnod->ninput[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[25]==1){
 		nlostCYV->set_cur(chtcount, yrind);
-	   	nlostCYV->put(&regnod->nlost[0], 1, 1);
+	   	putVar(nlostCYV, 25, &regnod->nlost[0], 1, 1);
 	} else if (regnod->outvarlist[25]==2) {
 		nlostCYV->set_cur(chtcount, yrind, 0);
-	   	nlostCYV->put(&regnod->nlost[0], 1, 1, 12);
+	   	putVar(nlostCYV, 25, &regnod->nlost[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[26]==1){
 		eetCYV->set_cur(chtcount, yrind);
-	   	eetCYV->put(&regnod->eet[0], 1, 1);
+	   	putVar(eetCYV, 26, &regnod->eet[0], 1, 1);
 	} else if (regnod->outvarlist[26]==2) {
 		eetCYV->set_cur(chtcount, yrind, 0);
-	   	eetCYV->put(&regnod->eet[0], 1, 1, 12);
+	   	putVar(eetCYV, 26, &regnod->eet[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[27]==1){
 		petCYV->set_cur(chtcount, yrind);
-	   	petCYV->put(&regnod->pet[0], 1, 1);
+	   	putVar(petCYV, 27, &regnod->pet[0], 1, 1);
 	} else if (regnod->outvarlist[27]==2) {
 		petCYV->set_cur(chtcount, yrind, 0);
-	   	petCYV->put(&regnod->pet[0], 1, 1, 12);
+	   	putVar(petCYV, 27, &regnod->pet[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[28]==1){
 		qdrainCYV->set_cur(chtcount, yrind);
-	   	qdrainCYV->put(&regnod->qdrain[0], 1, 1);
+	   	putVar(qdrainCYV, 28, &regnod->qdrain[0], 1, 1);
 	} else if (regnod->outvarlist[28]==2) {
 		qdrainCYV->set_cur(chtcount, yrind, 0);
-	   	qdrainCYV->put(&regnod->qdrain[0], 1, 1, 12);
+	   	putVar(qdrainCYV, 28, &regnod->qdrain[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[29]==1){
 		qrunoffCYV->set_cur(chtcount, yrind);
-	   	qrunoffCYV->put(&regnod->qrunoff[0], 1, 1);
+	   	putVar(qrunoffCYV, 29, &regnod->qrunoff[0], 1, 1);
 	} else if (regnod->outvarlist[29]==2) {
 		qrunoffCYV->set_cur(chtcount, yrind, 0);
-	   	qrunoffCYV->put(&regnod->qrunoff[0], 1, 1, 12);
+	   	putVar(qrunoffCYV, 29, &regnod->qrunoff[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[30]==1){
 		sthickCYV->set_cur(chtcount, yrind);
-	   	sthickCYV->put(&regnod->snowthick[0], 1, 1);
+	   	putVar(sthickCYV, 30, &regnod->snowthick[0], 1, 1);
 	} else if (regnod->outvarlist[30]==2) {
 		sthickCYV->set_cur(chtcount, yrind, 0);
-	   	sthickCYV->put(&regnod->snowthick[0], 1, 1, 12);
+	   	putVar(sthickCYV, 30, &regnod->snowthick[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[31]==1){
 		sweCYV->set_cur(chtcount, yrind);
-	   	sweCYV->put(&regnod->swe[0], 1, 1);
+	   	putVar(sweCYV, 31, &regnod->swe[0], 1, 1);
 	} else if (regnod->outvarlist[31]==2) {
 		sweCYV->set_cur(chtcount, yrind, 0);
-	   	sweCYV->put(&regnod->swe[0], 1, 1, 12);
+	   	putVar(sweCYV, 31, &regnod->swe[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[32]==1){
 		wtdCYV->set_cur(chtcount, yrind);
-	   	wtdCYV->put(&regnod->wtd[0], 1, 1);
+	   	putVar(wtdCYV, 32, &regnod->wtd[0], 1, 1);
 	} else if (regnod->outvarlist[32]==2) {
 		wtdCYV->set_cur(chtcount, yrind, 0);
-	   	wtdCYV->put(&regnod->wtd[0], 1, 1, 12);
+	   	putVar(wtdCYV, 32, &regnod->wtd[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[33]==1){
 		aldCYV->set_cur(chtcount, yrind);
-	   	aldCYV->put(&regnod->ald[0], 1, 1);
+	   	putVar(aldCYV, 33, &regnod->ald[0], 1, 1);
 	} else if (regnod->outvarlist[33]==2) {
 		aldCYV->set_cur(chtcount, yrind, 0);
-	   	aldCYV->put(&regnod->ald[0], 1, 1, 12);
+	   	putVar(aldCYV, 33, &regnod->ald[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[34]==1){
 		vwcshlwCYV->set_cur(chtcount, yrind);
-	   	vwcshlwCYV->put(&regnod->vwcshlw[0], 1, 1);
+	   	putVar(vwcshlwCYV, 34, &regnod->vwcshlw[0], 1, 1);
 	} else if (regnod->outvarlist[34]==2) {
 		vwcshlwCYV->set_cur(chtcount, yrind, 0);
-	   	vwcshlwCYV->put(&regnod->vwcshlw[0], 1, 1, 12);
+	   	putVar(vwcshlwCYV, 34, &regnod->vwcshlw[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[35]==1){
 		vwcdeepCYV->set_cur(chtcount, yrind);
-	   	vwcdeepCYV->put(&regnod->vwcdeep[0], 1, 1);
+	   	putVar(vwcdeepCYV, 35, &regnod->vwcdeep[0], 1, 1);
 	} else if (regnod->outvarlist[35]==2) {
 		vwcdeepCYV->set_cur(chtcount, yrind, 0);
-	   	vwcdeepCYV->put(&regnod->vwcdeep[0], 1, 1, 12);
+	   	putVar(vwcdeepCYV, 35, &regnod->vwcdeep[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[36]==1){
 		vwcminetopCYV->set_cur(chtcount, yrind);
-	   	vwcminetopCYV->put(&regnod->vwcminetop[0], 1, 1);
+	   	putVar(vwcminetopCYV, 36, &regnod->vwcminetop[0], 1, 1);
 	} else if (regnod->outvarlist[36]==2) {
 		vwcminetopCYV->set_cur(chtcount, yrind, 0);
-	   	vwcminetopCYV->put(&regnod->vwcminetop[0], 1, 1, 12);
+	   	putVar(vwcminetopCYV, 36, &regnod->vwcminetop[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[37]==1){
 		vwcminebotCYV->set_cur(chtcount, yrind);
-	   	vwcminebotCYV->put(&regnod->vwcminebot[0], 1, 1);
+	   	putVar(vwcminebotCYV, 37, &regnod->vwcminebot[0], 1, 1);
 	} else if (regnod->outvarlist[37]==2) {
 		vwcminebotCYV->set_cur(chtcount, yrind, 0);
-	   	vwcminebotCYV->put(&regnod->vwcminebot[0], 1, 1, 12);
+	   	putVar(vwcminebotCYV, 37, &regnod->vwcminebot[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[38]==1){
 		tshlwCYV->set_cur(chtcount, yrind);
-	   	tshlwCYV->put(&regnod->tshlw[0], 1, 1);
+	   	putVar(tshlwCYV, 38, &regnod->tshlw[0], 1, 1);
 	} else if (regnod->outvarlist[38]==2) {
 		tshlwCYV->set_cur(chtcount, yrind, 0);
-	   	tshlwCYV->put(&regnod->tshlw[0], 1, 1, 12);
+	   	putVar(tshlwCYV, 38, &regnod->tshlw[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[39]==1){
 		tdeepCYV->set_cur(chtcount, yrind);
-	   	tdeepCYV->put(&regnod->tdeep[0], 1, 1);
+	   	putVar(tdeepCYV, 39, &regnod->tdeep[0], 1, 1);
 	} else if (regnod->outvarlist[39]==2) {
 		tdeepCYV->set_cur(chtcount, yrind, 0);
-	   	tdeepCYV->put(&regnod->tdeep[0], 1, 1, 12);
+	   	putVar(tdeepCYV, 39, &regnod->tdeep[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[40]==1){
 		tminetopCYV->set_cur(chtcount, yrind);
-	   	tminetopCYV->put(&regnod->tminetop[0], 1, 1);
+	   	putVar(tminetopCYV, 40, &regnod->tminetop[0], 1, 1);
 	} else if (regnod->outvarlist[40]==2) {
 		tminetopCYV->set_cur(chtcount, yrind, 0);
-	   	tminetopCYV->put(&regnod->tminetop[0], 1, 1, 12);
+	   	putVar(tminetopCYV, 40, &regnod->tminetop[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[41]==1){
 		tminebotCYV->set_cur(chtcount, yrind);
-	   	tminebotCYV->put(&regnod->tminebot[0], 1, 1);
+	   	putVar(tminebotCYV, 41, &regnod->tminebot[0], 1, 1);
 	} else if (regnod->outvarlist[41]==2) {
 		tminebotCYV->set_cur(chtcount, yrind, 0);
-	   	tminebotCYV->put(&regnod->tminebot[0], 1, 1, 12);
+	   	putVar(tminebotCYV, 41, &regnod->tminebot[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[42]==1){
 		hkshlwCYV->set_cur(chtcount, yrind);
-	   	hkshlwCYV->put(&regnod->hkshlw[0], 1, 1);
+	   	putVar(hkshlwCYV, 42, &regnod->hkshlw[0], 1, 1);
 	} else if (regnod->outvarlist[42]==2) {
 		hkshlwCYV->set_cur(chtcount, yrind, 0);
-	   	hkshlwCYV->put(&regnod->hkshlw[0], 1, 1, 12);
+	   	putVar(hkshlwCYV, 42, &regnod->hkshlw[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[43]==1){
 		hkdeepCYV->set_cur(chtcount, yrind);
-	   	hkdeepCYV->put(&regnod->hkdeep[0], 1, 1);
+	   	putVar(hkdeepCYV, 43, &regnod->hkdeep[0], 1, 1);
 	} else if (regnod->outvarlist[43]==2) {
 		hkdeepCYV->set_cur(chtcount, yrind, 0);
-	   	hkdeepCYV->put(&regnod->hkdeep[0], 1, 1, 12);
+	   	putVar(hkdeepCYV, 43, &regnod->hkdeep[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[44]==1){
 		hkminetopCYV->set_cur(chtcount, yrind);
-	   	hkminetopCYV->put(&regnod->hkminetop[0], 1, 1);
+	   	putVar(hkminetopCYV, 44, &regnod->hkminetop[0], 1, 1);
 	} else if (regnod->outvarlist[44]==2) {
 		hkminetopCYV->set_cur(chtcount, yrind, 0);
-	   	hkminetopCYV->put(&regnod->hkminetop[0], 1, 1, 12);
+	   	putVar(hkminetopCYV, 44, &regnod->hkminetop[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[45]==1){
 		hkminebotCYV->set_cur(chtcount, yrind);
-	   	hkminebotCYV->put(&regnod->hkminebot[0], 1, 1);
+	   	putVar(hkminebotCYV, 45, &regnod->hkminebot[0], 1, 1);
 	} else if (regnod->outvarlist[45]==2) {
 		hkminebotCYV->set_cur(chtcount, yrind, 0);
-	   	hkminebotCYV->put(&regnod->hkminebot[0], 1, 1, 12);
+	   	putVar(hkminebotCYV, 45, &regnod->hkminebot[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[46]==1){
 		tcshlwCYV->set_cur(chtcount, yrind);
-	   	tcshlwCYV->put(&regnod->tcshlw[0], 1, 1);
+	   	putVar(tcshlwCYV, 46, &regnod->tcshlw[0], 1, 1);
 	} else if (regnod->outvarlist[46]==2) {
 		tcshlwCYV->set_cur(chtcount, yrind, 0);
-	   	tcshlwCYV->put(&regnod->tcshlw[0], 1, 1, 12);
+	   	putVar(tcshlwCYV, 46, &regnod->tcshlw[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[47]==1){
 		tcdeepCYV->set_cur(chtcount, yrind);
-	   	tcdeepCYV->put(&regnod->tcdeep[0], 1, 1);
+	   	putVar(tcdeepCYV, 47, &regnod->tcdeep[0], 1, 1);
 	} else if (regnod->outvarlist[47]==2) {
 		tcdeepCYV->set_cur(chtcount, yrind, 0);
-	   	tcdeepCYV->put(&regnod->tcdeep[0], 1, 1, 12);
+	   	putVar(tcdeepCYV, 47, &regnod->tcdeep[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[48]==1){
 		tcminetopCYV->set_cur(chtcount, yrind);
-	   	tcminetopCYV->put(&regnod->tcminetop[0], 1, 1);
+	   	putVar(tcminetopCYV, 48, &regnod->tcminetop[0], 1, 1);
 	} else if (regnod->outvarlist[48]==2) {
 		tcminetopCYV->set_cur(chtcount, yrind, 0);
-	   	tcminetopCYV->put(&regnod->tcminetop[0], 1, 1, 12);
+	   	putVar(tcminetopCYV, 48, &regnod->tcminetop[0], 1, 1, 12);
 	}
 	if (regnod->outvarlist[49]==1){
 		tcminebotCYV->set_cur(chtcount, yrind);
-	   	tcminebotCYV->put(&regnod->tcminebot[0], 1, 1);
+	   	putVar(tcminebotCYV, 49, &regnod->tcminebot[0], 1, 1);
 	} else if (regnod->outvarlist[49]==2) {
 		tcminebotCYV->set_cur(chtcount, yrind, 0);
-	   	tcminebotCYV->put(&regnod->tcminebot[0], 1, 1, 12);
+	   	putVar(tcminebotCYV, 49, &regnod->tcminebot[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[50]==1){
 		trock34CYV->set_cur(chtcount, yrind);
-	   	trock34CYV->put(&regnod->trock34[0], 1, 1);
+	   	putVar(trock34CYV, 50, &regnod->trock34[0], 1, 1);
 	} else if (regnod->outvarlist[50]==2) {
 		trock34CYV->set_cur(chtcount, yrind, 0);
-	   	trock34CYV->put(&regnod->trock34[0], 1, 1, 12);
+	   	putVar(trock34CYV, 50, &regnod->trock34[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[51]==1){
 		somcaldCYV->set_cur(chtcount, yrind);
-	   	somcaldCYV->put(&regnod->somcald[0], 1, 1);
+	   	putVar(somcaldCYV, 51, &regnod->somcald[0], 1, 1);
 	} else if (regnod->outvarlist[51]==2) {
 		somcaldCYV->set_cur(chtcount, yrind, 0);
-	   	somcaldCYV->put(&regnod->somcald[0], 1, 1, 12);
+	   	putVar(somcaldCYV, 51, &regnod->somcald[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[52]==1){
 		vwcaldCYV->set_cur(chtcount, yrind);
-	   	vwcaldCYV->put(&regnod->vwcald[0], 1, 1);
+	   	putVar(vwcaldCYV, 52, &regnod->vwcald[0], 1, 1);
 	} else if (regnod->outvarlist[52]==2) {
 		vwcaldCYV->set_cur(chtcount, yrind, 0);
-	   	vwcaldCYV->put(&regnod->vwcald[0], 1, 1, 12);
+	   	putVar(vwcaldCYV, 52, &regnod->vwcald[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[53]==1){
 		taldCYV->set_cur(chtcount, yrind);
-	   	taldCYV->put(&regnod->tald[0], 1, 1);
+	   	putVar(taldCYV, 53, &regnod->tald[0], 1, 1);
 	} else if (regnod->outvarlist[53]==2) {
 		taldCYV->set_cur(chtcount, yrind, 0);
-	   	taldCYV->put(&regnod->tald[0], 1, 1, 12);
+	   	putVar(taldCYV, 53, &regnod->tald[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[54]>=1){
 		snowstartCYV->set_cur(chtcount, yrind);
-		snowstartCYV->put(&regnod->snowstart, 1, 1);
+		putVar(snowstartCYV, 54, &regnod->snowstart, 1, 1);
 	}
 	if (regnod->outvarlist[55]>=1){
 		snowendCYV->set_cur(chtcount, yrind);
-		snowendCYV->put(&regnod->snowend, 1, 1);
+		putVar(snowendCYV, 55, &regnod->snowend, 1, 1);
 	}
 
 	if (regnod->outvarlist[56]>=1){
 		burnsoilnCYV->set_cur(chtcount, yrind);
-		burnsoilnCYV->put(&regnod->burnsoiln, 1, 1);
+		putVar(burnsoilnCYV, 56, &regnod->burnsoiln, 1, 1);
 	}
 
 	if (regnod->outvarlist[57]>=1){
 		burnvegnCYV->set_cur(chtcount, yrind);
-		burnvegnCYV->put(&regnod->burnvegn, 1, 1);
+		putVar(burnvegnCYV, 57, &regnod->burnvegn, 1, 1);
 	}
 
 	if (regnod->outvarlist[58]>=1){
 		ndepoCYV->set_cur(chtcount, yrind);
-		ndepoCYV->put(&regnod->ndepo, 1, 1);
+		putVar(ndepoCYV, 58, &regnod->ndepo, 1, 1);
 	}
 
 	if (regnod->outvarlist[59]==1){
 		deadcCYV->set_cur(chtcount, yrind);
-	   	deadcCYV->put(&regnod->deadc[0], 1, 1);
+	   	putVar(deadcCYV, 59, &regnod->deadc[0], 1, 1);
 	} else if (regnod->outvarlist[59]==2) {
 		deadcCYV->set_cur(chtcount, yrind, 0);
-	   	deadcCYV->put(&regnod->deadc[0], 1, 1, 12);
+	   	putVar(deadcCYV, 59, &regnod->deadc[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[60]==1){
 		deadnCYV->set_cur(chtcount, yrind);
-	   	deadnCYV->put(&regnod->deadn[0], 1, 1);
+	   	putVar(deadnCYV, 60, &regnod->deadn[0], 1, 1);
 	} else if (regnod->outvarlist[60]==2) {
 		deadnCYV->set_cur(chtcount, yrind, 0);
-	   	deadnCYV->put(&regnod->deadn[0], 1, 1, 12);
+	   	putVar(deadnCYV, 60, &regnod->deadn[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[61]==1){
 		dwdCYV->set_cur(chtcount, yrind);
-	   	dwdCYV->put(&regnod->dwd[0], 1, 1);
+	   	putVar(dwdCYV, 61, &regnod->dwd[0], 1, 1);
 	} else if (regnod->outvarlist[61]==2) {
 		dwdCYV->set_cur(chtcount, yrind, 0);
-	   	dwdCYV->put(&regnod->dwd[0], 1, 1, 12);
+	   	putVar(dwdCYV, 61, &regnod->dwd[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[62]==1){
 		dwdrhCYV->set_cur(chtcount, yrind);
-	   	dwdrhCYV->put(&regnod->dwdrh[0], 1, 1);
+	   	putVar(dwdrhCYV, 62, &regnod->dwdrh[0], 1, 1);
 	} else if (regnod->outvarlist[62]==2) {
 		dwdrhCYV->set_cur(chtcount, yrind, 0);
-	   	dwdrhCYV->put(&regnod->dwdrh[0], 1, 1, 12);
+	   	putVar(dwdrhCYV, 62, &regnod->dwdrh[0], 1, 1, 12);
 	}
 
 	if (regnod->outvarlist[63]>=1){
 		ORLCYV->set_cur(chtcount, yrind);
-		ORLCYV->put(&regnod->ORL, 1, 1);
+		putVar(ORLCYV, 63, &regnod->ORL, 1, 1);
 	}
 
 
@@ -890,3 +896,94 @@ void RegnOutputer::outputYearCohortVars(const int & yrind, const int & chtcount)
 void RegnOutputer::setOutData(RegnOutData *regnodp) {
 	regnod = regnodp;
 };
+
+/*! define an output variable, as float or, if quantized, as packed int16 with
+ *  its scale_factor/add_offset and the quantization error bound as attributes */
+NcVar* RegnOutputer::addVar(const char* name, const int & ivar, NcDim* dim0, NcDim* dim1, NcDim* dim2){
+
+	NcVar* var = NULL;
+	qntscale[ivar]  = 1.;
+	qntoffset[ivar] = 0.;
+	qntmask[ivar]   = 0xFFFFFFFFu;
+
+	if (regnod->outvarqnt[ivar]==1){
+		var = rFile->add_var(name, ncShort, dim0, dim1, dim2);
+
+		qntscale[ivar]  = (regnod->outvarqmax[ivar]-regnod->outvarqmin[ivar])/(2.*QNT_SHORT_MAX);
+		qntoffset[ivar] = (regnod->outvarqmax[ivar]+regnod->outvarqmin[ivar])/2.;
+
+		var->add_att("scale_factor", qntscale[ivar]);
+		var->add_att("add_offset", qntoffset[ivar]);
+		var->add_att("_FillValue", QNT_SHORT_FILL);
+		var->add_att("valid_min", (short)(-QNT_SHORT_MAX));
+		var->add_att("valid_max", QNT_SHORT_MAX);
+		var->add_att("quantization", "linear_int16");
+		var->add_att("quantization_max_abs_error", (float)(0.5*qntscale[ivar]));
+
+	} else {
+		var = rFile->add_var(name, ncFloat, dim0, dim1, dim2);
+
+		if (regnod->outvarqnt[ivar]==2){
+			//Zender (2016): keep ceil(nsd*log2(10))+1 explicit mantissa bits of a float (23 bits)
+			int keepbits = (int)ceil(regnod->outvarqnsd[ivar]*log(10.)/log(2.))+1;
+			if (keepbits<23) {
+				qntmask[ivar] = 0xFFFFFFFFu << (23-keepbits);
+			} else {
+				keepbits = 23;
+			}
+
+			//rounded to nearest: within half a unit of the last bit kept
+			var->add_att("quantization", "bitround");
+			var->add_att("quantization_nsd", regnod->outvarqnsd[ivar]);
+			var->add_att("quantization_max_rel_error", (float)pow(2., -(keepbits+1)));
+		}
+	}
+
+	return var;
+};
+
+/*! write one cohort-year (or cohort-year-month) slab of a variable, quantized if required */
+void RegnOutputer::putVar(NcVar* var, const int & ivar, const float * vals,
+		const long & c0, const long & c1, const long & c2){
+
+	int nval = (c2>0) ? c2 : 1;
+
+	if (regnod->outvarqnt[ivar]==1){
+		short packed[12];
+		for (int i=0; i<nval; i++){
+			float val = vals[i];
+			if (val==-999 || val!=val || val<regnod->outvarqmin[ivar] || val>regnod->outvarqmax[ivar]){
+				packed[i] = QNT_SHORT_FILL;
+			} else {
+				double pval = floor((val-qntoffset[ivar])/qntscale[ivar]+0.5);
+				if (pval> QNT_SHORT_MAX) pval = QNT_SHORT_MAX;
+				if (pval<-QNT_SHORT_MAX) pval =-QNT_SHORT_MAX;
+				packed[i] = (short)pval;
+			}
+		}
+		var->put(&packed[0], c0, c1, c2);
+
+	} else if (regnod->outvarqnt[ivar]==2){
+		//bit-rounding: round the mantissa to the bits kept (to nearest, ties to even), so that
+		// the rounding errors do not bias the mean; the zeroed trailing bits then compress well
+		// (e.g. nccopy -d)
+		float rounded[12];
+		unsigned int drop = ~qntmask[ivar];
+		for (int i=0; i<nval; i++){
+			rounded[i] = vals[i];
+			if (drop==0 || vals[i]==-999 || vals[i]==0. || vals[i]!=vals[i]) continue;
+
+			unsigned int bits;
+			memcpy(&bits, &rounded[i], sizeof(bits));
+			unsigned int rbits = bits+(drop>>1)+((bits&(drop+1))!=0 ? 1 : 0);
+			rbits &= qntmask[ivar];
+			if ((rbits&0x7F800000u)==0x7F800000u) rbits = bits&qntmask[ivar];   //not rounded up to inf
+			memcpy(&rounded[i], &rbits, sizeof(rbits));
+		}
+		var->put(&rounded[0], c0, c1, c2);
+
+	} else {
+		var->put(vals, c0, c1, c2);
+	}
+
+};
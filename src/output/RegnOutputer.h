@@ -10,9 +10,13 @@
 
 #include <iostream>
 #include <string>
+#include <cmath>
+#include <cstring>
 using namespace std;
 
 #include "../run/RegnOutData.h"
+#include "../util/PhaseTimer.h"
+#include "../util/TraceRecorder.h"
 
 class RegnOutputer{
 	
@@ -120,6 +124,17 @@ class RegnOutputer{
       	NcVar* taldCYV;
 
    		RegnOutData *regnod;
+
+	private:
+
+		//lossy quantization (see RegnOutData::outvarqnt)
+		float qntscale[64];
+		float qntoffset[64];
+		unsigned int qntmask[64];
+
+		NcVar* addVar(const char* name, const int & ivar, NcDim* dim0, NcDim* dim1, NcDim* dim2=NULL);
+		void putVar(NcVar* var, const int & ivar, const float * vals,
+				const long & c0, const long & c1, const long & c2=0);
    		
 };
 
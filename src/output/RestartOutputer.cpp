@@ -2,11 +2,14 @@
 
 /*! constructor */
  RestartOutputer::RestartOutputer(){
- 
+ 	restartFile = NULL;
+ 	blocksize = 1;
+ 	block0 = -1;
 };
 
 RestartOutputer::~RestartOutputer(){
 	if (restartFile!=NULL) {
+		flush();
 		restartFile->close();
 		delete restartFile;
 	}
@@ -102,147 +105,230 @@ void RestartOutputer::init(string& outputdir,string& stage, const int & numprocs
 
 }
 
+// the current cohort's record is checked and buffered, and the buffer is
+// written out when full or when the records are no longer consecutive
 void RestartOutputer::outputVariables(const int & chtcount){
+
+	if (!block.empty() && chtcount!=block0+(int)block.size()) flush();
+	if (block.empty()) block0 = chtcount;
+
+	block.push_back(*resod);
+	blockerr.push_back(errorChecking());
+
+	if ((int)block.size()>=blocksize) flush();
+
+}
+
+void RestartOutputer::flush(){
+	PHASE_SCOPE("RestartOutputer::flush");
+	TRACE_SCOPE("RestartOutputer::flush");
  	NcError err(NcError::verbose_nonfatal);
 
-	int errcode=errorChecking();
-
-	chtidV->put_rec(&resod->chtid, chtcount);
-	errcodeV->put_rec(&errcode, chtcount);
-	permaV->put_rec(&resod->perma, chtcount);
-	TSsnowV->put_rec(&resod->TSsnow[0], chtcount);
-	DZsnowV->put_rec(&resod->DZsnow[0], chtcount);
-	LIQsnowV->put_rec(&resod->LIQsnow[0], chtcount);
-	ICEsnowV->put_rec(&resod->ICEsnow[0], chtcount);
-	AGEsnowV->put_rec(&resod->AGEsnow[0], chtcount);
-	RHOsnowV->put_rec(&resod->RHOsnow[0], chtcount);
-	
-	TSsoilV->put_rec(&resod->TSsoil[0], chtcount);
-	DZsoilV->put_rec(&resod->DZsoil[0], chtcount);
-	LIQsoilV->put_rec(&resod->LIQsoil[0], chtcount);	
-	ICEsoilV->put_rec(&resod->ICEsoil[0], chtcount);
-	FROZENsoilV->put_rec(&resod->FROZENsoil[0], chtcount);
-
-	NONCsoilV->put_rec(&resod->NONCsoil[0], chtcount);
-	REACsoilV->put_rec(&resod->REACsoil[0], chtcount);
-
-	TYPEsoilV->put_rec(&resod->TYPEsoil[0], chtcount);
-	CLAYminV->put_rec(&resod->CLAYmin[0], chtcount);
-	SANDminV->put_rec(&resod->SANDmin[0], chtcount);
-	SILTminV->put_rec(&resod->SILTmin[0], chtcount);
-
-	TSrockV->put_rec(&resod->TSrock[0], chtcount);
-	DZrockV->put_rec(&resod->DZrock[0], chtcount);
-	
-	frontZV->put_rec(&resod->frontZ[0], chtcount);
-	frontFTV->put_rec(&resod->frontFT[0], chtcount);
-	
-	solnV->put_rec(&resod->soln, chtcount);
-	avlnV->put_rec(&resod->avln, chtcount);
-	wdebrisV->put_rec(&resod->wdebris, chtcount);
-	strnV->put_rec(&resod->strn, chtcount);
-	stonV->put_rec(&resod->ston, chtcount);
-	vegcV->put_rec(&resod->vegc, chtcount);
-	deadcV->put_rec(&resod->deadc, chtcount);
-	deadnV->put_rec(&resod->deadn, chtcount);
-
-	prveetmxV->put_rec(&resod->prveetmx, chtcount);
-	prvpetmxV->put_rec(&resod->prvpetmx, chtcount);
-
-	foliagemxV->put_rec(&resod->foliagemx, chtcount);
-	laiV->put_rec(&resod->lai, chtcount);
-	unnormleafV->put_rec(&resod->unnormleaf, chtcount);
-	prvunnormleafmxV->put_rec(&resod->prvunnormleafmx, chtcount);
-
-	prvtoptV->put_rec(&resod->prvtopt, chtcount);
-	
-	c2nV->put_rec(&resod->c2n, chtcount);
+	int nrec = (int)block.size();
+	if (nrec<=0) return;
 
-	kdfibV->put_rec(&resod->kdfib, chtcount);
-	kdhumV->put_rec(&resod->kdhum, chtcount);
-	kdminV->put_rec(&resod->kdmin, chtcount);
-	kdslowV->put_rec(&resod->kdslow, chtcount);
-	
-	ysfV->put_rec(&resod->ysf, chtcount);
-	burnednV->put_rec(&resod->burnedn, chtcount);
-    
-    	toptAV->put_rec(&resod->toptA[0], chtcount);
-	eetmxAV->put_rec(&resod->eetmxA[0], chtcount);
-	petmxAV->put_rec(&resod->petmxA[0], chtcount);
-	unnormleafmxAV->put_rec(&resod->unnormleafmxA[0], chtcount);
+	ibuf.resize(nrec);
+	for (int i=0; i<nrec; i++) ibuf[i] = block[i].chtid;
+	putInt(chtidV, nrec, 1);
+	for (int i=0; i<nrec; i++) ibuf[i] = blockerr[i];
+	putInt(errcodeV, nrec, 1);
+	for (int i=0; i<nrec; i++) ibuf[i] = block[i].perma;
+	putInt(permaV, nrec, 1);
+
+	dbuf.resize(nrec*MAX_SNW_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*MAX_SNW_LAY], block[i].TSsnow, MAX_SNW_LAY*sizeof(double));
+	putDouble(TSsnowV, nrec, MAX_SNW_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*MAX_SNW_LAY], block[i].DZsnow, MAX_SNW_LAY*sizeof(double));
+	putDouble(DZsnowV, nrec, MAX_SNW_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*MAX_SNW_LAY], block[i].LIQsnow, MAX_SNW_LAY*sizeof(double));
+	putDouble(LIQsnowV, nrec, MAX_SNW_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*MAX_SNW_LAY], block[i].ICEsnow, MAX_SNW_LAY*sizeof(double));
+	putDouble(ICEsnowV, nrec, MAX_SNW_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*MAX_SNW_LAY], block[i].AGEsnow, MAX_SNW_LAY*sizeof(double));
+	putDouble(AGEsnowV, nrec, MAX_SNW_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*MAX_SNW_LAY], block[i].RHOsnow, MAX_SNW_LAY*sizeof(double));
+	putDouble(RHOsnowV, nrec, MAX_SNW_LAY);
+
+	dbuf.resize(nrec*MAX_SOI_LAY);
+	ibuf.resize(nrec*MAX_SOI_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*MAX_SOI_LAY], block[i].TSsoil, MAX_SOI_LAY*sizeof(double));
+	putDouble(TSsoilV, nrec, MAX_SOI_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*MAX_SOI_LAY], block[i].DZsoil, MAX_SOI_LAY*sizeof(double));
+	putDouble(DZsoilV, nrec, MAX_SOI_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*MAX_SOI_LAY], block[i].LIQsoil, MAX_SOI_LAY*sizeof(double));
+	putDouble(LIQsoilV, nrec, MAX_SOI_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*MAX_SOI_LAY], block[i].ICEsoil, MAX_SOI_LAY*sizeof(double));
+	putDouble(ICEsoilV, nrec, MAX_SOI_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&ibuf[i*MAX_SOI_LAY], block[i].FROZENsoil, MAX_SOI_LAY*sizeof(int));
+	putInt(FROZENsoilV, nrec, MAX_SOI_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*MAX_SOI_LAY], block[i].NONCsoil, MAX_SOI_LAY*sizeof(double));
+	putDouble(NONCsoilV, nrec, MAX_SOI_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*MAX_SOI_LAY], block[i].REACsoil, MAX_SOI_LAY*sizeof(double));
+	putDouble(REACsoilV, nrec, MAX_SOI_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&ibuf[i*MAX_SOI_LAY], block[i].TYPEsoil, MAX_SOI_LAY*sizeof(int));
+	putInt(TYPEsoilV, nrec, MAX_SOI_LAY);
+
+	ibuf.resize(nrec*MAX_MIN_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&ibuf[i*MAX_MIN_LAY], block[i].CLAYmin, MAX_MIN_LAY*sizeof(int));
+	putInt(CLAYminV, nrec, MAX_MIN_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&ibuf[i*MAX_MIN_LAY], block[i].SANDmin, MAX_MIN_LAY*sizeof(int));
+	putInt(SANDminV, nrec, MAX_MIN_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&ibuf[i*MAX_MIN_LAY], block[i].SILTmin, MAX_MIN_LAY*sizeof(int));
+	putInt(SILTminV, nrec, MAX_MIN_LAY);
+
+	dbuf.resize(nrec*MAX_ROC_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*MAX_ROC_LAY], block[i].TSrock, MAX_ROC_LAY*sizeof(double));
+	putDouble(TSrockV, nrec, MAX_ROC_LAY);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*MAX_ROC_LAY], block[i].DZrock, MAX_ROC_LAY*sizeof(double));
+	putDouble(DZrockV, nrec, MAX_ROC_LAY);
+
+	dbuf.resize(nrec*MAX_NUM_FNT);
+	ibuf.resize(nrec*MAX_NUM_FNT);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*MAX_NUM_FNT], block[i].frontZ, MAX_NUM_FNT*sizeof(double));
+	putDouble(frontZV, nrec, MAX_NUM_FNT);
+	for (int i=0; i<nrec; i++) memcpy(&ibuf[i*MAX_NUM_FNT], block[i].frontFT, MAX_NUM_FNT*sizeof(int));
+	putInt(frontFTV, nrec, MAX_NUM_FNT);
+
+	dbuf.resize(nrec);
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].soln;
+	putDouble(solnV, nrec, 1);
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].avln;
+	putDouble(avlnV, nrec, 1);
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].wdebris;
+	putDouble(wdebrisV, nrec, 1);
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].strn;
+	putDouble(strnV, nrec, 1);
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].ston;
+	putDouble(stonV, nrec, 1);
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].vegc;
+	putDouble(vegcV, nrec, 1);
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].deadc;
+	putDouble(deadcV, nrec, 1);
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].deadn;
+	putDouble(deadnV, nrec, 1);
+
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].prveetmx;
+	putDouble(prveetmxV, nrec, 1);
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].prvpetmx;
+	putDouble(prvpetmxV, nrec, 1);
+
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].foliagemx;
+	putDouble(foliagemxV, nrec, 1);
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].lai;
+	putDouble(laiV, nrec, 1);
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].unnormleaf;
+	putDouble(unnormleafV, nrec, 1);
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].prvunnormleafmx;
+	putDouble(prvunnormleafmxV, nrec, 1);
+
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].prvtopt;
+	putDouble(prvtoptV, nrec, 1);
+
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].c2n;
+	putDouble(c2nV, nrec, 1);
+
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].kdfib;
+	putDouble(kdfibV, nrec, 1);
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].kdhum;
+	putDouble(kdhumV, nrec, 1);
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].kdmin;
+	putDouble(kdminV, nrec, 1);
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].kdslow;
+	putDouble(kdslowV, nrec, 1);
+
+	ibuf.resize(nrec);
+	for (int i=0; i<nrec; i++) ibuf[i] = block[i].ysf;
+	putInt(ysfV, nrec, 1);
+	for (int i=0; i<nrec; i++) dbuf[i] = block[i].burnedn;
+	putDouble(burnednV, nrec, 1);
+
+	dbuf.resize(nrec*10);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*10], block[i].toptA, 10*sizeof(double));
+	putDouble(toptAV, nrec, 10);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*10], block[i].eetmxA, 10*sizeof(double));
+	putDouble(eetmxAV, nrec, 10);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*10], block[i].petmxA, 10*sizeof(double));
+	putDouble(petmxAV, nrec, 10);
+	for (int i=0; i<nrec; i++) memcpy(&dbuf[i*10], block[i].unnormleafmxA, 10*sizeof(double));
+	putDouble(unnormleafmxAV, nrec, 10);
+
+	block.clear();
+	blockerr.clear();
 
 }
 
-int RestartOutputer::errorChecking(){
-	int errcode = 0;
-	
-	for(int il =0;il<MAX_SNW_LAY; il++){
-		if (isnan(resod->TSsnow[il]) || isinf(resod->TSsnow[il])) errcode = -1;	
-		if (isnan(resod->DZsnow[il]) || isinf(resod->DZsnow[il])) errcode = -1;	
-		if (isnan(resod->LIQsnow[il]) || isinf(resod->LIQsnow[il])) errcode = -1;	
-		if (isnan(resod->ICEsnow[il]) || isinf(resod->ICEsnow[il])) errcode = -1;	
-		if (isnan(resod->AGEsnow[il]) || isinf(resod->AGEsnow[il])) errcode = -1;	
-		if (isnan(resod->RHOsnow[il]) || isinf(resod->RHOsnow[il])) errcode = -1;	
-	}
-	
-	for(int il =0;il<MAX_SOI_LAY; il++){
-		if (isnan(resod->TSsoil[il]) || isinf(resod->TSsoil[il])) errcode = -1;	
-		if (isnan(resod->DZsoil[il]) || isinf(resod->DZsoil[il])) errcode = -1;	
-		if (isnan(resod->LIQsoil[il]) || isinf(resod->LIQsoil[il])) errcode = -1;	
-		if (isnan(resod->ICEsoil[il]) || isinf(resod->ICEsoil[il])) errcode = -1;	
-		if (isnan(resod->FROZENsoil[il]) || isinf(resod->FROZENsoil[il])) errcode = -1;	
-		if (isnan(resod->TYPEsoil[il]) || isinf(resod->TYPEsoil[il])) errcode = -1;	
-		if (isnan(resod->NONCsoil[il]) || isinf(resod->NONCsoil[il])) errcode = -1;	
-		if (isnan(resod->REACsoil[il]) || isinf(resod->REACsoil[il])) errcode = -1;	
+void RestartOutputer::putDouble(NcVar* var, const int & nrec, const int & nlay){
+	var->set_cur(block0);
+	if (nlay>1) {
+		var->put(&dbuf[0], nrec, nlay);
+	} else {
+		var->put(&dbuf[0], nrec);
 	}
-	
-	for(int il =0;il<MAX_MIN_LAY; il++){
-		if (isnan(resod->CLAYmin[il]) || isinf(resod->CLAYmin[il])) errcode = -1;	
-		if (isnan(resod->SANDmin[il]) || isinf(resod->SANDmin[il])) errcode = -1;	
-		if (isnan(resod->SILTmin[il]) || isinf(resod->SILTmin[il])) errcode = -1;	
-	}
-   
-	for(int il =0;il<MAX_ROC_LAY; il++){
-		if (isnan(resod->TSrock[il]) || isinf(resod->TSrock[il])) errcode = -1;	
-		if (isnan(resod->DZrock[il]) || isinf(resod->DZrock[il])) errcode = -1;	
+}
+
+void RestartOutputer::putInt(NcVar* var, const int & nrec, const int & nlay){
+	var->set_cur(block0);
+	if (nlay>1) {
+		var->put(&ibuf[0], nrec, nlay);
+	} else {
+		var->put(&ibuf[0], nrec);
 	}
+}
 
-	for(int il =0;il<MAX_NUM_FNT; il++){
-		if (isnan(resod->frontZ[il]) || isinf(resod->frontZ[il])) errcode = -1;	
-		if (isnan(resod->frontFT[il]) || isinf(resod->frontFT[il])) errcode = -1;	
+//1 if any of 'vals' is NaN or Inf: exponent bits all set. Integer only, so that
+// the loop has no branch and can be vectorized
+int RestartOutputer::nonFinite(const double * vals, const int & n){
+	const unsigned long long expmask = 0x7ff0000000000000ULL;
+	unsigned long long bits;
+	int bad = 0;
+	for (int i=0; i<n; i++) {
+		memcpy(&bits, &vals[i], sizeof(bits));
+		bad |= ((bits & expmask)==expmask);
 	}
-     
-    	for(int i=0; i<10; i++){
-		if (isnan(resod->toptA[i]) || isinf(resod->toptA[i])) errcode = -1;	
-		if (isnan(resod->eetmxA[i]) || isinf(resod->eetmxA[i])) errcode = -1;	
-		if (isnan(resod->petmxA[i]) || isinf(resod->petmxA[i])) errcode = -1;	
-		if (isnan(resod->unnormleafmxA[i]) || isinf(resod->unnormleafmxA[i])) errcode = -1;	
-    }
-     
-	if (isnan(resod->soln) || isinf(resod->soln)) errcode = -1;	
-	if (isnan(resod->avln) || isinf(resod->avln)) errcode = -1;	
-	if (isnan(resod->wdebris) || isinf(resod->wdebris)) errcode = -1;	
-	if (isnan(resod->strn) || isinf(resod->strn)) errcode = -1;	
-	if (isnan(resod->ston) || isinf(resod->ston)) errcode = -1;	
-	if (isnan(resod->vegc) || isinf(resod->vegc)) errcode = -1;	
-	if (isnan(resod->deadc) || isinf(resod->deadc)) errcode = -1;	
-	if (isnan(resod->deadn) || isinf(resod->deadn)) errcode = -1;	
-	if (isnan(resod->prveetmx) || isinf(resod->prveetmx)) errcode = -1;	
-	if (isnan(resod->prvpetmx) || isinf(resod->prvpetmx)) errcode = -1;	
-	if (isnan(resod->unnormleaf) || isinf(resod->unnormleaf)) errcode = -1;	
-	if (isnan(resod->prvunnormleafmx) || isinf(resod->prvunnormleafmx)) errcode = -1;	
-	if (isnan(resod->prvtopt) || isinf(resod->prvtopt)) errcode = -1;	
-	if (isnan(resod->c2n) || isinf(resod->c2n)) errcode = -1;	
-	if (isnan(resod->kdfib) || isinf(resod->kdfib)) errcode = -1;	
-	if (isnan(resod->kdhum) || isinf(resod->kdhum)) errcode = -1;	
-	if (isnan(resod->kdmin) || isinf(resod->kdmin)) errcode = -1;
-	if (isnan(resod->kdslow) || isinf(resod->kdslow)) errcode = -1;
-	if (isnan(resod->foliagemx) || isinf(resod->foliagemx)) errcode = -1;	
-	if (isnan(resod->ysf) || isinf(resod->ysf)) errcode = -1;	
-	if (isnan(resod->burnedn) || isinf(resod->burnedn)) errcode = -1;
-	if (isnan(resod->lai) || isinf(resod->lai)) errcode = -1;	
-
-	return errcode;
+	return bad;
+}
+
+// -1 if any (double) restart variable of current cohort is NaN or Inf, otherwise 0
+// (the integer variables cannot be)
+int RestartOutputer::errorChecking(){
+	int bad = 0;
+
+	bad |= nonFinite(resod->TSsnow, MAX_SNW_LAY);
+	bad |= nonFinite(resod->DZsnow, MAX_SNW_LAY);
+	bad |= nonFinite(resod->LIQsnow, MAX_SNW_LAY);
+	bad |= nonFinite(resod->ICEsnow, MAX_SNW_LAY);
+	bad |= nonFinite(resod->AGEsnow, MAX_SNW_LAY);
+	bad |= nonFinite(resod->RHOsnow, MAX_SNW_LAY);
+
+	bad |= nonFinite(resod->TSsoil, MAX_SOI_LAY);
+	bad |= nonFinite(resod->DZsoil, MAX_SOI_LAY);
+	bad |= nonFinite(resod->LIQsoil, MAX_SOI_LAY);
+	bad |= nonFinite(resod->ICEsoil, MAX_SOI_LAY);
+	bad |= nonFinite(resod->NONCsoil, MAX_SOI_LAY);
+	bad |= nonFinite(resod->REACsoil, MAX_SOI_LAY);
+
+	bad |= nonFinite(resod->TSrock, MAX_ROC_LAY);
+	bad |= nonFinite(resod->DZrock, MAX_ROC_LAY);
+	bad |= nonFinite(resod->frontZ, MAX_NUM_FNT);
+
+	bad |= nonFinite(resod->toptA, 10);
+	bad |= nonFinite(resod->eetmxA, 10);
+	bad |= nonFinite(resod->petmxA, 10);
+	bad |= nonFinite(resod->unnormleafmxA, 10);
+
+	double scalars[] = {resod->soln, resod->avln, resod->wdebris, resod->strn, resod->ston,
+			resod->vegc, resod->deadc, resod->deadn, resod->prveetmx, resod->prvpetmx,
+			resod->unnormleaf, resod->prvunnormleafmx, resod->prvtopt, resod->c2n,
+			resod->kdfib, resod->kdhum, resod->kdmin, resod->kdslow, resod->foliagemx,
+			resod->burnedn, resod->lai};
+	bad |= nonFinite(scalars, sizeof(scalars)/sizeof(double));
+
+	return bad ? -1 : 0;
+}
+
+void RestartOutputer::setBlockSize(const int & nrec){
+	flush();
+	blocksize = (nrec>1) ? nrec : 1;
 }
 
 void RestartOutputer::setRestartOutData(RestartData * resodp){
@@ -14,6 +14,8 @@
 #include <sstream>
 #include <ctime>
 #include <cstdlib>
+#include <cstring>
+#include <vector>
 using namespace std;
 #include <string>
 using std::string;
@@ -21,6 +23,8 @@ using std::string;
 #include "../inc/layerconst.h"
 #include "../inc/timeconst.h"
 #include "../data/RestartData.h"
+#include "../util/PhaseTimer.h"
+#include "../util/TraceRecorder.h"
 
 class RestartOutputer {
 	public :
@@ -35,12 +39,26 @@ class RestartOutputer {
 		void outputVariables(const int & chtcount);
 		void setRestartOutData(RestartData * resodp);
 
+		void setBlockSize(const int & nrec);  //bulk mode: write 'nrec' consecutive records per disk access
+		void flush();
+
 		RestartData * resod;
 
 		string restartfname;
 
 	private:
 
+		int blocksize;
+		int block0;              //first record (chtcount) in block
+		vector<RestartData> block;
+		vector<int> blockerr;
+		vector<double> dbuf;
+		vector<int> ibuf;
+
+		int nonFinite(const double * vals, const int & n);
+		void putDouble(NcVar* var, const int & nrec, const int & nlay);
+		void putInt(NcVar* var, const int & nrec, const int & nlay);
+
 		NcFile* restartFile;
 	   
    		NcDim * chtD;
@@ -0,0 +1,100 @@
+#include "SolverOutputer.h"
+
+/*! constructor */
+SolverOutputer::SolverOutputer(){
+	solverFile = NULL;
+	reccount   = 0;
+};
+
+SolverOutputer::~SolverOutputer(){
+ 	if(solverFile!=NULL){
+    	solverFile->close();
+		delete solverFile;
+ 	}
+};
+
+void SolverOutputer::init(string& outputdir, const int & myid, string& stage){
+
+	string solfn =outputdir+"solver"+stage+".nc";
+	solverFile = new NcFile(solfn.c_str(), NcFile::Replace);
+	recD = solverFile->add_dim("REC");
+	chtidV =solverFile->add_var("CHTID", ncInt, recD);
+	stageV =solverFile->add_var("STAGE", ncInt, recD);     // 0 - eq, 1 - sp, 2 - tr, 3 - sc
+
+	// Stefan (freezing/thawing fronts)
+	stfcallV =solverFile->add_var("STFCALLS", ncInt, recD);
+	stfsubV  =solverFile->add_var("STFSUBSTEPS", ncInt, recD);
+	stfitV   =solverFile->add_var("STFITERS", ncInt, recD);
+	stfhalfV =solverFile->add_var("STFHALVINGS", ncInt, recD);
+	stfbailV =solverFile->add_var("STFBAILOUTS", ncInt, recD);
+	stfminV  =solverFile->add_var("STFMINTSTEP", ncDouble, recD);
+
+	// Richard (soil water)
+	ricallV =solverFile->add_var("RICALLS", ncInt, recD);
+	risubV  =solverFile->add_var("RISUBSTEPS", ncInt, recD);
+	riitV   =solverFile->add_var("RIITERS", ncInt, recD);
+	rihalfV =solverFile->add_var("RIHALVINGS", ncInt, recD);
+	ribailV =solverFile->add_var("RIBAILOUTS", ncInt, recD);
+	riminV  =solverFile->add_var("RIMINTSTEP", ncDouble, recD);
+
+	// Integrator (RKF45 of bgc)
+	rkfcallV  =solverFile->add_var("RKFCALLS", ncInt, recD);
+	rkfaccV   =solverFile->add_var("RKFACCEPTED", ncInt, recD);
+	rkfrejV   =solverFile->add_var("RKFREJECTED", ncInt, recD);
+	rkfforcV  =solverFile->add_var("RKFFORCED", ncInt, recD);
+	rkfblackV =solverFile->add_var("RKFBLACKHOL", ncInt, recD);
+	rkfminV   =solverFile->add_var("RKFMINDT", ncDouble, recD);
+	rkfderV   =solverFile->add_var("RKFDERIVS", ncInt, recD);
+
+	reccount = 0;
+
+};
+
+void SolverOutputer::putStep(NcVar* callV, NcVar* subV, NcVar* itV, NcVar* halfV, NcVar* bailV,
+		NcVar* minV, const stepstats & stats){
+
+	int ival;
+	ival = stats.calls;
+	callV->put_rec(&ival, reccount);
+	ival = stats.substeps;
+	subV->put_rec(&ival, reccount);
+	ival = stats.iterations;
+	itV->put_rec(&ival, reccount);
+	ival = stats.halvings;
+	halfV->put_rec(&ival, reccount);
+	ival = stats.bailouts;
+	bailV->put_rec(&ival, reccount);
+	minV->put_rec(&stats.mintstep, reccount);
+
+};
+
+void SolverOutputer::outputVariables(const int & chtid, const int & stage,
+		const stepstats & stefan, const stepstats & richard, const rkfstats & integ){
+
+	if (solverFile==NULL) return;
+	TRACE_SCOPE("SolverOutputer::outputVariables");
+
+	chtidV->put_rec(&chtid, reccount);
+	stageV->put_rec(&stage, reccount);
+
+	putStep(stfcallV, stfsubV, stfitV, stfhalfV, stfbailV, stfminV, stefan);
+	putStep(ricallV, risubV, riitV, rihalfV, ribailV, riminV, richard);
+
+	int ival;
+	ival = integ.calls;
+	rkfcallV->put_rec(&ival, reccount);
+	ival = integ.accepted;
+	rkfaccV->put_rec(&ival, reccount);
+	ival = integ.rejected;
+	rkfrejV->put_rec(&ival, reccount);
+	ival = integ.forced;
+	rkfforcV->put_rec(&ival, reccount);
+	ival = integ.blackhol;
+	rkfblackV->put_rec(&ival, reccount);
+	rkfminV->put_rec(&integ.mindt, reccount);
+	ival = integ.derivs;
+	rkfderV->put_rec(&ival, reccount);
+
+	reccount++;
+
+};
@@ -0,0 +1,63 @@
+/*! this class is used to output the counters of the numerical solvers
+ *  (Stefan, Richard, Integrator), one record per cohort and run stage, in the netcdf format
+ */
+#ifndef SOLVEROUTPUTER_H_
+	#define SOLVEROUTPUTER_H_
+
+    #include <netcdfcpp.h>
+    #include <ncvalues.h>
+
+	#include <iostream>
+	#include <string>
+
+	using namespace std;
+	using std::string;
+
+	#include "../inc/solverstats.h"
+	#include "../util/TraceRecorder.h"
+
+	class SolverOutputer {
+		public :
+			SolverOutputer();
+			void init(string& dir, const int & myid, string& stage);
+			~SolverOutputer();
+
+			NcFile* solverFile;
+
+			void outputVariables(const int & chtid, const int & stage,
+					const stepstats & stefan, const stepstats & richard, const rkfstats & integ);
+
+   	private:
+			int reccount;
+
+   			NcDim * recD;
+			NcVar* chtidV;
+			NcVar* stageV;
+
+			NcVar* stfcallV;
+			NcVar* stfsubV;
+			NcVar* stfitV;
+			NcVar* stfhalfV;
+			NcVar* stfbailV;
+			NcVar* stfminV;
+
+			NcVar* ricallV;
+			NcVar* risubV;
+			NcVar* riitV;
+			NcVar* rihalfV;
+			NcVar* ribailV;
+			NcVar* riminV;
+
+			NcVar* rkfcallV;
+			NcVar* rkfaccV;
+			NcVar* rkfrejV;
+			NcVar* rkfforcV;
+			NcVar* rkfblackV;
+			NcVar* rkfminV;
+			NcVar* rkfderV;
+
+			void putStep(NcVar* callV, NcVar* subV, NcVar* itV, NcVar* halfV, NcVar* bailV,
+					NcVar* minV, const stepstats & stats);
+	};
+
+#endif /*SOLVEROUTPUTER_H_*/
@@ -3,6 +3,7 @@
 Cohort::Cohort(){
  	rheqflag   = 1;
  	friderived = false;   //this is default, can be modified
+ 	warmstart  = false;
 };
 
 Cohort::~Cohort(){
@@ -57,30 +58,16 @@ int Cohort::reset() {
     	int vegtype = cd->vegtype;
  	  
  	 // initial state variables
+	bool restart = (md->initmode==3 || warmstart);   //warmstart: the restart path, from the eq state of a similar cohort
 
-	if(md->initmode < 3){    //lookup or sitein
+	if(!restart){    //lookup or sitein
 
 		// first read in the default initial values
 	 	ground.soil.moss.thick = chtlu.mossthick[drgtype][vegtype];
     		ground.soil.peat.shlwthick = chtlu.fibthick[drgtype][vegtype];
     		ground.soil.peat.deepthick = chtlu.humthick[drgtype][vegtype];
 
-		// reset the soil texture data from grid-level soil.nc, rather than 'chtlu',
- 	        // Note that the default mineral layer structure is defined in layerconst.h
- 		float z=0;
- 		for (int i=0; i<MAX_MIN_LAY; i++){
-	 			 z+=MINETHICK[i];
-	 			 if (z<=0.21) {   //assuming the grid top-soil texture is for top 20 cm
-	 				ground.soil.mineral.clay[i] = gd->topclay;
-	 				ground.soil.mineral.sand[i] = gd->topsand;
-	 				ground.soil.mineral.silt[i] = gd->topsilt;
-	 			 } else {
-	 				 ground.soil.mineral.clay[i] = gd->botclay;
-	 				 ground.soil.mineral.sand[i] = gd->botsand;
-	 				 ground.soil.mineral.silt[i] = gd->botsilt;
-	 			 }
-	 	 }
- 		 ground.soil.mineral.thick = z;
+ 		 ground.soil.mineral.thick = setGridTexture();
 
  		 // then if we have sitein.nc, as specified. In this way, if sitein.nc may not provide
  		 // all data, then model will still be able to use the default.
@@ -99,10 +86,14 @@ int Cohort::reset() {
 			if (resid.TYPEsoil[i]==3) ground.soil.mineral.thick += resid.DZsoil[i];
 
 		}
-		for(int j=0; j<MAX_MIN_LAY; j++){
-			ground.soil.mineral.clay[j] = resid.CLAYmin[j];
-			ground.soil.mineral.sand[j] = resid.SANDmin[j];
-			ground.soil.mineral.silt[j] = resid.SILTmin[j];
+		if (warmstart) {      //the cohort's own soil, not the one of the state
+			setGridTexture();
+		} else {
+			for(int j=0; j<MAX_MIN_LAY; j++){
+				ground.soil.mineral.clay[j] = resid.CLAYmin[j];
+				ground.soil.mineral.sand[j] = resid.SANDmin[j];
+				ground.soil.mineral.silt[j] = resid.SILTmin[j];
+			}
 		}
 
 
@@ -123,7 +114,7 @@ int Cohort::reset() {
  	bd->init();
  	fd->init();
  
- 	if(md->initmode<3){
+ 	if(!restart){
  		fire.initializeState();
  		vb.initializeState(drgtype, vegtype);
  		ve.initializeState(drgtype, vegtype);
@@ -206,6 +197,26 @@ void Cohort::setRegnOutData(RegnOutData *regnodp){
     regnod = regnodp;
 };
 
+// reset the soil texture data from grid-level soil.nc, rather than 'chtlu',
+// Note that the default mineral layer structure is defined in layerconst.h
+// returns the thickness of the mineral layers
+float Cohort::setGridTexture(){
+	float z=0;
+	for (int i=0; i<MAX_MIN_LAY; i++){
+		z+=MINETHICK[i];
+		if (z<=0.21) {   //assuming the grid top-soil texture is for top 20 cm
+			ground.soil.mineral.clay[i] = gd->topclay;
+			ground.soil.mineral.sand[i] = gd->topsand;
+			ground.soil.mineral.silt[i] = gd->topsilt;
+		} else {
+			ground.soil.mineral.clay[i] = gd->botclay;
+			ground.soil.mineral.sand[i] = gd->botsand;
+			ground.soil.mineral.silt[i] = gd->botsilt;
+		}
+	}
+	return z;
+};
+
 bool Cohort::testEquilibrium(){
   	bool eqed =false;
   	int nfeed = bd->nfeed;
@@ -451,6 +462,8 @@ int Cohort::timerOutputYearIndex(bool equiled, bool spined, bool outputSpinup){
 
 int Cohort::updateMonthly(const int & outputyrind,const int & yrcnt, const int & currmind,
         const int & dinmcurr, const bool & assigneq, const bool & useeq){
+	PHASE_SCOPE("Cohort::updateMonthly");
+	TRACE_SCOPE_ARG("month", "yrcnt*12+m", yrcnt*12+currmind);
 	int error = 0;
 //	if (currmind == 5) cout << "update monthly/ ed->m_atms.co2(5)" << ed->m_atms.co2 << "\n";
 //	if (currmind == 5) cout << "update monthly/ ed->m_a2l.nirr(5)" << ed->m_a2l.nirr << "\n";
@@ -506,6 +519,7 @@ int Cohort::updateMonthly(const int & outputyrind,const int & yrcnt, const int &
 //fire disturbance (yearly timestep)
 /////////////////////////////////////////////////////////////////////////////////
 void Cohort::updateMonthly_Fir(const int & yrcnt, const int & currmind  ){ 
+	PHASE_SCOPE("Cohort::updateMonthly_Fir");
   
   	int fireoccur = fire.getOccur(yrcnt, currmind, friderived);
 
@@ -535,6 +549,7 @@ void Cohort::updateMonthly_Fir(const int & yrcnt, const int & currmind  ){
 //   Dynamical Soil Layer Module (DSL) calling, but only at yearly timestep
 ////////////////////////////////////////////////////////////////////////////////
 void Cohort::updateMonthly_Dsl(const int & yrcnt, const int & currmind){
+	PHASE_SCOPE("Cohort::updateMonthly_Dsl");
 	if(currmind==0){ 
 		//only update the thickness at begin of year , since it is a slow process 	
 //  		if(equiled){   //Yuan: so that this module can be used for eq-run
@@ -590,6 +605,8 @@ void Cohort::updateMonthly_Dsl(const int & yrcnt, const int & currmind){
 /////////////////////////////////////////////////////////
 int Cohort::updateMonthly_Env(const int & yrcnt,const int &  calyr,
 			const int & currmind, const int & dinmcurr, const bool & assigneq){
+	PHASE_SCOPE("Cohort::updateMonthly_Env");
+	TRACE_SCOPE("Cohort::updateMonthly_Env");
 
 	int error = 0;
 	double tdrv, daylength; 
@@ -654,6 +671,7 @@ int Cohort::updateMonthly_Env(const int & yrcnt,const int &  calyr,
 //	if (currmind == 5) cout << "before daily/ ed->m_a2l.nirr(5)" << ed->m_a2l.nirr << "\n";
 
 	for(int id =0; id<dinmcurr; id++){
+		TRACE_SCOPE("day env");
 		ed->beginOfDay();
 		int doy =timer->getDOYIndex(currmind, id);
 		daylength = gd->alldaylengths[doy];
@@ -681,6 +699,14 @@ int Cohort::updateMonthly_Env(const int & yrcnt,const int &  calyr,
 		ground.soil.layer2structdaily(ground.fstsoill);
 		ground.soil.retrieveDailyOutputs(ground.fstsoill,ground.fstminl, ground.lstminl, ground.backl);
         	ground.soil.retrieveDailyFronts(ground.fstsoill);
+		if (TraceRecorder::on) {
+			int numfnt = 0;
+			for (int il=0; il<MAX_NUM_FNT; il++) {
+				if (ed->d_soid.frzfnt[il]!=-999.) numfnt++;
+				if (ed->d_soid.thwfnt[il]!=-999.) numfnt++;
+			}
+			TRACE_COUNTER("fronts", numfnt);
+		}
         	ground.snow.retrieveDailyOutputs(ground.frontl);
 		ed->endOfDay(dinmcurr, doy);//accumulate daily var into monthly var    
 
@@ -757,6 +783,8 @@ return 0;
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Cohort::updateMonthly_Bgc(const int & yrcnt,const int &  calyr, 
 			const int & currmind, const int & dinmcurr, const bool & useeq){
+	PHASE_SCOPE("Cohort::updateMonthly_Bgc");
+	TRACE_SCOPE("Cohort::updateMonthly_Bgc");
 		 
 	if(useeq){
 		ed->m_atms.ta = ed->eq_ta[currmind];
@@ -793,7 +821,9 @@ void Cohort::updateMonthly_Bgc(const int & yrcnt,const int &  calyr,
 	sb.prepareIntegration();
 	vb.prepareIntegration(equiled);
 		 
+	IntegratorDump::before(&sb, &vb, ed, bd, fd, yrcnt, currmind);
 	integrator.updateMonthly();
+	IntegratorDump::after(bd);
 		
 	//update topt and unleafmx in vegbgc
 	vb.updateToptUnleafmx(currmind);
@@ -1822,6 +1852,35 @@ void Cohort::updateRestartOutputBuffer(const int & stage){
  	}
 };
 
+// the soil C and N, the standing dead and the woody debris, and the rock temperatures of
+// 'state' (a restart record of this cohort, with the same layers) into the running cohort -
+// for an eq run going on from a state extrapolated at the end of a fire cycle (see EqAccelerator)
+void Cohort::setEqCycleState(const RestartData * state){
+ 	for(int il =0; il<MAX_SOI_LAY ; il++){
+ 		if(state->TYPEsoil[il] >=0){
+ 			bd->m_sois.nonc[il] =state->NONCsoil[il];
+ 			bd->m_sois.reac[il] =state->REACsoil[il];
+ 		}
+ 	}
+ 	sb.assignCarbon5Struct2Layer(ground.fstsoill);
+
+ 	bd->m_sois.orgn    = state->soln;
+ 	bd->m_sois.avln    = state->avln;
+ 	bd->m_sois.wdebris = state->wdebris;
+ 	bd->m_vegs.deadc   = state->deadc;
+ 	bd->m_vegs.deadn   = state->deadn;
+
+ 	int rockcount =-1;
+ 	Layer* currl = ground.frontl;
+ 	while(currl!=NULL){
+ 		if (currl->isRock()){
+ 			rockcount++;
+ 			currl->tem = state->TSrock[rockcount];
+ 		}
+ 		currl =currl->nextl;
+ 	}
+};
+
 void Cohort::updateSclmOutputBuffer(const int &im){ //Monthly
 
  	try {
@@ -45,6 +45,9 @@
 	#include "VegOutData.h"
 	#include "SnowSoilOutData.h"
 	#include "RegnOutData.h"
+	#include "../util/PhaseTimer.h"
+	#include "../util/TraceRecorder.h"
+	#include "../util/IntegratorDump.h"
 
 	class Cohort{
 		public :
@@ -58,6 +61,7 @@
 			bool watbaled;  // whether water balanced
 			bool failed;    // when an exception is caught, set failed to be true
 			int errorid;
+			bool warmstart; // initial state of the eq run from the eq state of a similar cohort in resid (see EqLibrary)
 
 			bool outputSpinup;
 	
@@ -129,6 +133,7 @@
 		void updateSiteYlyOutputBuffer_Fir();
 		
 		void updateRestartOutputBuffer(const int & stage);
+		void setEqCycleState(const RestartData * state);
 		void updateRegionalOutputBuffer(const int &im);  //Yuan: monthly updated
 		
 		void updateSclmOutputBuffer(const int &im);
@@ -167,6 +172,7 @@
 		void getSiteStates(SiteIn * currstate);
 
 		void updateSoilLayerType(int TYPEsoil[], int CLAYmin[], int SANDmin[], int SILTmin[]);
+		float setGridTexture();
     	
 	private:
    	 	double ctol;
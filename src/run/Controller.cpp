@@ -69,6 +69,8 @@ void Controller::ctrl4siterun(ModelData *md){
 
 	fctr >> md->casename;
 
+	readOptions(fctr, md);
+
 	if(climatename =="dynamic"){
 	  	md->changeclimate =true;
 	} else	{
@@ -119,6 +121,8 @@ void Controller::ctrl4regnrun(ModelData *md){
 
   		fctr >> md->casename;
 
+  		readOptions(fctr, md);
+
   	if(climatename =="dynamic"){
   	  	md->changeclimate =true;
   	} else	{
@@ -137,6 +141,66 @@ void Controller::ctrl4regnrun(ModelData *md){
  
 };
 
+// optional 'key value' pairs after the positional entries of a control file,
+// so that old control files still work
+void Controller::readOptions(ifstream & fctr, ModelData *md){
+
+	string key;
+	string value;
+	while (fctr >> key >> value) {
+		if (key=="inputpack") {
+			md->inputpack = value;
+		} else if (key=="restartblock") {
+			md->restartblock = atoi(value.c_str());
+		} else if (key=="trace") {
+			md->tracefile = value;
+		} else if (key=="tracebuffer") {
+			md->tracebuffer = atol(value.c_str());
+		} else if (key=="integratordump") {
+			md->integdumpfile = value;
+		} else if (key=="integratordumpmax") {
+			md->integdumpmax = atol(value.c_str());
+		} else if (key=="progress") {
+			md->progressfile = value;
+		} else if (key=="progressinterval") {
+			md->progressinterval = atof(value.c_str());
+		} else if (key=="loglevel") {
+			if (Logger::levelOf(value)>=0) {
+				md->loglevel = Logger::levelOf(value);
+			} else {
+				cout <<"unknown log level '"<<value<<"' in "<<controlfile<<" - 'info' used\n";
+			}
+		} else if (key=="daydrivers") {
+			md->daydrivermonth = (value!="all");
+		} else if (key=="clmscenario") {
+			md->clmscenario = value;
+		} else if (key=="climatewindow") {
+			md->climatewindow = atoi(value.c_str());
+		} else if (key=="drivercache") {
+			md->drivercache = value;
+		} else if (key=="eqdedup") {
+			md->eqdedup = (value=="on");
+		} else if (key=="eqwarmstart") {
+			md->eqwarmstart = value;
+		} else if (key=="eqsettle") {
+			md->eqsettle = atof(value.c_str());
+			if (md->eqsettle<0.) {
+				cout <<"eq settle tolerance '"<<value<<"' under 0 in "<<controlfile<<" - 0 (never) used\n";
+				md->eqsettle = 0.;
+			}
+		} else if (key=="eqaccel") {
+			if (value=="aitken" || value=="anderson") {
+				md->eqaccel = value;
+			} else {
+				cout <<"unknown eq acceleration '"<<value<<"' in "<<controlfile<<" - none\n";
+			}
+		} else {
+			cout <<"unknown option '"<<key<<"' in "<<controlfile<<" - ignored\n";
+		}
+	}
+
+};
+
 //BELOW is for java interface
 void Controller::setControlfile (char* jcontrolfile){
   	controlfile =string(jcontrolfile);
@@ -26,6 +26,10 @@
  			
  			//this is for java interface
   			void setControlfile(char* jcontrolfile);
+
+ 		private:
+
+ 			void readOptions(ifstream & fctr, ModelData *md);
  				
 	};
 
@@ -4,7 +4,9 @@
 #include "Grid.h"
 // constructor 
 Grid::Grid(){
-  
+	clmscen = NULL;
+	clmsrc  = &gridclm;
+	atm.setClimateSource(clmsrc);
 }
 
 // deconstructor
@@ -14,14 +16,14 @@ Grid::~Grid(){
 
 // initialization
 int Grid::reinit(const int &grdid){
+	PHASE_SCOPE("Grid::reinit");
 
   	gid =grdid;
   	gd->gid = gid;
    
-    	double ampl;
+	const SolarTable & solar = SolarCache::get(gd->lat);
 	for (int id=0; id<365; id++){
-       		ampl = exp(7.42 +0.045 *gd->lat)/3600.;
-       		gd->alldaylengths[id] = ampl * (sin ((id -79) *0.01721)) +12.0;
+       		gd->alldaylengths[id] = solar.daylength[id];
 	}
 
   //check for the validity of grid level data
@@ -50,7 +52,11 @@ int Grid::reinit(const int &grdid){
         	}
        	}	
     }
+
+	//another source checks (and transforms) its climate itself
+	if (clmscen!=NULL && clmsrc==&gridclm) clmscen->apply(gd);
   
+  	atm.hashClimate();
   	atm.prepareMonthDrivingData();
   	atm.prepareDayDrivingData();
 
@@ -71,6 +77,16 @@ void Grid::setRegionData(RegionData* rdp){
 
 void Grid::setGridData(GridData* gdp){
 	gd = gdp;
+	gridclm.setGridData(gd);
+}
+
+void Grid::setClimateScenario(ClimateScenario* scen){
+	clmscen = scen;
+}
+
+void Grid::setClimateSource(ClimateSource* src){
+	clmsrc = src;
+	atm.setClimateSource(clmsrc);
 }
 
 
@@ -6,13 +6,17 @@
 using namespace std;
 
 #include "../atmosphere/Atmosphere.h"
+#include "../atmosphere/DriverCache.h"
+#include "../input/ClimateScenario.h"
 
 #include "../data/EnvData.h"
 #include "../data/GridData.h"
+#include "../data/ClimateSource.h"
 #include "../data/RegionData.h"
 
 #include "../util/Exception.h"
 #include "../inc/ErrorCode.h"
+#include "../util/PhaseTimer.h"
 
 class Grid{
 	public :
@@ -27,6 +31,8 @@ class Grid{
  	void setEnvData(EnvData * ed);
  	void setRegionData(RegionData *rd);
  	void setGridData(GridData * gd);
+ 	void setClimateScenario(ClimateScenario * scen);
+ 	void setClimateSource(ClimateSource * src);   //instead of the climate in GridData
 
  	// 	protected:
 
@@ -35,6 +41,10 @@ class Grid{
     EnvData* ed;
     RegionData* rd;
     GridData* gd;
+    ClimateScenario* clmscen;     //optional, applied to the climate of each grid
+
+    GridClimate gridclm;          //the climate in gd, unless another source is set
+    ClimateSource* clmsrc;
 
 };
 #endif /*GRID_H_*/
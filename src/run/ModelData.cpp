@@ -12,6 +12,24 @@ ModelData::ModelData(){
   	initmode =-1;	
    
   	consoledebug = true;
+
+  	inputpack = "";
+  	restartblock = 1;
+  	tracefile = "";
+  	tracebuffer = 1000000;
+  	integdumpfile = "";
+  	integdumpmax = 1200;
+  	progressfile = "";
+  	progressinterval = 10.;
+  	loglevel = LOG_INFO;
+  	daydrivermonth = true;
+  	clmscenario = "";
+  	climatewindow = 0;
+  	drivercache = "";
+  	eqdedup = false;
+  	eqwarmstart = "";
+  	eqsettle = 1.e-2;
+  	eqaccel = "";
   	
   	myid =0;
   	numprocs =1;		
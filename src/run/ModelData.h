@@ -7,6 +7,8 @@
 	#include <sstream>
 
 	using namespace std;
+
+	#include "../util/Logger.h"
 	
 	class ModelData{
  		public:
@@ -43,6 +45,24 @@
   			string trchtinputdir;
   
   			string calibrationdir;
+
+  			string inputpack;        //optional, binary pack of all netcdf inputs (see InputPack)
+  			int restartblock;        //number of restart records read/written at once
+  			string tracefile;        //optional, trace-event JSON timeline of the run (see TraceRecorder)
+  			long tracebuffer;        //number of the last trace events kept
+  			string integdumpfile;    //optional, snapshots of the monthly bgc integration (see IntegratorDump)
+  			long integdumpmax;       //number of months (snapshots) written at most
+  			string progressfile;     //optional, JSON status of a multi-cohort run (see ProgressReporter)
+  			double progressinterval; //seconds between its updates at least
+  			int loglevel;            //most detailed console messages written (see Logger)
+  			bool daydrivermonth;     //daily climate drivers made a month at a time, not all at once (see Atmosphere)
+  			string clmscenario;      //optional, transforms of the climate as read (see ClimateScenario)
+  			int climatewindow;       //years of climate read at a time, 0 for all at once (see ClimateStream)
+  			string drivercache;      //optional, directory of the derived climate drivers (see DriverCache)
+  			bool eqdedup;            //eq run once for the cohorts of the same eq inputs (see Regioner::groupEqCohorts)
+  			string eqwarmstart;      //optional, eq runs from the eq states in a restart-eq.nc, or 'run' (see EqLibrary)
+  			double eqsettle;         //eq runs warm started or extrapolated stop once the soil C is this near its eq, relatively (0 - never)
+  			string eqaccel;          //optional, 'aitken' or 'anderson' extrapolation of the eq fire cycles (see EqAccelerator)
  
 			void checking4run();
 
@@ -6,6 +6,14 @@
 #include "RegnOutData.h"
 
 RegnOutData::RegnOutData(){
+	for (int ivar=0; ivar<64; ivar++){
+		outvarlist[ivar] = 0;
+
+		outvarqnt[ivar]  = 0;
+		outvarqmin[ivar] = 0.;
+		outvarqmax[ivar] = 0.;
+		outvarqnsd[ivar] = 0;
+	}
 
 };
 
@@ -20,6 +20,12 @@ class RegnOutData{
 	  	int outvarlist[64];  // switches for a list of following variables. read in from a .txt file
 	  	                     // 0 - not output; 1 - yearly; 2 - monthly;
 
+	  	// optional lossy quantization of the above list, read in from a .txt file (same order as outvarlist)
+	  	int outvarqnt[64];     // 0 - none (float); 1 - linear packing into int16; 2 - bit-rounding (float)
+	  	float outvarqmin[64];  // valid range of variable for int16 packing
+	  	float outvarqmax[64];
+	  	int outvarqnsd[64];    // number of significant digits kept by bit-rounding
+
 	  	// Yuan: yearly output variables (if set monthly, it's always same value)
 		float burnthick;
 	 	float burnsoic;
@@ -0,0 +1,291 @@
+#include "EqAccelerator.h"
+
+#include <cfloat>
+
+EqAccelerator::EqAccelerator(){
+	mode    = 0;
+	nextrap = 0;
+	nreject = 0;
+};
+
+EqAccelerator::~EqAccelerator(){
+
+};
+
+void EqAccelerator::setMode(const string & accmode){
+	mode = 0;
+	if (accmode=="aitken") mode = 1;
+	if (accmode=="anderson") mode = 2;
+};
+
+bool EqAccelerator::isOn(){
+	return mode>0;
+};
+
+void EqAccelerator::reset(){
+	layout.clear();
+	kind.clear();
+	xcurr.clear();
+	xs.clear();
+	gs.clear();
+};
+
+bool EqAccelerator::endOfCycle(RestartData & state){
+	if (mode==0) return false;
+
+	vector<double> g;
+	vector<int> lay;
+	pack(state, g, lay);
+
+	//the first cycle end, or other layers: the cycles from here on only
+	if (xcurr.empty() || lay!=layout) {
+		xs.clear();
+		gs.clear();
+		layout = lay;
+		xcurr  = g;
+		return false;
+	}
+
+	xs.push_back(xcurr);
+	gs.push_back(g);
+	if ((int)gs.size()>EQACC_DEPTH+1) {
+		xs.erase(xs.begin());
+		gs.erase(gs.begin());
+	}
+
+	vector<double> xnew;
+	if (gs.size()<2) {
+		xcurr = g;
+		return false;
+	}
+
+	if (!extrapolate(xnew) || !safe(xnew)) {
+		nreject++;
+		xs.erase(xs.begin(), xs.end()-1);
+		gs.erase(gs.begin(), gs.end()-1);
+		xcurr = g;
+		return false;
+	}
+
+	nextrap++;
+	unpack(xnew, state);
+	xcurr = xnew;
+	return true;
+};
+
+void EqAccelerator::pack(const RestartData & state, vector<double> & x, vector<int> & lay){
+	x.clear();
+	lay.clear();
+	kind.clear();
+
+	for (int il=0; il<MAX_SOI_LAY; il++) {
+		lay.push_back(state.TYPEsoil[il]);
+		if (state.TYPEsoil[il]>=0) {
+			x.push_back(state.REACsoil[il]);
+			kind.push_back('C');
+			x.push_back(state.NONCsoil[il]);
+			kind.push_back('C');
+		}
+	}
+
+	x.push_back(state.soln);
+	kind.push_back('N');
+	x.push_back(state.avln);
+	kind.push_back('N');
+	x.push_back(state.deadc);
+	kind.push_back('C');
+	x.push_back(state.deadn);
+	kind.push_back('N');
+	x.push_back(state.wdebris);
+	kind.push_back('C');
+
+	int nrock = 0;
+	for (int ir=0; ir<MAX_ROC_LAY; ir++) {
+		if (state.DZrock[ir]>0.) {
+			x.push_back(state.TSrock[ir]);
+			kind.push_back('T');
+			nrock++;
+		}
+	}
+	lay.push_back(nrock);
+};
+
+void EqAccelerator::unpack(const vector<double> & x, RestartData & state){
+	int i = 0;
+	for (int il=0; il<MAX_SOI_LAY; il++) {
+		if (state.TYPEsoil[il]>=0) {
+			state.REACsoil[il] = x[i++];
+			state.NONCsoil[il] = x[i++];
+		}
+	}
+
+	state.soln    = x[i++];
+	state.avln    = x[i++];
+	state.deadc   = x[i++];
+	state.deadn   = x[i++];
+	state.wdebris = x[i++];
+
+	for (int ir=0; ir<MAX_ROC_LAY; ir++) {
+		if (state.DZrock[ir]>0.) state.TSrock[ir] = x[i++];
+	}
+};
+
+bool EqAccelerator::extrapolate(vector<double> & xnew){
+	if (mode==1) return aitken(xnew);
+	return anderson(xnew);
+};
+
+// each variable on its own: the slope r of the cycle map from the last 2 cycles, and its fixed
+// point x + f/(1-r) = g + r/(1-r)*f, f = g-x; as the cycle ran where r is not in [0, EQACC_RMAX),
+// or for a pool, where the fixed point is under 0 (a small pool, not going geometrically)
+bool EqAccelerator::aitken(vector<double> & xnew){
+	const vector<double> & x0 = xs[xs.size()-2];
+	const vector<double> & g0 = gs[gs.size()-2];
+	const vector<double> & x1 = xs.back();
+	const vector<double> & g1 = gs.back();
+
+	int nmoved = 0;
+	xnew = g1;
+	for (int i=0; i<(int)g1.size(); i++) {
+		double dx = x1[i]-x0[i];
+		if (fabs(dx)<=1.e-12*(fabs(x1[i])+1.)) continue;
+
+		double r = (g1[i]-g0[i])/dx;
+		if (r<0. || r>=EQACC_RMAX) continue;
+
+		double xi = g1[i]+r/(1.-r)*(g1[i]-x1[i]);
+		if (kind[i]!='T' && xi<0.) continue;
+
+		xnew[i] = xi;
+		nmoved++;
+	}
+
+	return nmoved>0;
+};
+
+// all variables together: the combination of the last cycles with the least (weighted) change
+// f = g-x over the cycle, extrapolated to no change (Anderson mixing, with the cycles as run)
+//    min |W(f1 - dF*gamma)|,  xnew = g1 - dG*gamma
+// dF, dG the changes of f and g from one cycle to the next, W = 1/(the total C or N of g1) - so
+// the large pools lead, and the small ones and the temperatures (W = 0) only follow
+bool EqAccelerator::anderson(vector<double> & xnew){
+	int n = gs.size();
+	int m = n-1;
+	int nv = gs.back().size();
+	const vector<double> & x1 = xs.back();
+	const vector<double> & g1 = gs.back();
+
+	vector<vector<double> > df(m, vector<double>(nv));
+	vector<vector<double> > dg(m, vector<double>(nv));
+	vector<double> f1(nv);
+	vector<double> w(nv);
+	double totc = total(g1, 'C');
+	double totn = total(g1, 'N');
+	for (int i=0; i<nv; i++) {
+		f1[i] = g1[i]-x1[i];
+		w[i]  = 0.;
+		if (kind[i]=='C' && totc>0.) w[i] = 1./totc;
+		if (kind[i]=='N' && totn>0.) w[i] = 1./totn;
+	}
+	for (int j=0; j<m; j++) {
+		for (int i=0; i<nv; i++) {
+			dg[j][i] = gs[j+1][i]-gs[j][i];
+			df[j][i] = dg[j][i]-(xs[j+1][i]-xs[j][i]);
+		}
+	}
+
+	//normal equations (dF'W^2 dF) gamma = dF'W^2 f1, by elimination with partial pivoting
+	double a[EQACC_DEPTH][EQACC_DEPTH+1];
+	double amax = 0.;
+	for (int j=0; j<m; j++) {
+		for (int k=0; k<m; k++) {
+			a[j][k] = 0.;
+			for (int i=0; i<nv; i++) a[j][k] += df[j][i]*df[k][i]*w[i]*w[i];
+		}
+		a[j][m] = 0.;
+		for (int i=0; i<nv; i++) a[j][m] += df[j][i]*f1[i]*w[i]*w[i];
+		amax = max(amax, a[j][j]);
+	}
+	if (amax<=0.) return false;
+
+	for (int j=0; j<m; j++) {
+		int jp = j;
+		for (int k=j+1; k<m; k++) {
+			if (fabs(a[k][j])>fabs(a[jp][j])) jp = k;
+		}
+		if (fabs(a[jp][j])<=1.e-10*amax) return false;   //cycles not independent
+		if (jp!=j) {
+			for (int k=0; k<=m; k++) swap(a[j][k], a[jp][k]);
+		}
+		for (int k=j+1; k<m; k++) {
+			double fac = a[k][j]/a[j][j];
+			for (int l=j; l<=m; l++) a[k][l] -= fac*a[j][l];
+		}
+	}
+	double gamma[EQACC_DEPTH];
+	for (int j=m-1; j>=0; j--) {
+		double s = a[j][m];
+		for (int k=j+1; k<m; k++) s -= a[j][k]*gamma[k];
+		gamma[j] = s/a[j][j];
+	}
+
+	//a pool going to about 0 may come out a little under it
+	xnew = g1;
+	for (int i=0; i<nv; i++) {
+		for (int j=0; j<m; j++) xnew[i] -= gamma[j]*dg[j][i];
+		if (kind[i]!='T' && xnew[i]<0.) xnew[i] = 0.;
+	}
+
+	return true;
+};
+
+bool EqAccelerator::safe(const vector<double> & xnew){
+	const vector<double> & x1 = xs.back();
+	const vector<double> & g1 = gs.back();
+
+	for (int i=0; i<(int)xnew.size(); i++) {
+		if (!(fabs(xnew[i])<=DBL_MAX)) return false;
+		if (kind[i]!='T' && xnew[i]<0.) return false;
+	}
+
+	const char kinds[3] = {'C', 'N', 'T'};
+	for (int ik=0; ik<3; ik++) {
+		double move = 0.;
+		double change = 0.;
+		for (int i=0; i<(int)xnew.size(); i++) {
+			if (kind[i]!=kinds[ik]) continue;
+			move   += fabs(xnew[i]-g1[i]);
+			change += fabs(g1[i]-x1[i]);
+		}
+		if (move>EQACC_MAXSTEP*change+1.e-12) return false;
+	}
+
+	//the C and N added against those of the totals extrapolated (as in aitken()) by themselves:
+	//less is only slower, more or the other way is not going to the fixed point of the totals
+	for (int ik=0; ik<2; ik++) {
+		double tx0 = total(xs[xs.size()-2], kinds[ik]);
+		double tg0 = total(gs[gs.size()-2], kinds[ik]);
+		double tx1 = total(x1, kinds[ik]);
+		double tg1 = total(g1, kinds[ik]);
+
+		double added = total(xnew, kinds[ik])-tg1;
+		double expected = 0.;
+		if (fabs(tx1-tx0)>1.e-12*(fabs(tx1)+1.)) {
+			double r = (tg1-tg0)/(tx1-tx0);
+			if (r>=0. && r<EQACC_RMAX) expected = r/(1.-r)*(tg1-tx1);
+		}
+		double slack = EQACC_MASSMIN*fabs(tg1);
+		if (added*expected<0. && fabs(added)>slack) return false;
+		if (fabs(added)>(1.+EQACC_MASSTOL)*fabs(expected)+slack) return false;
+	}
+
+	return true;
+};
+
+double EqAccelerator::total(const vector<double> & x, const char & k){
+	double tot = 0.;
+	for (int i=0; i<(int)x.size(); i++) {
+		if (kind[i]==k) tot += x[i];
+	}
+	return tot;
+};
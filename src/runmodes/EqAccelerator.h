@@ -0,0 +1,85 @@
+#ifndef EQACCELERATOR_H_
+#define EQACCELERATOR_H_
+
+/*! extrapolation of the fire cycles of an eq run towards their fixed point
+ * \file
+ *
+ *  an eq run repeats the same fire cycle (FRI years) over and over, so the state at the end of
+ *  a cycle is a map of the state at the end of the one before, x(k+1) = G(x(k)), and the slow
+ *  pools go to its fixed point about geometrically. With 'eqaccel aitken' or 'eqaccel anderson'
+ *  in the control file, the states at the ends of the last cycles are extrapolated, and the
+ *  next cycle goes on from the extrapolated state:
+ *     aitken   - each variable by itself, from the last 2 cycles (Aitken's delta-squared on
+ *                plain cycles, the secant method in general)
+ *     anderson - all together, mixing the last EQACC_DEPTH+1 cycles (Anderson mixing), as
+ *                the variables of a soil column do not go each its own way
+ *
+ *  the state is that of the restart record (Cohort::updateRestartOutputBuffer): the reactive
+ *  and nonreactive soil C of each soil layer, the soil organic and available N, the standing
+ *  dead C and N, the woody debris, and the temperatures of the rock layers.
+ *
+ *  an extrapolation is not used (the cycle as run is, a plain cycle) if it has values not
+ *  finite or pools under 0, if the C, N or temperatures move more than EQACC_MAXSTEP times
+ *  their change over the last cycle, or if it adds C or N the other way than, or more than
+ *  1+EQACC_MASSTOL times, the totals extrapolated by themselves (beyond EQACC_MASSMIN of the
+ *  totals) - and the cycles before are forgotten. The layers must be the same over the cycles
+ *  mixed.
+ *
+ *  the run stops early once the soil C is within 'eqsettle' of its eq (see
+ *  RunCohort::runEquilibrium). With the default eq run of 4 fire cycles (FRI 2000) that is not
+ *  before its end: the extrapolation makes the eq state more accurate, but the run no shorter.
+ */
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <algorithm>
+using namespace std;
+
+#include "../data/RestartData.h"
+#include "../inc/layerconst.h"
+
+const int EQACC_DEPTH      = 2;     //cycles mixed by 'anderson', besides the last one
+const double EQACC_RMAX    = 0.95;  //largest ratio of the changes of two cycles extrapolated
+const double EQACC_MAXSTEP = 20.;   //largest move of the C, N or temperatures, in their change over the last cycle
+const double EQACC_MASSTOL = 1.;    //of the C and N added by the extrapolation
+const double EQACC_MASSMIN = 1.e-3; //of the total C or N, added by any extrapolation
+
+class EqAccelerator{
+	public:
+		EqAccelerator();
+		~EqAccelerator();
+
+		void setMode(const string & mode);  //'aitken', 'anderson', or "" (none)
+		bool isOn();
+
+		void reset();                       //for a new eq run
+
+		//'state' at the end of a fire cycle; true if changed to the state to go on from
+		bool endOfCycle(RestartData & state);
+
+		int nextrap;                        //extrapolations used, over all eq runs
+		int nreject;                        //and not used
+
+	private:
+
+		int mode;                           //0 - none, 1 - aitken, 2 - anderson
+
+		vector<int> layout;                 //of the layers of the states below
+		vector<char> kind;                  //of each variable: 'C', 'N', or 'T'
+		vector<double> xcurr;               //the state the last cycle started from
+		vector<vector<double> > xs;         //the states the cycles started from,
+		vector<vector<double> > gs;         //and the ones they ended with (the last one last)
+
+		void pack(const RestartData & state, vector<double> & x, vector<int> & lay);
+		void unpack(const vector<double> & x, RestartData & state);
+
+		bool extrapolate(vector<double> & xnew);
+		bool aitken(vector<double> & xnew);
+		bool anderson(vector<double> & xnew);
+		bool safe(const vector<double> & xnew);
+		double total(const vector<double> & x, const char & k);
+
+};
+
+#endif /*EQACCELERATOR_H_*/
@@ -0,0 +1,104 @@
+#include "EqLibrary.h"
+
+// the records of a bucket against a tair
+struct TairOrder{
+	const vector<EqFeatures> & feats;
+	TairOrder(const vector<EqFeatures> & f) : feats(f) {};
+	bool operator()(const int & i, const float & tair) const { return feats[i].tair<tair; };
+	bool operator()(const float & tair, const int & i) const { return tair<feats[i].tair; };
+};
+
+EqLibrary::EqLibrary(){
+
+};
+
+EqLibrary::~EqLibrary(){
+
+};
+
+EqFeatures EqLibrary::featuresOf(ClimateSource * clm, GridData * gd,
+		const int & vegtype, const int & drgtype){
+	EqFeatures feat;
+	feat.vegtype = vegtype;
+	feat.drgtype = drgtype;
+
+	//the years averaged in Atmosphere::makeEqDrivingData
+	int nyr = min(MAX_ATM_NOM_YR, clm->years());
+	double ta   = 0.;
+	double prec = 0.;
+	for (int iy=0; iy<nyr; iy++) {
+		for (int im=0; im<12; im++) {
+			ta   += clm->get(CLM_TAIR, iy, im);
+			prec += clm->get(CLM_PREC, iy, im);
+		}
+	}
+	feat.tair = nyr>0 ? ta/(nyr*12) : 0.;
+	feat.prec = nyr>0 ? prec/nyr : 0.;
+
+	feat.clay[0] = gd->topclay;
+	feat.clay[1] = gd->botclay;
+	feat.sand[0] = gd->topsand;
+	feat.sand[1] = gd->botsand;
+
+	return feat;
+};
+
+void EqLibrary::add(const EqFeatures & feat, const RestartData & state){
+	feats.push_back(feat);
+	states.push_back(state);
+
+	vector<int> & bucket = buckets[make_pair(feat.vegtype, feat.drgtype)];
+	bucket.insert(upper_bound(bucket.begin(), bucket.end(), feat.tair, TairOrder(feats)), feats.size()-1);
+};
+
+// the first of the records at the least distance, as over all of them in the order added
+const RestartData * EqLibrary::nearest(const EqFeatures & feat){
+	map<pair<int, int>, vector<int> >::iterator ib = buckets.find(make_pair(feat.vegtype, feat.drgtype));
+	if (ib==buckets.end()) return NULL;
+	const vector<int> & bucket = ib->second;
+
+	int nb = bucket.size();
+	int iup = lower_bound(bucket.begin(), bucket.end(), feat.tair, TairOrder(feats))-bucket.begin();
+	int idn = iup-1;
+
+	int inear = -1;
+	float dnear = 0.;
+	while (idn>=0 || iup<nb) {
+		//the side nearer in tair first
+		int ir;
+		if (iup>=nb || (idn>=0 && feat.tair-feats[bucket[idn]].tair<feats[bucket[iup]].tair-feat.tair)) {
+			ir = bucket[idn--];
+		} else {
+			ir = bucket[iup++];
+		}
+
+		//the rest are further in tair alone (a little slack for the rounding of distance())
+		float dt = fabs(feats[ir].tair-feat.tair)/EQLIB_DTAIR;
+		if (inear>=0 && dt>dnear*1.0001f) break;
+
+		float d = distance(feats[ir], feat);
+		if (inear<0 || d<dnear || (d==dnear && ir<inear)) {
+			inear = ir;
+			dnear = d;
+		}
+	}
+
+	return inear>=0 ? &states[inear] : NULL;
+};
+
+int EqLibrary::size(){
+	return feats.size();
+};
+
+float EqLibrary::distance(const EqFeatures & a, const EqFeatures & b){
+	float d2 = 0.;
+	float dt = (a.tair-b.tair)/EQLIB_DTAIR;
+	float dp = (a.prec-b.prec)/EQLIB_DPREC;
+	d2 += dt*dt+dp*dp;
+	for (int i=0; i<2; i++) {
+		float dc = (a.clay[i]-b.clay[i])/EQLIB_DTEXTURE;
+		float ds = (a.sand[i]-b.sand[i])/EQLIB_DTEXTURE;
+		d2 += dc*dc+ds*ds;
+	}
+	return sqrt(d2);
+};
@@ -0,0 +1,68 @@
+#ifndef EQLIBRARY_H_
+#define EQLIBRARY_H_
+
+/*! the eq states of cohorts already equilibrated, to start the eq run of a similar cohort from
+ * \file
+ *
+ *  with 'eqwarmstart <restart-eq.nc>' (or 'eqwarmstart run') in the control file, the eq run
+ *  of a cohort starts from the eq state of the most similar cohort in the library - of an
+ *  earlier eq run, or equilibrated before in this run - instead of the lookup initial state.
+ *  The layer structure and the pools come through the restart path (Cohort::reset), with the
+ *  soil texture of the cohort's own grid.
+ *
+ *  a similar cohort has the same vegetation and drainage types; of those the nearest in
+ *  (annual mean air temperature of the eq climate)/EQLIB_DTAIR, (annual precipitation)/
+ *  EQLIB_DPREC and (top and bottom clay and sand)/EQLIB_DTEXTURE. The states are kept in
+ *  buckets of the two types, in the order of their tair, so the search goes out from the
+ *  cohort's tair until that alone is further than the nearest so far.
+ */
+
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cmath>
+using namespace std;
+
+#include "../data/RestartData.h"
+#include "../data/GridData.h"
+#include "../data/ClimateSource.h"
+#include "../inc/timeconst.h"
+
+const float EQLIB_DTAIR    = 1.;     //degC
+const float EQLIB_DPREC    = 100.;   //mm/yr
+const float EQLIB_DTEXTURE = 10.;    //%
+
+struct EqFeatures{
+	int vegtype;
+	int drgtype;
+	float tair;      //annual mean of the eq climate (the first MAX_ATM_NOM_YR yrs)
+	float prec;      //annual total
+	float clay[2];   //top, bottom
+	float sand[2];
+};
+
+class EqLibrary{
+	public:
+		EqLibrary();
+		~EqLibrary();
+
+		//of the grid set up by Grid::reinit, with its climate as the atmosphere reads it
+		static EqFeatures featuresOf(ClimateSource * clm, GridData * gd,
+				const int & vegtype, const int & drgtype);
+
+		void add(const EqFeatures & feat, const RestartData & state);
+		//NULL if none of the same vegetation and drainage types; valid until the next add()
+		const RestartData * nearest(const EqFeatures & feat);
+		int size();
+
+	private:
+
+		vector<EqFeatures> feats;
+		vector<RestartData> states;
+		map<pair<int, int>, vector<int> > buckets;   //(vegtype, drgtype) -> records, by tair
+
+		static float distance(const EqFeatures & a, const EqFeatures & b);
+
+};
+
+#endif /*EQLIBRARY_H_*/
@@ -23,6 +23,25 @@ void Regioner::init(string& controlfile){
  		md.checking4run();
  
  		fd.useseverity = md.useseverity;
+
+ 		Logger::level = md.loglevel;
+
+ 		//optional timeline of the run
+ 		TraceRecorder::enable(md.tracefile, md.tracebuffer);
+
+ 		//optional status file of the run's progress
+ 		ProgressReporter::enable(md.progressfile, md.progressinterval);
+
+ 		//optional snapshots of the monthly bgc integration
+ 		IntegratorDump::enable(md.integdumpfile, md.integdumpmax);
+
+ 		//optional binary pack of all netcdf inputs
+ 		if (md.inputpack!="") {
+ 			inpack.open(md.inputpack, md.runstages);
+ 			rin.setInputPack(&inpack);
+ 			gin.setInputPack(&inpack);
+ 			cin.setInputPack(&inpack);
+ 		}
  		
  		md.consoledebug = true;
  		//create a list of cohort id, each process should run through all cohorts in the list
@@ -44,11 +63,12 @@ void Regioner::init(string& controlfile){
 	 		runcht.setSiteinInputer(&sitein);
  		} else if(md.initmode==3){
 		 	if(md.runeq){
-		 		cout <<"cannot set initmode as restart for equlibrium run  \n";
-		 		cout <<"reset to 'lookup'\n";
+		 		LOG(LOG_WARN) <<"cannot set initmode as restart for equlibrium run  \n";
+		 		LOG(LOG_WARN) <<"reset to 'lookup'\n";
 		 		md.initmode=1;
 		 	} else {
  		 		resin.init(md.initialfile);
+ 		 		resin.setBlockSize(md.restartblock);
  		 		runcht.setRestartInputer(&resin);
  		 	}
  		} else {
@@ -101,17 +121,41 @@ void Regioner::init(string& controlfile){
  		}
  		resout.setRestartOutData(&resod);
 		resout.init(md.outputdir, stage, md.numprocs, md.myid);
+		resout.setBlockSize(md.restartblock);
  		runcht.cht.setRestartOutData(&resod);
  		runcht.setRestartOutputer(&resout);
 
  		//error output
 		errout.init(md.outputdir, md.myid, stage);
 
+ 		//solver statistics output
+		solout.init(md.outputdir, md.myid, stage);
+		runcht.setSolverOutputer(&solout);
+
  		//set up data (inputs and processes) connecntion (initialization)
 		bd.setEnvData(&ed);
 		rgrid.setEnvData(&ed);
  		rgrid.setRegionData(&rd);
  		rgrid.setGridData(&gd);
+ 		rgrid.atm.setDayWindow(md.daydrivermonth);
+
+ 		//optional climate scenario on top of the grid climate
+ 		if (md.clmscenario!="") {
+ 			clmscen.read(md.clmscenario);
+ 			rgrid.setClimateScenario(&clmscen);
+ 		}
+
+ 		//optional climate read a window of years at a time, the scenario applied to each
+ 		if (gin.getClimateStream()!=NULL) {
+ 			if (md.clmscenario!="") gin.getClimateStream()->setClimateScenario(&clmscen);
+ 			rgrid.setClimateSource(gin.getClimateStream());
+ 		}
+
+ 		//optional cache of the derived climate drivers, kept between runs
+ 		if (md.drivercache!="") {
+ 			drvcache.setDirectory(md.drivercache);
+ 			rgrid.atm.setDriverCache(&drvcache);
+ 		}
 
  		runcht.cht.setTime(&timer);
  		runcht.cht.setProcessData(&ed, &bd, &fd);
@@ -123,7 +167,7 @@ void Regioner::init(string& controlfile){
   		runcht.cht.init(); //after set everying
 
 	}catch (Exception &exception){
-  		cout <<"problem in initialize in Regioner::init\n";
+  		LOG(LOG_ERROR) <<"problem in initialize in Regioner::init\n";
   		exception.mesg();
   		exit(-1);
 	}
@@ -132,13 +176,36 @@ void Regioner::init(string& controlfile){
 
 
 void Regioner::run(){
+	PHASE_SCOPE("Regioner::run");
 	
 	//error initialization
 	int errcount = 0;
 	errout.errorid = 0;
+	groupEqCohorts();
+	loadEqLibrary();
 	list<int>::iterator jj ; 
+	ProgressReporter::begin(md.runstages, runchtlist.size());
 	for ( jj=runchtlist.begin() ; jj!=runchtlist.end(); jj++){
 		int chtid = *jj;
+		PROGRESS_COHORT(chtid, errcount, runcht.monthcount);
+		Logger::flush();       //the messages of the previous cohort
+	#ifdef PHASETIMER
+		PhaseTimer::beginCohort(chtid);
+	#endif
+		TraceRecorder::instant("cohort", "chtid", chtid);
+		IntegratorDump::setCohort(chtid);
+
+		//same eq inputs as a cohort run before: its restart record, with this chtid
+		map<int, int>::iterator il = eqleader.find(chtid);
+		if (il!=eqleader.end() && eqresult.count(il->second)>0) {
+			resod = eqresult[il->second];
+			resod.chtid = chtid;
+			resout.outputVariables(runcht.cohortcount);
+			if (--eqmembers[il->second]==0) eqresult.erase(il->second);
+
+			runcht.cohortcount++;
+			continue;
+		}
 		
 		// clean-up and re-setup for the next cohort (Yuan: July 13, 2012)
 		gd = GridData();
@@ -175,6 +242,7 @@ void Regioner::run(){
 		int rescid = 0; //the record order in the input files, NOT the cohort ID (chtid)
 
 		try {
+			PHASE_SCOPE("cohort IDs");
 
 			//for regional run, only one of the following can be true;
 			if(md.runeq){
@@ -259,7 +327,7 @@ void Regioner::run(){
 			errcount+=1;
 
 			if(md.consoledebug){
-				cout <<"problem in setting IDs in Regioner::run\n";
+				LOG(LOG_ERROR) <<"problem in setting IDs in Regioner::run\n";
 				exception.mesg();
 			}
 
@@ -276,13 +344,14 @@ void Regioner::run(){
 				gd.gid=grdrecid;
 
 				gin.getGridData(&gd, grdrecid, clmrecid);
+				gd.clmid = cd.clmid;
    				error = rgrid.reinit(grdrecid); //reinit for a new grid
    				
 				if (error!=0) {
 
     					if(md.consoledebug){
-    						cout <<"problem in grid data in Regioner::run\n";
-    						cout <<"error = "<<error<<"\n";
+    						LOG(LOG_ERROR) <<"problem in grid data in Regioner::run\n";
+    						LOG(LOG_ERROR) <<"error = "<<error<<"\n";
     					}
 
     		    			errout.errorid = -3;
@@ -295,7 +364,7 @@ void Regioner::run(){
 	    		} catch (Exception &exception){
 				exception.mesg();
 				if(md.consoledebug){
-					cout <<"problem in reinitializing grid in Regioner::run\n";
+					LOG(LOG_ERROR) <<"problem in reinitializing grid in Regioner::run\n";
 				}
 
 	    			errout.errorid = -3;
@@ -307,17 +376,30 @@ void Regioner::run(){
  	    		}
  
 	    		//cohort-level data for a cohort
+			//eq from the eq state of the most similar cohort equilibrated before
+			EqFeatures eqfeat;
+			runcht.setWarmStart(NULL);
+			if (md.runeq && md.eqwarmstart!="") {
+				int vegtype = -1;
+				int drgtype = -1;
+				cin.getVegetation(vegtype, eqcid);
+				cin.getDrainage(drgtype, eqcid);
+				eqfeat = EqLibrary::featuresOf(rgrid.clmsrc, &gd, vegtype, drgtype);
+				runcht.setWarmStart(eqlib.nearest(eqfeat));
+			}
+
 			runcht.jcalifilein=true;  // for reading Jcalinput.txt, the default is true (must be done before re-initiation)
 			runcht.jcalparfile="";
 			runcht.ccdriverout=false;  //don't change to true for regioner
 
 
+			PROGRESS_STAGE("reinit");
 			error = runcht.reinit(cid, eqcid, rescid); //reinit for a new cohort
 
 			//run a cohort
    			try {
   				if (error!=0) {
-   					cout<<"Error for reinitializing cohort: "<<chtid<<" - SKIPPED! \n";
+   					LOG(LOG_ERROR) <<"Error for reinitializing cohort: "<<chtid<<" - SKIPPED! \n";
 
    					errout.errorid = -5;
     					errout.outputVariables(errcount);
@@ -326,11 +408,14 @@ void Regioner::run(){
 					continue;     //jump over to next cohort, due to cohort reinit error
 
   				} else {
-    					if (md.consoledebug) cout<<"cohort: "<<chtid<<" @ "<<md.runstages<<" - running! \n";
+    					if (md.consoledebug) {
+    						LOG(LOG_INFO) <<"cohort: "<<chtid<<" @ "<<md.runstages<<" - running! \n";
+    					}
+    					PROGRESS_STAGE("run");
     					error = runcht.run();
       					if (error!=0) {
       	    					if(md.consoledebug){
-      	    						cout<<"problem in running cohort in Regioner::run \n";
+      	    						LOG(LOG_ERROR) <<"problem in running cohort in Regioner::run \n";
       	    					}
 
        						rout.missingValues(MAX_OREGN_YR, runcht.cohortcount);
@@ -341,12 +426,16 @@ void Regioner::run(){
 
     						continue;     //jump over to next cohort, due to run cohort error
       					}
+
+      					//kept for the cohorts of the same eq inputs
+      					if (eqmembers.count(chtid)>0 && !runcht.cht.failed) eqresult[chtid] = resod;
+      					if (md.runeq && md.eqwarmstart!="" && !runcht.cht.failed) eqlib.add(eqfeat, resod);
     				}
 
     			} catch (Exception &exception){
 				exception.mesg();
     				if(md.consoledebug){
-    					cout <<"problem in running cohort in Regioner::run\n";
+    					LOG(LOG_ERROR) <<"problem in running cohort in Regioner::run\n";
     				}
 
     				rout.missingValues(MAX_OREGN_YR, runcht.cohortcount);
@@ -360,7 +449,7 @@ void Regioner::run(){
     			}
 
 		} else { // end of cruid >=0 && other IDs>=0
-			cout<<"No grid exists for cohort: "<<chtid<<" - SKIPPED! \n";
+			LOG(LOG_ERROR) <<"No grid exists for cohort: "<<chtid<<" - SKIPPED! \n";
 
 			rout.missingValues(MAX_OREGN_YR, runcht.cohortcount);
 
@@ -372,7 +461,156 @@ void Regioner::run(){
 		runcht.cohortcount++;
 		 
 	}// end of cohort loop
-	
+
+	resout.flush();
+	ProgressReporter::end();
+
+	if (md.runeq && md.eqwarmstart!="") {
+		LOG(LOG_INFO) <<"eqwarmstart: "<<runcht.warmcount<<" eq runs from a similar cohort, "
+				<<runcht.eqyearcount<<" eq years run\n";
+	}
+	if (md.runeq && md.eqaccel!="") {
+		LOG(LOG_INFO) <<"eqaccel: "<<runcht.accel.nextrap<<" fire cycles extrapolated ("<<md.eqaccel<<"), "
+				<<runcht.accel.nreject<<" not, "<<runcht.eqyearcount<<" eq years run\n";
+	}
+
+	#ifdef PHASETIMER
+		PhaseTimer::write(md.outputdir+"phasetimer.txt");
+	#endif
+		TraceRecorder::write();
+		IntegratorDump::close();
+
+};
+
+// 'eqdedup on': the eq state of a cohort depends only on its climate cell (the eq climate is
+// of the cell's first years), its vegetation and drainage types (and the calibrated
+// parameters of the types), and the latitude, soil texture and topography of its grid - FRI is
+// 2000 in Grid::reinit, and the fire data are the same for all grids. So of the cohorts with
+// all of these the same, only the first in runchtlist is run, and its eq restart record is
+// written for the others too (with their chtid). Only with 'lookup' initial conditions, as
+// 'sitein' ones are of each cohort.
+void Regioner::groupEqCohorts(){
+	PHASE_SCOPE("Regioner::groupEqCohorts");
+
+	eqleader.clear();
+	eqmembers.clear();
+	eqresult.clear();
+	if (!md.runeq || !md.eqdedup) return;
+	if (md.initmode!=1) {
+		LOG(LOG_WARN) <<"eqdedup is only for 'lookup' initial conditions - each cohort run\n";
+		return;
+	}
+
+	map<EqSignature, int> groups;   //-> chtid of the first cohort
+	list<int>::iterator jj;
+	for (jj=runchtlist.begin(); jj!=runchtlist.end(); jj++) {
+		int chtid = *jj;
+
+		EqSignature sig;
+		memset(&sig, 0, sizeof(EqSignature));
+		try {
+			int eqcid = cin.getEqRecID(chtid);
+			if (eqcid<0) continue;
+			int grdid = -1;
+			cin.getGrdID(grdid, eqcid);
+			cin.getClmID(sig.clmid, eqcid);
+			cin.getVegetation(sig.vegtype, eqcid);
+			cin.getDrainage(sig.drgtype, eqcid);
+			int grdrecid = gin.getGridRecID(grdid);
+			if (grdrecid<0) continue;
+
+			gin.getGridSite(&gd, grdrecid);
+		} catch (Exception &exception) {
+			continue;     //run by itself, and its error reported then
+		}
+		sig.lat = gd.lat;
+		sig.texture[0] = gd.topclay;
+		sig.texture[1] = gd.topsand;
+		sig.texture[2] = gd.topsilt;
+		sig.texture[3] = gd.botclay;
+		sig.texture[4] = gd.botsand;
+		sig.texture[5] = gd.botsilt;
+		sig.topo[0] = gd.elevation;
+		sig.topo[1] = gd.slope;
+		sig.topo[2] = gd.aspect;
+		sig.topo[3] = gd.flowacc;
+
+		map<EqSignature, int>::iterator ig = groups.find(sig);
+		if (ig==groups.end()) {
+			groups[sig] = chtid;
+		} else {
+			eqleader[chtid] = ig->second;
+			eqmembers[ig->second]++;
+		}
+	}
+
+	int ncht = runchtlist.size();
+	int nrun = ncht-eqleader.size();
+	LOG(LOG_INFO) <<"eqdedup: "<<nrun<<" eq runs for "<<ncht<<" cohorts ("
+			<<(nrun>0 ? (double)ncht/nrun : 0.)<<" cohorts per run)\n";
+
+};
+
+// 'eqwarmstart <restart-eq.nc>': the eq states of an earlier run, of the cohorts still in the
+// eq inputs of this run (as their features are of these inputs); 'eqwarmstart run': none, only
+// the states of the cohorts equilibrated in this run. Not for 'sitein' initial conditions.
+void Regioner::loadEqLibrary(){
+	PHASE_SCOPE("Regioner::loadEqLibrary");
+
+	if (!md.runeq || md.eqwarmstart=="") return;
+	if (md.initmode!=1) {
+		LOG(LOG_WARN) <<"eqwarmstart is only for 'lookup' initial conditions - not used\n";
+		md.eqwarmstart = "";
+		return;
+	}
+	if (md.eqwarmstart=="run") return;
+
+	RestartInputer libin;
+	try {
+		libin.init(md.eqwarmstart);
+	} catch (Exception &exception) {
+		exception.mesg();
+		LOG(LOG_WARN) <<"eqwarmstart: cannot read "<<md.eqwarmstart<<" - from the states of this run only\n";
+		return;
+	}
+
+	for (int irec=0; irec<libin.getNumRecords(); irec++) {
+		try {
+			int chtid   = -1;
+			int errcode = -1;
+			libin.getChtId(chtid, irec);
+			libin.getERRCODE(errcode, irec);
+			if (errcode!=0) continue;
+
+			int eqcid = cin.getEqRecID(chtid);
+			if (eqcid<0) continue;
+			int vegtype = -1;
+			int drgtype = -1;
+			int grdid   = -1;
+			int clmid   = -1;
+			cin.getVegetation(vegtype, eqcid);
+			cin.getDrainage(drgtype, eqcid);
+			cin.getGrdID(grdid, eqcid);
+			cin.getClmID(clmid, eqcid);
+			int grdrecid = gin.getGridRecID(grdid);
+			int clmrecid = gin.getClmRecID(clmid);
+			if (grdrecid<0 || clmrecid<0) continue;
+
+			gd = GridData();
+			gin.getGridData(&gd, grdrecid, clmrecid);
+			gd.clmid = clmid;
+			if (rgrid.reinit(grdrecid)!=0) continue;
+
+			RestartData state;
+			libin.getRecord(state, irec);
+			eqlib.add(EqLibrary::featuresOf(rgrid.clmsrc, &gd, vegtype, drgtype), state);
+		} catch (Exception &exception) {
+			continue;     //not in the library
+		}
+	}
+
+	LOG(LOG_INFO) <<"eqwarmstart: "<<eqlib.size()<<" eq states from "<<md.eqwarmstart<<"\n";
+
 };
 
 void Regioner::createCohorList4Run(){
@@ -418,8 +656,8 @@ void Regioner::createCohorList4Run(){
 	   	if (i==numcht-1) chtidx=chtid;
    	}
 
-	cout <<md.casename << ": " <<numcht <<"  cohorts to be run @" <<md.runstages<< "\n";
-	cout <<"   from:  " <<chtid0<<"  to:  " <<chtidx <<"\n";
+	LOG(LOG_INFO) <<md.casename << ": " <<numcht <<"  cohorts to be run @" <<md.runstages<< "\n";
+	LOG(LOG_INFO) <<"   from:  " <<chtid0<<"  to:  " <<chtidx <<"\n";
    
 };
 
@@ -431,7 +669,7 @@ void Regioner::createOutvarList(string & txtfile){
  	fctr.open(outvarfile.c_str(),ios::in );
  	bool isOpen = fctr.is_open();
     if ( !isOpen ) {
-      	cout << "\nCannot open " << outvarfile << "  \n" ;
+      	LOG(LOG_ERROR) << "\nCannot open " << outvarfile << "  \n" ;
       	exit( -2 );
     }
 
@@ -447,6 +685,41 @@ void Regioner::createOutvarList(string & txtfile){
 
  	fctr.close();
 
+ 	// optional lossy quantization of output variables, in the same directory as the outvarlist file,
+ 	// one line per quantized variable:  'ivar  mode  min  max  nsd'
+ 	//   mode 1 - packed into int16 over [min, max], absolute error <= (max-min)/131064
+ 	//   mode 2 - bit-rounding, keeping 'nsd' significant digits
+ 	string qntfile = outvarfile.substr(0, outvarfile.find_last_of("/")+1)+"outvarqnt.txt";
+
+ 	ifstream fqnt;
+ 	fqnt.open(qntfile.c_str(), ios::in);
+ 	if (!fqnt.is_open()) return;
+
+ 	string line;
+ 	while (getline(fqnt, line)) {
+ 		if (line.empty() || line[0]=='#') continue;
+
+ 		istringstream sline(line);
+ 		int ivar = -1;
+ 		int mode = 0;
+ 		float qmin = 0.;
+ 		float qmax = 0.;
+ 		int nsd = 0;
+ 		sline >> ivar >> mode >> qmin >> qmax >> nsd;
+ 		if (sline.fail() || ivar<0 || ivar>=64) continue;
+
+ 		if ((mode==1 && qmax>qmin) || (mode==2 && nsd>=1 && nsd<=7)) {
+ 			regnod.outvarqnt[ivar]  = mode;
+ 			regnod.outvarqmin[ivar] = qmin;
+ 			regnod.outvarqmax[ivar] = qmax;
+ 			regnod.outvarqnsd[ivar] = nsd;
+ 		} else {
+ 			LOG(LOG_WARN) <<"invalid quantization for output variable "<<ivar<<" in "<<qntfile<<" - not quantized\n";
+ 		}
+ 	}
+
+ 	fqnt.close();
+
 };
 
 
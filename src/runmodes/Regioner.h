@@ -8,11 +8,29 @@
     #include "../output/StatusOutputer.h"
 	
 	#include "RunCohort.h"
+	#include "EqLibrary.h"
+	#include "../util/ProgressReporter.h"
 
 	#include <algorithm> // copy algorithm
 	#include <iterator> // ostream_iterator
 	#include <list>
+	#include <map>
+	#include <cstring>
 	using namespace std;
+
+	//what the eq state of a cohort is made from (see Regioner::groupEqCohorts)
+	struct EqSignature{
+		int clmid;
+		int vegtype;
+		int drgtype;
+		float lat;
+		int texture[6];
+		float topo[4];
+
+		bool operator<(const EqSignature & b) const {
+			return memcmp(this, &b, sizeof(EqSignature))<0;
+		};
+	};
 	
 	class Regioner {
 		public:
@@ -27,6 +45,9 @@
 
     		void createOutvarList(string & txtfile);
 
+    		void groupEqCohorts();
+    		void loadEqLibrary();
+
 		private:
 
     		//Inptuer
@@ -34,6 +55,7 @@
    	    	RegionInputer rin;
     		GridInputer gin;
     		CohortInputer cin;
+    		InputPack inpack;
     		RestartInputer resin;
     		SiteinInputer sitein;
 
@@ -41,6 +63,7 @@
     		RestartOutputer resout;
     		RegnOutputer rout;
     		StatusOutputer errout;
+    		SolverOutputer solout;
 
     		int MAX_OREGN_YR;
     
@@ -63,8 +86,17 @@
 
    			//
 			Grid rgrid;
+			ClimateScenario clmscen;
+			DriverCache drvcache;
 			RunCohort runcht;
 
+			//cohorts taking the eq state of another (see groupEqCohorts)
+			map<int, int> eqleader;           //chtid -> chtid of the cohort run for it
+			map<int, int> eqmembers;          //chtid run -> its cohorts not yet written
+			map<int, RestartData> eqresult;   //chtid run -> its eq restart record
+
+			EqLibrary eqlib;                  //eq states to start from (see loadEqLibrary)
+
 	};
 
 #endif /*REGIONER_H_*/
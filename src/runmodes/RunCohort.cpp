@@ -10,8 +10,15 @@
 
 RunCohort::RunCohort(){
  	cohortcount = 0;
+ 	monthcount  = 0;
+ 	warmcount   = 0;
+ 	eqyearcount = 0;
+ 	warmstate   = NULL;
 	jcalifilein = true;    // switch for reading calibrated parameters; can be reset outside
 	ccdriverout = false;  // switch for output calirestart.nc; can be reset outside
+
+	solout   = NULL;
+	runstage = 0;
 }
 
 void RunCohort::setGridInputer(GridInputer * gin){
@@ -30,6 +37,10 @@ void RunCohort::setSiteinInputer(SiteinInputer * sin){
   	sinputer= sin;
 };
 
+void RunCohort::setWarmStart(const RestartData * eqstate){
+	warmstate = eqstate;
+};
+
 //ONLY update Calibrated Pars ONLY
 void RunCohort::setCalibrationParameters(CohortLookup* chtlu, string& jtxtfile){
 	
@@ -39,7 +50,7 @@ void RunCohort::setCalibrationParameters(CohortLookup* chtlu, string& jtxtfile){
  	fctr.open(califile.c_str(),ios::in );
  	bool isOpen = fctr.is_open();
     if ( !isOpen ) {
-      	cout << "\nCannot open " << califile << "  \n" ;
+      	LOG(LOG_ERROR) << "\nCannot open " << califile << "  \n" ;
       	exit( -1 );
     }
 
@@ -82,7 +93,7 @@ void RunCohort::setCalibrationInits(CohortLookup* chtlu, string& jtxtfile){
  	fctr.open(califile.c_str(),ios::in );
  	bool isOpen = fctr.is_open();
     if ( !isOpen ) {
-      	cout << "\nCannot open " << califile << "  \n" ;
+      	LOG(LOG_ERROR) << "\nCannot open " << califile << "  \n" ;
       	exit( -1 );
     }
 
@@ -119,11 +130,10 @@ void RunCohort::setCalibrationInits(CohortLookup* chtlu, string& jtxtfile){
 
 //when initializing a cohort, using its record ids RATHER THAN chtids
 int RunCohort::reinit(const int &cid, const int &eqcid, const int &rescid){
+	PHASE_SCOPE("RunCohort::reinit");
     // initializing module-calling controls     
 
-cout << "cid: " << cid << "\n";
-cout << "eqcid: " << eqcid << "\n";
-cout << "rescid: " << rescid << "\n";
+	LOG(LOG_DEBUG) <<"cid: "<<cid<<"\n"<<"eqcid: "<<eqcid<<"\n"<<"rescid: "<<rescid<<"\n";
 	
 	cht.equiled = false;
 	cht.spined = false;
@@ -148,7 +158,7 @@ cout << "rescid: " << rescid << "\n";
 	
 	if(cht.md->runsp){
 	    if (cid<0) return -4;
-		cinputer->getSpinupFire(cht.cd->spfiredate, cht.cd->spfiremonth, cht.cd->spfireyear, cht.cd->spfirearea,cid);
+		cinputer->getSpinupFire(cht.cd->spfire, cid);
 //		cinputer->getSpinupFireOccur(cht.cd->spfireyear,cid);
 //	  	cinputer->getSpinupFireSeason(cht.cd->spseason,cid);
 //	  	if(cht.fd->useseverity){
@@ -158,7 +168,7 @@ cout << "rescid: " << rescid << "\n";
 
 	if(cht.md->runtr){
 	    if (cid<0) return -5;
-		cinputer->getTransientFire(cht.cd->trfiredate, cht.cd->trfiremonth, cht.cd->trfireyear, cht.cd->trfirearea,cid);
+		cinputer->getTransientFire(cht.cd->trfire, cid);
 //		cinputer->getTransientFireOccur(cht.cd->trfireyear,cid);
 //	  	cinputer->getTransientFireSeason(cht.cd->trseason,cid);
 //	   	if(cht.fd->useseverity){
@@ -168,7 +178,7 @@ cout << "rescid: " << rescid << "\n";
 
 	if(cht.md->runsc){
 	    if (cid<0) return -5;
-		cinputer->getScenarioFire(cht.cd->scfiredate, cht.cd->scfiremonth, cht.cd->scfireyear, cht.cd->scfirearea,cid);
+		cinputer->getScenarioFire(cht.cd->scfire, cid);
 	 }
 
 	 // may update the calibrated pars from Jcalinput.txt file, which from calibration run
@@ -182,7 +192,7 @@ cout << "rescid: " << rescid << "\n";
 			
 		 setCalibrationParameters(&cht.chtlu, jcalparfile);
 		 if (cht.md->consoledebug) {
-			 cout<<"Cohort dependend parameters reading from: "+jcalparfile+"\n";
+			 LOG(LOG_DEBUG) <<"Cohort dependend parameters reading from: "+jcalparfile+"\n";
 		 }
 	 }
 	 //fire driving data 
@@ -200,118 +210,16 @@ cout << "rescid: " << rescid << "\n";
 		 resinputer->getERRCODE(errcode, rescid);
 		 if (errcode!=0) return -8;
 
-		 resinputer->getPERMAFROST(cht.resid.perma, rescid);
-//cout<<"cht.resid.perma: "<<cht.resid.perma<<"\n";		 	 
-		 resinputer->getDZsnow(cht.resid.DZsnow, rescid);
-//cout<<"cht.resid.DZsnow: "<<cht.resid.DZsnow<<"\n";		 	 
-		 resinputer->getTSsnow(cht.resid.TSsnow, rescid);
-//cout<<"cht.resid.TSsnow: "<< cht.resid.TSsnow <<"\n";		 	 
-		 resinputer->getICEsnow(cht.resid.ICEsnow, rescid);
-//cout<<"cht.resid.ICEsnow: "<< cht.resid.ICEsnow <<"\n";		 	 
-		 resinputer->getICEsnow(cht.resid.LIQsnow, rescid);
-//cout<<"cht.resid.LIQsnow: "<< cht.resid.LIQsnow <<"\n";		 	 
-		 resinputer->getAGEsnow(cht.resid.AGEsnow, rescid);
-//cout<<"cht.resid.AGEsnow: "<< cht.resid.AGEsnow <<"\n";		 	 
-		 resinputer->getRHOsnow(cht.resid.RHOsnow, rescid);
-//cout<<"cht.resid.RHOsnow: "<< cht.resid.RHOsnow <<"\n";		 	 
-		 
-		 resinputer->getTSsoil(cht.resid.TSsoil, rescid);
-//cout<<"cht.resid.TSsoil: "<< cht.resid.TSsoil <<"\n";		 	 
-		 resinputer->getDZsoil(cht.resid.DZsoil, rescid);
-//cout<<"cht.resid.DZsoil: "<< cht.resid.DZsoil <<"\n";		 	 
-		 resinputer->getLIQsoil(cht.resid.LIQsoil, rescid);
-//cout<<"cht.resid.LIQsoil: "<< cht.resid.LIQsoil <<"\n";		 	 
-		 resinputer->getICEsoil(cht.resid.ICEsoil, rescid);
-//cout<<"cht.resid.ICEsoil: "<< cht.resid.ICEsoil <<"\n";		 	 
-		 resinputer->getFROZENsoil(cht.resid.FROZENsoil, rescid);
-//cout<<"cht.resid.FROZENsoil: "<< cht.resid.FROZENsoil <<"\n";		 	 
-		 resinputer->getNONC(cht.resid.NONCsoil, rescid);
-//cout<<"cht.resid.NONCsoil: "<< cht.resid.NONCsoil <<"\n";		 	 
-		 resinputer->getREAC(cht.resid.REACsoil, rescid);
-//cout<<"cht.resid.REACsoil: "<< cht.resid.REACsoil <<"\n";		 	 
-		 resinputer->getTYPEsoil(cht.resid.TYPEsoil, rescid);
-//cout<<"cht.resid.TYPEsoil: "<< cht.resid.TYPEsoil <<"\n";		 	 
-		 resinputer->getCLAYmin(cht.resid.CLAYmin, rescid);
-cout<<"cht.resid.CLAYmin: "<< cht.resid.CLAYmin <<"\n";		 	 
-		 resinputer->getSANDmin(cht.resid.SANDmin, rescid);
-cout<<"cht.resid.SANDmin: "<< cht.resid.SANDmin <<"\n";		 	 
-		 resinputer->getSILTmin(cht.resid.SILTmin, rescid);
-cout<<"cht.resid.SILTmin: "<< cht.resid.SILTmin <<"\n";		 	 
-
-		 resinputer->getDZrock(cht.resid.DZrock, rescid);
-//cout<<"cht.resid.DZrock: "<< cht.resid.DZrock <<"\n";		 	 
-		 resinputer->getTSrock(cht.resid.TSrock, rescid);
-//cout<<"cht.resid.TSrock: "<< cht.resid.TSrock <<"\n";		 	 
-		 resinputer->getFrontZ(cht.resid.frontZ, rescid);
-//cout<<"cht.resid.frontZ: "<< cht.resid.frontZ <<"\n";		 	 
-		 resinputer->getFrontFT(cht.resid.frontFT, rescid);
-//cout<<"cht.resid.frontFT: "<< cht.resid.frontFT <<"\n";		 	 
-
-		 resinputer->getSOLN(cht.resid.soln, rescid);
-//cout<<"cht.resid.soln: "<< cht.resid.soln <<"\n";		 	 
-		 resinputer->getAVLN(cht.resid.avln, rescid);
-//cout<<"cht.resid.avln: "<< cht.resid.avln <<"\n";		 	 
-		 resinputer->getWDEBRIS(cht.resid.wdebris, rescid);
-//cout<<"cht.resid.wdebris: "<< cht.resid.wdebris <<"\n";		 	 
-		 resinputer->getSTRN(cht.resid.strn, rescid);
-//cout<<"cht.resid.strn: "<< cht.resid.strn <<"\n";		 	 
-		 resinputer->getSTON(cht.resid.ston, rescid);
-//cout<<"cht.resid.ston: "<< cht.resid.ston <<"\n";		 	 
-		 resinputer->getVEGC(cht.resid.vegc, rescid);
-//cout<<"cht.resid.vegc: "<< cht.resid.vegc <<"\n";		 	 
-		 resinputer->getDEADC(cht.resid.deadc, rescid);
-//cout<<"cht.resid.deadc: "<< cht.resid.deadc <<"\n";		 	 
-		 resinputer->getDEADN(cht.resid.deadn, rescid);
-//cout<<"cht.resid.deadn: "<< cht.resid.deadn <<"\n";		 	 
-		 
-		 resinputer->getPRVEETMX(cht.resid.prveetmx, rescid);
-//cout<<"cht.resid.prveetmx: "<< cht.resid.prveetmx <<"\n";		 	 
-		 resinputer->getPRVPETMX(cht.resid.prvpetmx, rescid);
-//cout<<"cht.resid.prvpetmx: "<< cht.resid.prvpetmx <<"\n";		 	 
-		 resinputer->getFOLIAGEMX(cht.resid.foliagemx, rescid);
-//cout<<"cht.resid.foliagemx: "<< cht.resid.foliagemx <<"\n";		 	 
-
-		 resinputer->getLAI(cht.resid.lai, rescid);
-//cout<<"cht.resid.lai: "<<  cht.resid.lai <<"\n";		 	 
-		 resinputer->getUNNORMLEAF(cht.resid.unnormleaf, rescid);
-//cout<<"cht.resid.unnormleaf: "<< cht.resid.unnormleaf <<"\n";		 	 
-		 resinputer->getPRVUNNORMLEAFMX(cht.resid.prvunnormleafmx, rescid);
-//cout<<"cht.resid.prvunnormleafmx: "<< cht.resid.prvunnormleafmx <<"\n";		 	 
-		 resinputer->getPRVTOPT(cht.resid.prvtopt, rescid);
-//cout<<"cht.resid.prvtopt: "<< cht.resid.prvtopt <<"\n";		 	 
-		 resinputer->getC2N(cht.resid.c2n, rescid);
-//cout<<"cht.resid.c2n: "<< cht.resid.c2n <<"\n";		 	 
-		 
-		 resinputer->getKDFIB(cht.resid.kdfib, rescid);
-//cout<<"cht.resid.kdfib: "<< cht.resid.kdfib <<"\n";		 	 
-		 resinputer->getKDHUM(cht.resid.kdhum, rescid);
-//cout<<"cht.resid.kdhum: "<< cht.resid.kdhum <<"\n";		 	 
-		 resinputer->getKDMIN(cht.resid.kdmin, rescid);
-//cout<<"cht.resid.kdmin: "<< cht.resid.kdmin <<"\n";		 	 
-		 resinputer->getKDSLOW(cht.resid.kdslow, rescid);
-//cout<<"cht.resid.kdslow: "<< cht.resid.kdslow <<"\n";		 	 
-
-//calpar.kdcfib; //resin->getKDFIB(bd->kdfib, ed->cd->reschtid);
-//calpar.kdchum;  //resin->getKDHUM(bd->kdhum, ed->cd->reschtid);
-//calpar.kdcmin;  //resin->getkdmin(bd->kdmin, ed->cd->reschtid);
-//calpar.kdcslow;  //resin->getkdlitter(bd->kdlitter, ed->cd->reschtid);
-
-		 
-		 resinputer->getYSF(cht.resid.ysf, rescid);
-//cout<<"cht.resid.ysf: "<< cht.resid.ysf <<"\n";		 	 
-		 resinputer->getBURNEDN(cht.resid.burnedn, rescid);
-//cout<<"cht.resid.burnedn: "<< cht.resid.burnedn <<"\n";		 	 
-
-		 resinputer->getTOPTA(cht.resid.toptA, rescid);
-//cout<<"cht.resid.toptA: "<< cht.resid.toptA <<"\n";		 	 
-		 resinputer->getEETMXA(cht.resid.eetmxA, rescid);
-//cout<<"cht.resid.eetmxA: "<< cht.resid.eetmxA <<"\n";		 	 
-		 resinputer->getPETMXA(cht.resid.petmxA, rescid);
-//cout<<"cht.resid.petmxA: "<< cht.resid.petmxA <<"\n";		 	 
-		 resinputer->getUNNORMLEAFMXA(cht.resid.unnormleafmxA, rescid);
-//cout<<"cht.resid.unnormleafmxA: "<< cht.resid.unnormleafmxA <<"\n";		 	 
+		 resinputer->getRecord(cht.resid, rescid);
 
 	 }
+	 //the eq state of a similar cohort, through the restart path (see EqLibrary)
+	 cht.warmstart = false;
+	 if (cht.md->runeq && warmstate!=NULL) {
+		 cht.resid = *warmstate;
+		 cht.warmstart = true;
+	 }
+
 	 //reset other initial state variables
 	 errcode = cht.reset();
 	 if (errcode != 0) return -9;
@@ -355,19 +263,25 @@ int RunCohort::run(){
 	try {
 	
 		if(cht.md->runeq){
+    			runstage = 0;
     			error = runEquilibrium();
+    			outputSolverStats();
 		    	if (error != 0) return error;
     			cht.updateRestartOutputBuffer(1);
 		}
 		
 		if(cht.md->runsp){
+    			runstage = 1;
     			error = runSpinup();
+    			outputSolverStats();
 		    	if (error != 0) return error;
     			cht.updateRestartOutputBuffer(2);
 		}
 		
 		if(cht.md->runtr){
+			runstage = 2;
 			error = runTransit();
+			outputSolverStats();
 	 		if (error != 0) return error;
 	 		cht.updateRestartOutputBuffer(3);
 		}
@@ -385,7 +299,9 @@ int RunCohort::run(){
 		}
 */
 		if(cht.md->runsc){
+			runstage = 3;
 			error = runScenario();
+			outputSolverStats();
 	 		if (error != 0) return error;
 	 		cht.updateRestartOutputBuffer(4);
 		}
@@ -395,10 +311,11 @@ int RunCohort::run(){
 		resout->outputVariables(cohortcount);
 	
   	} catch (Exception &exception){
-  		cout <<"problem in run for cohort"<<cohortcount<<"\n";
+  		LOG(LOG_ERROR) <<"problem in run for cohort"<<cohortcount<<"\n";
   		cht.failed =true;
   		cht.errorid = exception.getErrorCode();
   		exception.mesg();
+  		outputSolverStats();  // of the stage that failed
   	}
 
   	return 0;
@@ -406,6 +323,8 @@ int RunCohort::run(){
 }; 
 
 int RunCohort::runEquilibrium(){
+	PHASE_SCOPE("RunCohort::runEquilibrium");
+	TRACE_SCOPE("RunCohort::runEquilibrium");
 
 	int error = 0;
 
@@ -444,7 +363,7 @@ int RunCohort::runEquilibrium(){
 	   }
 
 	   if(cht.md->consoledebug) {
-		   cout <<" ENV module ONLY run: year "<<iy <<" @cohort "<<cht.cd->eqchtid<<"\n";
+		   LOG(LOG_DEBUG) <<" ENV module ONLY run: year "<<iy <<" @cohort "<<cht.cd->eqchtid<<"\n";
 	   }
 
 	} 
@@ -483,7 +402,7 @@ int RunCohort::runEquilibrium(){
   	   	cht.equiled = cht.testEquilibrium();
 
  		if(cht.md->consoledebug) {
- 			cout <<" ECO module ONLY run: year "<<iy <<" @cohort "<<cht.cd->eqchtid<<"\n";
+ 			LOG(LOG_DEBUG) <<" ECO module ONLY run: year "<<iy <<" @cohort "<<cht.cd->eqchtid<<"\n";
  		}
 		if(cht.equiled )break;
 
@@ -506,7 +425,25 @@ int RunCohort::runEquilibrium(){
   	                  // and the fire season/size use the FIRST one in the gd.season[]/gd.size[]
   	 int outputyrind = 0;
   	 int nfri = min((int)(MAX_EQ_YR/cht.fd->gd->fri), 15);   //max. 10000+1FRI yrs or 10 FRI
-	 for (int iy=0; iy<(nfri+1)*cht.fd->gd->fri-5; iy++){   //Yuan: -2 will make the final restart.nc not the fire year, but two years ago
+  	 int fri  = cht.fd->gd->fri;
+
+  	 int nyr  = (nfri+1)*fri-5;
+
+  	 // from the eq state of a similar cohort, or with the cycles extrapolated: the run stops at
+  	 // the end of a fire cycle (the year of the final restart.nc, of the last cycle) once the
+  	 // soil C is within md->eqsettle of its eq. The soil C g at the end of a cycle started from x
+  	 // goes to the eq about geometrically, g-eq = r*(x-eq), so eq-g = r/(1-r)*(g-x), with r the
+  	 // slope of g over x of the last 2 cycles (not the change over a cycle alone, as r is near 1
+  	 // for a slow soil) - from the second cycle, as the first one starts from a state of FRI-5
+  	 // years after a fire and has a first fire FRI years later
+  	 double cycsoilc = -1.;   //the soil C the cycle started from,
+  	 double prvsoilc = -1.;   //and the one the cycle before started from,
+  	 double prvendc  = -1.;   //and ended with
+  	 if (cht.warmstart) warmcount++;
+  	 accel.setMode(cht.md->eqaccel);
+  	 accel.reset();
+
+	 for (int iy=0; iy<nyr; iy++){   //Yuan: -2 will make the final restart.nc not the fire year, but two years ago
 //	 for (int iy=0; iy<MAX_EQ_YR; iy++){   //Yuan: -2 will make the final restart.nc not the fire year, but two years ago
 		 int yrcnt =iy;
 		 for (int im=0; im<12;im++){
@@ -526,10 +463,42 @@ int RunCohort::runEquilibrium(){
 		}
 
  		if(cht.md->consoledebug) {
- 			cout <<"Equilibrium run: year "<<iy <<" @cohort "<<cht.cd->eqchtid<<"\n";
+ 			LOG(LOG_DEBUG) <<"Equilibrium run: year "<<iy <<" @cohort "<<cht.cd->eqchtid<<"\n";
  		}
 
  		outputyrind++;
+ 		eqyearcount++;
+
+ 		if ((cht.warmstart || accel.isOn()) && (iy+6)%fri==0) {
+ 			double soilc = 0.;
+ 			for (int il=0; il<MAX_SOI_LAY; il++) {
+ 				if (cht.resod->TYPEsoil[il]>=0) soilc += cht.resod->REACsoil[il]+cht.resod->NONCsoil[il];
+ 			}
+ 			if (prvsoilc>0. && cycsoilc!=prvsoilc && cht.md->eqsettle>0.) {
+ 				double r = (soilc-prvendc)/(cycsoilc-prvsoilc);
+ 				if (r>=0. && r<1. && r/(1.-r)*fabs(soilc-cycsoilc)<=cht.md->eqsettle*soilc) {
+ 					LOG(LOG_DEBUG) <<"Equilibrium run: soil C settled in "<<iy+1<<" years @cohort "<<cht.cd->eqchtid<<"\n";
+ 					break;
+ 				}
+ 			}
+ 			if (cycsoilc>0.) {
+ 				prvsoilc = cycsoilc;
+ 				prvendc  = soilc;
+ 			}
+
+ 			//the next cycle from the state extrapolated from the cycles so far (not the last one,
+ 			//so the final restart.nc is a state run into)
+ 			RestartData next = *cht.resod;
+ 			if (iy+1<nyr && accel.endOfCycle(next)) {
+ 				cht.setEqCycleState(&next);
+ 				cht.updateRestartOutputBuffer(1);
+ 				soilc = 0.;
+ 				for (int il=0; il<MAX_SOI_LAY; il++) {
+ 					if (cht.resod->TYPEsoil[il]>=0) soilc += cht.resod->REACsoil[il]+cht.resod->NONCsoil[il];
+ 				}
+ 			}
+ 			cycsoilc = soilc;
+ 		}
 	}
 
 	 return 0;
@@ -537,6 +506,8 @@ int RunCohort::runEquilibrium(){
 };
 
 int RunCohort::runSpinup(){
+	PHASE_SCOPE("RunCohort::runSpinup");
+	TRACE_SCOPE("RunCohort::runSpinup");
 
 	int error = 0;
 
@@ -576,7 +547,7 @@ int RunCohort::runSpinup(){
 			rout->outputYearCohortVars(outputyrind, cohortcount);
 		}
 		if(cht.md->consoledebug){	
-			cout <<"Spinup run: year " <<cht.timer->getCalendarYear(cht.equiled, cht.spined)-1
+			LOG(LOG_DEBUG) <<"Spinup run: year " <<cht.timer->getCalendarYear(cht.equiled, cht.spined)-1
 	    	     	<<" @cohort "<<cht.cd->spchtid<<"\n";
 		}
 	}
@@ -587,6 +558,8 @@ return 0;
 };
 
 int RunCohort::runTransit(){
+	PHASE_SCOPE("RunCohort::runTransit");
+	TRACE_SCOPE("RunCohort::runTransit");
 
 	int error = 0;
 
@@ -635,7 +608,7 @@ int RunCohort::runTransit(){
 		}
 
 	    if(cht.md->consoledebug){
-	    	cout <<"Transient run: year " 
+	    	LOG(LOG_DEBUG) <<"Transient run: year " 
 	    	<<cht.timer->getCalendarYear(cht.equiled, cht.spined)-1
 	    	<<" @cohort "<<cht.cd->trchtid<<"\n";
 	    }
@@ -648,6 +621,8 @@ int RunCohort::runTransit(){
 };
 
 int RunCohort::runScenario(){
+	PHASE_SCOPE("RunCohort::runScenario");
+	TRACE_SCOPE("RunCohort::runScenario");
 
 	int error = 0;
 
@@ -697,7 +672,7 @@ int RunCohort::runScenario(){
 		}
 
 	    if(cht.md->consoledebug){
-	    	cout <<"Scenario run: year "
+	    	LOG(LOG_DEBUG) <<"Scenario run: year "
 	    	<<iy
 	    	<<" @cohort "<<cht.cd->trchtid<<"\n";
 	    }
@@ -709,6 +684,7 @@ int RunCohort::runScenario(){
 };
 
 void RunCohort::siteoutput(const int & outputyrind, const int & currmind){
+	TRACE_SCOPE("RunCohort::siteoutput");
 
   	if(currmind==11){//end ofyear
   	
@@ -758,3 +734,28 @@ void RunCohort::setRestartOutputer(RestartOutputer * resoutp){
 	resout = resoutp;
   	
 };
+
+void RunCohort::setSolverOutputer(SolverOutputer * soloutp){
+	solout = soloutp;
+};
+
+// the solver counters accumulated over the current stage, which then are reset for the next stage
+void RunCohort::outputSolverStats(){
+	if (solout!=NULL) {
+		int chtid = cht.cd->eqchtid;
+		if (runstage==1) {
+			chtid = cht.cd->spchtid;
+		} else if (runstage==2) {
+			chtid = cht.cd->trchtid;
+		} else if (runstage==3) {
+			chtid = cht.cd->scchtid;
+		}
+		solout->outputVariables(chtid, runstage, cht.ground.soil.stefan.stats,
+				cht.ground.soil.richard.stats, cht.integrator.stats);
+	}
+	monthcount += cht.integrator.stats.calls;
+
+	cht.ground.soil.stefan.resetStats();
+	cht.ground.soil.richard.resetStats();
+	cht.integrator.resetStats();
+};
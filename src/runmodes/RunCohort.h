@@ -23,8 +23,13 @@
 #include "../output/StatusOutputer.h"
 #include "../output/RestartOutputer.h"
 #include "../output/RegnOutputer.h"
+#include "../output/SolverOutputer.h"
 
 #include "../run/Cohort.h"
+#include "EqAccelerator.h"
+#include "../util/PhaseTimer.h"
+#include "../util/TraceRecorder.h"
+#include "../util/Logger.h"
 
 class RunCohort {
 	public:
@@ -34,6 +39,7 @@ class RunCohort {
 	    void setCohortInputer(CohortInputer * cin);
 	    void setRestartInputer(RestartInputer * resin);
 	    void setSiteinInputer(SiteinInputer * sin);
+	    void setWarmStart(const RestartData * eqstate);   //the next eq run from 'eqstate', NULL for lookup
 	    
  	 	int reinit(const int &cid, const int &eqcid, const int &rescid);
 
@@ -44,8 +50,13 @@ class RunCohort {
 		void setOutputer(SiteOutputer *soutp, AtmosphereOutputer *satmoutp,
   				VegetationOutputer * svegoutp, SnowSoilOutputer * sssloutp);
 		void setRegionalOutputer(RegnOutputer *routp);
+		void setSolverOutputer(SolverOutputer * soloutp);
 	 	
 		int cohortcount;
+		long monthcount;    //months integrated, over all cohorts run
+		int warmcount;      //eq runs from the eq state of a similar cohort
+		long eqyearcount;   //years of eq runs, over all cohorts run
+		EqAccelerator accel; //of the fire cycles of the eq runs ('eqaccel')
  		Cohort cht;
  		
  		GridInputer *ginputer;
@@ -64,6 +75,8 @@ class RunCohort {
  		
  		RestartOutputer *resout;
 
+ 		SolverOutputer *solout;
+
  		bool jcalifilein;
  		string jcalparfile;
  		
@@ -78,9 +91,14 @@ class RunCohort {
 		stringstream svegtype;
 		stringstream sdrgtype;
 
+		const RestartData * warmstate;
+
  		int runSpinup();
  		int runTransit();
  		int runScenario();
+
+ 		int runstage;    // 0 - eq, 1 - sp, 2 - tr, 3 - sc, for the solver statistics
+ 		void outputSolverStats();
  		
 };
 #endif /*RUNCOHORT_H_*/
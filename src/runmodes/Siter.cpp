@@ -13,7 +13,7 @@ Siter::~Siter(){
 void Siter::init(const string &controlfile){
 
 	try{
-		cout <<"Starting initialization in Siter::init\n";
+		LOG(LOG_INFO) <<"Starting initialization in Siter::init\n";
 
 		//Input and processing for reading parameters and passing them to controller
  		configin.controlfile=controlfile;
@@ -26,7 +26,23 @@ void Siter::init(const string &controlfile){
 
 		md.checking4run();
 		
- 		fd.useseverity = md.useseverity;		
+ 		fd.useseverity = md.useseverity;
+
+ 		Logger::level = md.loglevel;
+
+ 		//optional timeline of the run
+ 		TraceRecorder::enable(md.tracefile, md.tracebuffer);
+
+ 		//optional snapshots of the monthly bgc integration
+ 		IntegratorDump::enable(md.integdumpfile, md.integdumpmax);
+
+ 		//optional binary pack of all netcdf inputs
+ 		if (md.inputpack!="") {
+ 			inpack.open(md.inputpack, md.runstages);
+ 			rin.setInputPack(&inpack);
+ 			gin.setInputPack(&inpack);
+ 			cin.setInputPack(&inpack);
+ 		}
  
 		//region-level input
  		rin.setModelData(&md);		//for getting the directory infos from ModelData
@@ -52,6 +68,7 @@ void Siter::init(const string &controlfile){
 //		 		md.initmode=1;
 //		 	} else {
 		 		resin.init(md.initialfile);
+		 		resin.setBlockSize(md.restartblock);
  		 		runcht.setRestartInputer(&resin);
 //		 	}
 		} else {
@@ -89,6 +106,10 @@ void Siter::init(const string &controlfile){
  		}
 		resout.setRestartOutData(&resod);
 		resout.init(md.outputdir, stage, md.numprocs, md.myid); //define netcdf file for restart output
+		resout.setBlockSize(md.restartblock);
+
+		solout.init(md.outputdir, md.myid, stage);  //solver statistics
+		runcht.setSolverOutputer(&solout);
  		runcht.cht.setRestartOutData(&resod);   //restart output data sets connenction
  		runcht.setRestartOutputer(&resout);
 		
@@ -99,6 +120,25 @@ void Siter::init(const string &controlfile){
  		sgrid.setEnvData(&ed);        //define data-structures for ONE common grid
  		sgrid.setRegionData(&rd);
  		sgrid.setGridData(&gd);
+ 		sgrid.atm.setDayWindow(md.daydrivermonth);
+
+ 		//optional climate scenario on top of the grid climate
+ 		if (md.clmscenario!="") {
+ 			clmscen.read(md.clmscenario);
+ 			sgrid.setClimateScenario(&clmscen);
+ 		}
+
+ 		//optional climate read a window of years at a time, the scenario applied to each
+ 		if (gin.getClimateStream()!=NULL) {
+ 			if (md.clmscenario!="") gin.getClimateStream()->setClimateScenario(&clmscen);
+ 			sgrid.setClimateSource(gin.getClimateStream());
+ 		}
+
+ 		//optional cache of the derived climate drivers, kept between runs
+ 		if (md.drivercache!="") {
+ 			drvcache.setDirectory(md.drivercache);
+ 			sgrid.atm.setDriverCache(&drvcache);
+ 		}
 
  		runcht.cht.setTime(&timer);        //define data-structures for ONE common cohort
  		runcht.cht.setProcessData(&ed, &bd, &fd);
@@ -110,7 +150,7 @@ void Siter::init(const string &controlfile){
  		runcht.cht.init(); 
 
 	}catch (Exception &exception){
-  		cout <<"problem in initialize in Siter::init\n";
+  		LOG(LOG_ERROR) <<"problem in initialize in Siter::init\n";
   		exception.mesg();
   		exit(-1);
 	}
@@ -118,6 +158,7 @@ void Siter::init(const string &controlfile){
 };
 
 void Siter::run(){
+	PHASE_SCOPE("Siter::run");
 	
 	// cohort id consistency in different run modes
 	int chtid = 1;
@@ -126,6 +167,12 @@ void Siter::run(){
 	int eqcid = 0; //the record order in the input files, NOT the cohort ID (chtid)
 	int cid = 0; //the record order in the input files, NOT the cohort ID (chtid)
 	int rescid = 0; //the record order in the input files, NOT the cohort ID (chtid)
+
+	#ifdef PHASETIMER
+		PhaseTimer::beginCohort(chtid);
+	#endif
+		TraceRecorder::instant("cohort", "chtid", chtid);
+		IntegratorDump::setCohort(chtid);
 	
 	if(md.runeq){
 		if (chtid>0) {   // if input a real chtid
@@ -223,10 +270,11 @@ void Siter::run(){
 		int clmrecid = gin.getClmRecID(cd.clmid);
 
 		if (grdrecid<0) {
-			cout <<"grid not exists in Siter::run\n";
+			LOG(LOG_ERROR) <<"grid not exists in Siter::run\n";
 			exit(-1);
 		}
 		gin.getGridData(&gd, grdrecid, clmrecid);  //reading the grid-data for gid
+		gd.clmid = cd.clmid;
 //	cout << "topclay "<< gd.topclay<<"\n";
 //	cout << "botclay "<< gd.botclay<<"\n";
 //	cout << "topsand "<< gd.topsand<<"\n";
@@ -242,12 +290,12 @@ void Siter::run(){
 		error = sgrid.reinit(grdrecid);          //reinit for a new grid
 
 		if (error<0) {
-			cout <<"problem in reinitialize grid in Siter::run\n";
+			LOG(LOG_ERROR) <<"problem in reinitialize grid in Siter::run\n";
 			exit(-1);
 		}
 
 	}catch (Exception &exception){
-  		cout <<"problem in reinitialize grid in Siter::run\n";
+  		LOG(LOG_ERROR) <<"problem in reinitialize grid in Siter::run\n";
   		exception.mesg();
   		exit(-1);
 	}
@@ -258,20 +306,26 @@ void Siter::run(){
 		runcht.ccdriverout=false;  //switch for update cali. driver file, the default is false			
 		error = runcht.reinit(cid, eqcid, rescid); //reinit for a new cohort
 	}catch (Exception &exception){
-  		cout <<"problem in reinitialize cohort in Siter::run\n";
+  		LOG(LOG_ERROR) <<"problem in reinitialize cohort in Siter::run\n";
   		exception.mesg();
   		exit(-1);
 	}
 
 	if (error!=0) {
-		cout<<"Error for reinit cohort: "<<chtid<<" - EXIT code "<<error<<"\n";
+		LOG(LOG_ERROR) <<"Error for reinit cohort: "<<chtid<<" - EXIT code "<<error<<"\n";
 		exit(-1);
 	} else {
-		cout<<"cohort: "<<chtid<<" - running! \n";
+		LOG(LOG_INFO) <<"cohort: "<<chtid<<" - running! \n";
 		runcht.run();
 	}
 
     runcht.cohortcount++;
+
+	#ifdef PHASETIMER
+		PhaseTimer::write(md.outputdir+"phasetimer.txt");
+	#endif
+		TraceRecorder::write();
+		IntegratorDump::close();
  		
 };
 
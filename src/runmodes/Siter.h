@@ -27,6 +27,7 @@ class Siter {
     	RegionInputer rin;
     	GridInputer gin;
     	CohortInputer cin;
+    	InputPack inpack;
     	SiteinInputer sitein;
     	RestartInputer resin;
         
@@ -52,12 +53,15 @@ class Siter {
     	SnowSoilOutputer ssslout;		
 
     	RestartOutputer resout;
+    	SolverOutputer solout;
     	
 		//util
 		Timer timer;
 
     	// site-specific
 		Grid sgrid;
+		ClimateScenario clmscen;
+		DriverCache drvcache;
     	RunCohort runcht;
 	
 };
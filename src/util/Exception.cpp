@@ -1,4 +1,5 @@
 #include "Exception.h"
+#include "Logger.h"
 
 Exception::Exception(char* msg, ERRORKEY code){
   message = msg;	
@@ -7,7 +8,7 @@ Exception::Exception(char* msg, ERRORKEY code){
 
 void Exception::mesg(){
  //cout << what() <<"\n";	
- cout << chtid <<"  " <<message << "\n";	
+ LOG(LOG_ERROR) << chtid <<"  " <<message << "\n";	
 }
 
 int Exception::getErrorCode(){
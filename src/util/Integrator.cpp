@@ -39,6 +39,7 @@ Integrator::Integrator(){
    	maxit = 20;
     maxitmon = 100;
     syint = 1;
+    resetStats();
     
     strcpy( predstr[I_VEGC],"VEGC" );       // vegetation carbon
 
@@ -99,8 +100,19 @@ Integrator::Integrator(){
 
 };
 
+void Integrator::resetStats(){
+	stats.calls    = 0;
+	stats.accepted = 0;
+	stats.rejected = 0;
+	stats.forced   = 0;
+	stats.blackhol = 0;
+	stats.derivs   = 0;
+	stats.mindt    = 1.;
+};
  
 void Integrator::updateMonthly(){
+	PHASE_SCOPE("Integrator::updateMonthly");
+	TRACE_SCOPE("Integrator::updateMonthly");
 	//before integration , initialize the state and flux
 	// from ssl, veg;
 	 // first reset all the fluxes variables to zero
@@ -138,6 +150,7 @@ int Integrator::adapt(float pstate[]){
  //
 
   	blackhol = 0;
+  	stats.calls++;
   	while ( time != 1.0 ){
     	test = REJECT;
     	if ( syint == 1 ){
@@ -151,9 +164,11 @@ int Integrator::adapt(float pstate[]){
 				}
 				
 				//if(test>1)cout <<predstr[test-1] << " error is " << error[test-1] <<"------Integrator-------\n";
+				if ( dt<stats.mindt ) stats.mindt = dt;
 				if ( dt <= pow(0.5,maxit) ){
 	  				test = ACCEPT;
 	  				mflag = 1;
+	  				stats.forced++;
           			if ( nintmon == 0 ){
             			for( i = 0; i < numeq;i++ ) { oldstate[i] = pstate[i]; }
           			}
@@ -161,17 +176,21 @@ int Integrator::adapt(float pstate[]){
 				}
 
         		if ( test == ACCEPT ){
+          			stats.accepted++;
+          			TRACE_COUNTER("integrator dt", dt);
           			for( i = 0; i < numeq;i++ ) { pstate[i] = dum4[i]; }
           			time += dt;
           			fpart = modf( (0.01 + (time/(2.0*dt))),&ipart );
           			if ( fpart < 0.1 && dt < 1.0) { dt *= 2.0; }
         		}else {
+        			stats.rejected++;
         			dt *= 0.500; 
         		}
 
         		if ( nintmon == maxitmon ){
           			time = 1.0;
           			blackhol = 1;
+          			stats.blackhol++;
           			for( i = 0; i < numeq;i++ ) { pstate[i] = oldstate[i]; }
         		}
       		}
@@ -539,6 +558,7 @@ void Integrator::delta(  float pstate[],
    // only state variabls are needed, since fluxes and diagnostic variables will 
    // be recalculated again based on state variabels	
   
+   stats.derivs++;
    y2tcstate(pstate);
    
    ssl->delta();
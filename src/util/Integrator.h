@@ -28,6 +28,9 @@ using namespace std;
 #include "../vegetation/Vegetation_Bgc.h"
 #include "../data/BgcData.h"
 #include "../data/EnvData.h"
+#include "PhaseTimer.h"
+#include "TraceRecorder.h"
+#include "../inc/solverstats.h"
 
 class Integrator{
 	public :
@@ -57,6 +60,9 @@ class Integrator{
        void setEnvData(EnvData* edp);
        
        void updateMonthly();
+
+       rkfstats stats;      // solver counters since resetStats()
+       void resetStats();
     
   	   int NUMSL; //actual number of soil layers
   
@@ -0,0 +1,174 @@
+#include "IntegratorDump.h"
+
+const char INTEGDUMP_MAGIC[8] = {'D','O','S','T','E','M','I','D'};
+
+bool IntegratorDump::on = false;
+string IntegratorDump::filename = "";
+FILE * IntegratorDump::out = NULL;
+long IntegratorDump::maxrec = 0;
+long IntegratorDump::nrec = 0;
+int IntegratorDump::chtid = -1;
+IntegratorRecord IntegratorDump::rec;
+
+void IntegratorDump::fillHeader(IntegratorDumpHeader & hd){
+	memset(&hd, 0, sizeof(hd));
+	memcpy(hd.magic, INTEGDUMP_MAGIC, 8);
+	hd.version     = INTEGDUMP_VERSION;
+	hd.byteorder   = 0x01020304;
+	hd.reclen      = sizeof(IntegratorRecord);
+	hd.sizesoilbgc = sizeof(Soil_Bgc);
+	hd.sizevegbgc  = sizeof(Vegetation_Bgc);
+	hd.maxsoilay   = MAX_SOI_LAY;
+};
+
+/////////////////////////////////////////////////////////////////
+// recording
+
+void IntegratorDump::enable(const string & dumpfile, const long & maxrecords){
+	if (dumpfile=="" || maxrecords<=0) return;
+
+	filename = dumpfile;
+	out = fopen(filename.c_str(), "wb");
+	if (out==NULL) {
+		cout <<"cannot open "<<filename<<" for integrator snapshots\n";
+		return;
+	}
+
+	IntegratorDumpHeader hd;
+	fillHeader(hd);
+	fwrite(&hd, sizeof(hd), 1, out);
+
+	maxrec = maxrecords;
+	nrec   = 0;
+	on     = true;
+};
+
+void IntegratorDump::setCohort(const int & id){
+	chtid = id;
+};
+
+//the inputs, after Soil_Bgc/Vegetation_Bgc::prepareIntegration()
+void IntegratorDump::before(Soil_Bgc * sb, Vegetation_Bgc * vb, EnvData * ed, BgcData * bd,
+		FirData * fd, const int & yrcnt, const int & month){
+	if (!on) return;
+
+	rec.chtid   = chtid;
+	rec.yrcnt   = yrcnt;
+	rec.month   = month;
+	rec.vegtype = bd->cd->vegtype;
+	rec.drgtype = bd->cd->drgtype;
+	rec.ysf     = fd->ysf;
+
+	rec.atms     = ed->m_atms;
+	rec.a2l      = ed->m_a2l;
+	rec.l2a      = ed->m_l2a;
+	rec.sois     = ed->m_sois;
+	rec.soid     = ed->m_soid;
+	rec.prveetmx = ed->prveetmx;
+
+	rec.vegs        = bd->m_vegs;
+	rec.bsois       = bd->m_sois;
+	rec.vegd        = bd->m_vegd;
+	rec.bsoid       = bd->m_soid;
+	rec.foliagemx   = bd->foliagemx;
+	rec.topt        = bd->topt;
+	rec.unleafmx    = bd->unleafmx;
+	rec.prvunleafmx = bd->prvunleafmx;
+	rec.prvtopt     = bd->prvtopt;
+	rec.c2n         = bd->c2n;
+	rec.nfeed       = bd->nfeed;
+	rec.avlnflg     = bd->avlnflg;
+	rec.baseline    = bd->baseline;
+
+	memcpy(rec.soilbgc, (const void*)sb, sizeof(Soil_Bgc));
+	memcpy(rec.vegbgc, (const void*)vb, sizeof(Vegetation_Bgc));
+};
+
+//the pools after the integration, and the record is written
+void IntegratorDump::after(BgcData * bd){
+	if (!on) return;
+
+	rec.vegsout = bd->m_vegs;
+	rec.soisout = bd->m_sois;
+	fwrite(&rec, sizeof(rec), 1, out);
+
+	nrec++;
+	if (nrec>=maxrec) close();
+};
+
+void IntegratorDump::close(){
+	if (out==NULL) return;
+	fclose(out);
+	out = NULL;
+	on  = false;
+	cout <<nrec<<" integrator snapshots written to "<<filename<<"\n";
+};
+
+/////////////////////////////////////////////////////////////////
+// replaying
+
+//NULL if the file is not a dump of this build/platform
+FILE * IntegratorDump::openRead(const string & dumpfile){
+	FILE * in = fopen(dumpfile.c_str(), "rb");
+	if (in==NULL) {
+		cout <<"cannot open "<<dumpfile<<"\n";
+		return NULL;
+	}
+
+	IntegratorDumpHeader hd;
+	IntegratorDumpHeader myhd;
+	fillHeader(myhd);
+	if (fread(&hd, sizeof(hd), 1, in)!=1 || memcmp(&hd, &myhd, sizeof(hd))!=0) {
+		cout <<dumpfile<<" is not an integrator dump of this version/platform\n";
+		fclose(in);
+		return NULL;
+	}
+	return in;
+};
+
+bool IntegratorDump::read(FILE * in, IntegratorRecord & record){
+	return fread(&record, sizeof(record), 1, in)==1;
+};
+
+// the objects are set to the recorded state, and re-linked to the data objects given,
+// since the byte images keep the pointers of the recording run. 'bd->cd' must be set
+void IntegratorDump::restore(const IntegratorRecord & record, Soil_Bgc * sb, Vegetation_Bgc * vb,
+		EnvData * ed, BgcData * bd, FirData * fd, CohortLookup * chtlu){
+
+	bd->cd->vegtype = record.vegtype;
+	bd->cd->drgtype = record.drgtype;
+	fd->ysf         = record.ysf;
+
+	ed->m_atms   = record.atms;
+	ed->m_a2l    = record.a2l;
+	ed->m_l2a    = record.l2a;
+	ed->m_sois   = record.sois;
+	ed->m_soid   = record.soid;
+	ed->prveetmx = record.prveetmx;
+
+	bd->m_vegs      = record.vegs;
+	bd->m_sois      = record.bsois;
+	bd->m_vegd      = record.vegd;
+	bd->m_soid      = record.bsoid;
+	bd->foliagemx   = record.foliagemx;
+	bd->topt        = record.topt;
+	bd->unleafmx    = record.unleafmx;
+	bd->prvunleafmx = record.prvunleafmx;
+	bd->prvtopt     = record.prvtopt;
+	bd->c2n         = record.c2n;
+	bd->nfeed       = record.nfeed;
+	bd->avlnflg     = record.avlnflg;
+	bd->baseline    = record.baseline;
+
+	memcpy((void*)sb, record.soilbgc, sizeof(Soil_Bgc));
+	memcpy((void*)vb, record.vegbgc, sizeof(Vegetation_Bgc));
+	sb->setEnvData(ed);
+	sb->setBgcData(bd);
+	sb->setFirData(fd);
+	sb->setCohortLookup(chtlu);
+	vb->setEnvData(ed);
+	vb->setBgcData(bd);
+	vb->setFirData(fd);
+	vb->setCohortLookup(chtlu);
+	vb->setSoilBgc(sb);
+};
@@ -0,0 +1,114 @@
+#ifndef INTEGRATORDUMP_H_
+#define INTEGRATORDUMP_H_
+
+/*! snapshots of the inputs and results of the monthly bgc integration (Integrator::updateMonthly),
+ *  for replaying real cohort months outside of the model (see TEMINTEG.cpp)
+ * \file
+ *
+ *  a record is all that the integration reads: the Soil_Bgc and Vegetation_Bgc objects
+ *  (byte images, all plain data but the pointers to their data objects), the monthly
+ *  EnvData/BgcData structs used by their delta(), and the pools after the integration.
+ *  Nothing is recorded until enable(), i.e. 'integratordump <file>' in the control file,
+ *  and at most 'integratordumpmax <N>' records (months) are written.
+ *
+ *  the file is native binary (byte order, struct layout) as InputPack, so it is to be
+ *  replayed by the same build on the same platform; the header keeps the sizes to check it
+ */
+
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+using namespace std;
+
+#include "../ground/Soil_Bgc.h"
+#include "../vegetation/Vegetation_Bgc.h"
+#include "../data/EnvData.h"
+#include "../data/BgcData.h"
+#include "../data/FirData.h"
+#include "../lookup/CohortLookup.h"
+
+const int INTEGDUMP_VERSION = 1;
+
+struct IntegratorRecord{
+	int chtid;
+	int yrcnt;
+	int month;
+	int vegtype;
+	int drgtype;
+	int ysf;
+
+	// EnvData
+	atmstate_env atms;
+	atm2lnd_env a2l;
+	lnd2atm_env l2a;
+	soistate_env sois;
+	soidiag_env soid;
+	double prveetmx;
+
+	// BgcData
+	vegstate_bgc vegs;
+	soistate_bgc bsois;
+	vegdiag_bgc vegd;
+	soidiag_bgc bsoid;
+	double foliagemx;
+	double topt;
+	double unleafmx;
+	double prvunleafmx;
+	double prvtopt;
+	double c2n;
+	int nfeed;
+	int avlnflg;
+	int baseline;
+
+	char soilbgc[sizeof(Soil_Bgc)];
+	char vegbgc[sizeof(Vegetation_Bgc)];
+
+	// after the integration
+	vegstate_bgc vegsout;
+	soistate_bgc soisout;
+};
+
+struct IntegratorDumpHeader{
+	char magic[8];
+	int version;
+	int byteorder;
+	int reclen;           //sizeof(IntegratorRecord)
+	int sizesoilbgc;
+	int sizevegbgc;
+	int maxsoilay;        //MAX_SOI_LAY
+};
+
+class IntegratorDump{
+	public:
+
+		static bool on;
+
+		// recording, from the model run
+		static void enable(const string & filename, const long & maxrecords);
+		static void setCohort(const int & chtid);
+		static void before(Soil_Bgc * sb, Vegetation_Bgc * vb, EnvData * ed, BgcData * bd,
+				FirData * fd, const int & yrcnt, const int & month);
+		static void after(BgcData * bd);
+		static void close();
+
+		// replaying
+		static FILE * openRead(const string & filename);
+		static bool read(FILE * in, IntegratorRecord & rec);
+		static void restore(const IntegratorRecord & rec, Soil_Bgc * sb, Vegetation_Bgc * vb,
+				EnvData * ed, BgcData * bd, FirData * fd, CohortLookup * chtlu);
+
+	private:
+
+		static string filename;
+		static FILE * out;
+		static long maxrec;
+		static long nrec;
+		static int chtid;
+		static IntegratorRecord rec;
+
+		static void fillHeader(IntegratorDumpHeader & hd);
+
+};
+
+#endif /*INTEGRATORDUMP_H_*/
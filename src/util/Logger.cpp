@@ -0,0 +1,29 @@
+#include "Logger.h"
+
+int Logger::level = LOG_INFO;
+
+// stdout buffer of init(); messages are small, so this is many messages per write
+const size_t LOGBUFSIZE = 1<<16;
+
+void Logger::init(){
+	setvbuf(stdout, NULL, _IOFBF, LOGBUFSIZE);
+	setvbuf(stderr, NULL, _IONBF, 0);
+};
+
+int Logger::levelOf(const string & name){
+	if (name=="error") return LOG_ERROR;
+	if (name=="warn")  return LOG_WARN;
+	if (name=="info")  return LOG_INFO;
+	if (name=="debug") return LOG_DEBUG;
+	return -1;
+};
+
+// cout is synchronized with stdio, so this keeps the order with cout messages
+void Logger::write(const int & msglevel, const string & msg){
+	fwrite(msg.data(), 1, msg.size(), stdout);
+	if (msglevel<=LOG_ERROR) fflush(stdout);
+};
+
+void Logger::flush(){
+	fflush(stdout);
+};
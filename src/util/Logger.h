@@ -0,0 +1,68 @@
+#ifndef LOGGER_H_
+#define LOGGER_H_
+
+/*! leveled console messages, buffered
+ * \file
+ *
+ *  LOG(LOG_INFO) <<"a message "<<value<<"\n";
+ *
+ *  a message is written if its level is at most the run's level ('loglevel <name>' in the
+ *  control file: error, warn, info (default) or debug) AND at most LOGLEVELMAX in TEMMOD.h;
+ *  a message above LOGLEVELMAX is compiled out, and one above the run's level costs one
+ *  test - the '<<' operands are not evaluated then.
+ *
+ *  a message is put together on its own and goes to stdout as one block, so the lines of
+ *  a message stay together; stdout is fully buffered by init() (instead of unbuffered), and
+ *  flushed by flush(), after each error message, and at exit.
+ *
+ *  levels:  LOG_ERROR - a cohort or the run failed
+ *           LOG_WARN  - something was reset or skipped
+ *           LOG_INFO  - start/end of the run and of the cohorts
+ *           LOG_DEBUG - the ids, inputs and yearly progress of each cohort
+ */
+
+#include <string>
+#include <sstream>
+#include <cstdio>
+#include <iostream>
+using namespace std;
+
+#include "../TEMMOD.h"
+
+enum LOGLEVEL { LOG_ERROR = 0, LOG_WARN = 1, LOG_INFO = 2, LOG_DEBUG = 3 };
+
+#ifndef LOGLEVELMAX
+	#define LOGLEVELMAX 3
+#endif
+
+class Logger{
+	public:
+
+		static int level;
+
+		static void init();
+		static int levelOf(const string & name);     //-1 if not a level name
+
+		static void write(const int & msglevel, const string & msg);
+		static void flush();
+
+};
+
+//the message object of LOG, written when the statement ends
+class LogMessage{
+	public:
+		LogMessage(const int & msglevel) : lvl(msglevel){};
+		~LogMessage(){
+			Logger::write(lvl, msg.str());
+		};
+		ostream & stream(){
+			return msg;
+		};
+	private:
+		int lvl;
+		ostringstream msg;
+};
+
+#define LOG(msglevel) if ((msglevel)>LOGLEVELMAX || (msglevel)>Logger::level) ; else LogMessage(msglevel).stream()
+
+#endif /*LOGGER_H_*/
@@ -0,0 +1,83 @@
+#include "PerfCounters.h"
+
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+	#include <unistd.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <linux/perf_event.h>
+#endif
+
+bool PerfCounters::tried  = false;
+int PerfCounters::fds[PERF_NCOUNTER] = {-1, -1, -1, -1};
+int PerfCounters::leader = -1;
+int PerfCounters::nopen  = 0;
+int PerfCounters::index[PERF_NCOUNTER] = {-1, -1, -1, -1};
+
+const char* PerfCounters::name(const int & ic){
+	static const char* names[PERF_NCOUNTER] = {"cycles", "instructions", "cache-misses", "branch-misses"};
+	return names[ic];
+};
+
+bool PerfCounters::available(){
+	return leader>=0;
+};
+
+bool PerfCounters::has(const int & ic){
+	return index[ic]>=0;
+};
+
+// once only; the later calls return what the first one found
+bool PerfCounters::open(){
+	if (tried) return available();
+	tried = true;
+
+#ifdef __linux__
+	const unsigned long long configs[PERF_NCOUNTER] = {PERF_COUNT_HW_CPU_CYCLES,
+		PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+	for (int ic=0; ic<PERF_NCOUNTER; ic++) {
+		struct perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.type           = PERF_TYPE_HARDWARE;
+		attr.size           = sizeof(attr);
+		attr.config         = configs[ic];
+		attr.disabled       = (leader<0) ? 1 : 0;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv     = 1;
+		attr.read_format    = PERF_FORMAT_GROUP;
+
+		int fd = syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0);
+		if (fd<0) continue;
+		if (leader<0) leader = fd;
+		fds[ic]   = fd;
+		index[ic] = nopen++;
+	}
+
+	if (leader>=0) {
+		ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+#endif
+
+	if (leader<0) {
+		cout <<"hardware counters not available - phase timing with times only\n";
+	}
+	return available();
+};
+
+void PerfCounters::read(unsigned long long vals[PERF_NCOUNTER]){
+	for (int ic=0; ic<PERF_NCOUNTER; ic++) vals[ic] = 0;
+
+#ifdef __linux__
+	if (leader<0) return;
+
+	unsigned long long buf[1+PERF_NCOUNTER];      // nr, then the values in the order opened
+	if (::read(leader, buf, sizeof(buf))<(long)sizeof(unsigned long long)) return;
+	for (int ic=0; ic<PERF_NCOUNTER; ic++) {
+		if (index[ic]>=0 && index[ic]<(int)buf[0]) vals[ic] = buf[1+index[ic]];
+	}
+#endif
+};
@@ -0,0 +1,39 @@
+#ifndef PERFCOUNTERS_H_
+#define PERFCOUNTERS_H_
+
+/*! hardware event counters of the running thread (Linux perf_event_open), for PhaseTimer
+ * \file
+ *
+ *  the counters are one group, read all at once. open() returns false if the events are
+ *  not available (kernel.perf_event_paranoid, a container without perf, another OS), and
+ *  then read() returns zeros, i.e. the phase timing goes on with times only.
+ *  A single counter the CPU does not have is left out and read as zero.
+ */
+
+#include <string>
+using namespace std;
+
+const int PERF_NCOUNTER = 4;
+
+class PerfCounters{
+	public:
+
+		static bool open();
+		static bool available();
+		static bool has(const int & ic);
+
+		static void read(unsigned long long vals[PERF_NCOUNTER]);
+
+		static const char* name(const int & ic);   //cycles, instructions, cache-misses, branch-misses
+
+	private:
+
+		static bool tried;
+		static int fds[PERF_NCOUNTER];
+		static int leader;
+		static int nopen;
+		static int index[PERF_NCOUNTER];           //position of each counter in the group read, or -1
+
+};
+
+#endif /*PERFCOUNTERS_H_*/
@@ -0,0 +1,231 @@
+#include "PhaseTimer.h"
+
+vector<PhaseTimer::PhaseNode> PhaseTimer::nodes;
+vector<int> PhaseTimer::stack;
+vector<double> PhaseTimer::starts;
+vector<unsigned long long> PhaseTimer::cstarts;
+bool PhaseTimer::counting = false;
+int PhaseTimer::current = -1;
+
+bool PhaseTimer::incohort = false;
+vector<int> PhaseTimer::chtids;
+vector< vector<float> > PhaseTimer::chttimes;
+vector< vector<unsigned long long> > PhaseTimer::chtcounts;
+
+double PhaseTimer::now(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec*1.e-9;
+};
+
+PhaseTimer::PhaseNode PhaseTimer::newNode(const char* name, const int & parent){
+	PhaseNode node;
+	node.name   = name;
+	node.parent = parent;
+	node.calls  = 0;
+	node.total  = 0.;
+	node.cohort = 0.;
+	for (int ic=0; ic<PERF_NCOUNTER; ic++) {
+		node.counts[ic]    = 0;
+		node.chtcounts[ic] = 0;
+	}
+	return node;
+};
+
+void PhaseTimer::begin(const char* name){
+	if (current<0) {          //the root
+		nodes.push_back(newNode("", -1));
+		current = 0;
+	#ifdef PHASECOUNTERS
+		counting = PerfCounters::open();
+	#endif
+	}
+
+	//the child of current phase with 'name', or a new one
+	int inode = -1;
+	vector<int> & children = nodes[current].children;
+	for (unsigned int i=0; i<children.size(); i++) {
+		const char* cname = nodes[children[i]].name;
+		if (cname==name || strcmp(cname, name)==0) {
+			inode = children[i];
+			break;
+		}
+	}
+	if (inode<0) {
+		inode = nodes.size();
+		nodes.push_back(newNode(name, current));
+		nodes[current].children.push_back(inode);
+	}
+
+	stack.push_back(inode);
+	current = inode;
+	if (counting) {
+		unsigned long long vals[PERF_NCOUNTER];
+		PerfCounters::read(vals);
+		cstarts.insert(cstarts.end(), vals, vals+PERF_NCOUNTER);
+	}
+	starts.push_back(now());
+};
+
+void PhaseTimer::end(){
+	if (stack.empty()) return;
+
+	double dt = now()-starts.back();
+	PhaseNode & node = nodes[stack.back()];
+	node.calls++;
+	node.total  += dt;
+	node.cohort += dt;
+
+	if (counting) {
+		unsigned long long vals[PERF_NCOUNTER];
+		PerfCounters::read(vals);
+		const unsigned long long * vals0 = &cstarts[cstarts.size()-PERF_NCOUNTER];
+		for (int ic=0; ic<PERF_NCOUNTER; ic++) {
+			node.counts[ic]    += vals[ic]-vals0[ic];
+			node.chtcounts[ic] += vals[ic]-vals0[ic];
+		}
+		cstarts.resize(cstarts.size()-PERF_NCOUNTER);
+	}
+
+	current = node.parent;
+	stack.pop_back();
+	starts.pop_back();
+};
+
+//the times of the last cohort are closed, if not yet
+void PhaseTimer::beginCohort(const int & chtid){
+	if (incohort) endCohort();
+	for (unsigned int i=0; i<nodes.size(); i++) {
+		nodes[i].cohort = 0.;
+		for (int ic=0; ic<PERF_NCOUNTER; ic++) nodes[i].chtcounts[ic] = 0;
+	}
+	chtids.push_back(chtid);
+	incohort = true;
+};
+
+void PhaseTimer::endCohort(){
+	if (!incohort) return;
+	vector<float> times(nodes.size());
+	for (unsigned int i=0; i<nodes.size(); i++) times[i] = nodes[i].cohort;
+	chttimes.push_back(times);
+	if (counting) {
+		vector<unsigned long long> counts(nodes.size()*PERF_NCOUNTER);
+		for (unsigned int i=0; i<nodes.size(); i++) {
+			for (int ic=0; ic<PERF_NCOUNTER; ic++) counts[i*PERF_NCOUNTER+ic] = nodes[i].chtcounts[ic];
+		}
+		chtcounts.push_back(counts);
+	}
+	incohort = false;
+};
+
+string PhaseTimer::path(const int & inode){
+	if (inode<=0) return "";
+	string ppath = path(nodes[inode].parent);
+	if (ppath=="") return nodes[inode].name;
+	return ppath+"/"+nodes[inode].name;
+};
+
+void PhaseTimer::writeNode(ofstream & ofs, const int & inode, const int & depth, const double & runtime){
+	const PhaseNode & node = nodes[inode];
+	double self = node.total;
+	for (unsigned int i=0; i<node.children.size(); i++) self -= nodes[node.children[i]].total;
+
+	ofs <<setw(2*depth)<<""<<left<<setw(48-2*depth)<<node.name<<right
+		<<setw(12)<<node.calls
+		<<setw(14)<<setprecision(4)<<fixed<<node.total
+		<<setw(14)<<self
+		<<setw(9)<<setprecision(2)<<(runtime>0. ? 100.*node.total/runtime : 0.);
+	if (counting) {
+		for (int ic=0; ic<PERF_NCOUNTER; ic++) {
+			if (PerfCounters::has(ic)) ofs <<setw(16)<<node.counts[ic];
+		}
+		if (PerfCounters::has(0) && PerfCounters::has(1)) {
+			ofs <<setw(8)<<setprecision(2)<<(node.counts[0]>0 ? (double)node.counts[1]/node.counts[0] : 0.);
+		}
+	}
+	ofs <<"\n";
+
+	for (unsigned int i=0; i<node.children.size(); i++) {
+		writeNode(ofs, node.children[i], depth+1, runtime);
+	}
+};
+
+// the phase tree with aggregate times, then one line of all phase times per cohort;
+// phases still running (e.g. the caller's) are counted up to now
+void PhaseTimer::write(const string & filename){
+	if (nodes.empty()) return;
+	endCohort();
+
+	double t = now();
+	for (unsigned int k=0; k<stack.size(); k++) {
+		nodes[stack[k]].total += t-starts[k];
+		starts[k] = t;
+	}
+	if (counting) {
+		unsigned long long vals[PERF_NCOUNTER];
+		PerfCounters::read(vals);
+		for (unsigned int k=0; k<stack.size(); k++) {
+			for (int ic=0; ic<PERF_NCOUNTER; ic++) {
+				nodes[stack[k]].counts[ic] += vals[ic]-cstarts[k*PERF_NCOUNTER+ic];
+				cstarts[k*PERF_NCOUNTER+ic] = vals[ic];
+			}
+		}
+	}
+
+	ofstream ofs(filename.c_str());
+	if (!ofs.is_open()) {
+		cout <<"cannot open "<<filename<<" for phase timing\n";
+		return;
+	}
+
+	double runtime = 0.;
+	const vector<int> & top = nodes[0].children;
+	for (unsigned int i=0; i<top.size(); i++) runtime += nodes[top[i]].total;
+
+	ofs <<"# wall-clock seconds by phase (self = not in a sub-phase)\n";
+	ofs <<left<<setw(48)<<"#phase"<<right<<setw(12)<<"calls"<<setw(14)<<"total"
+		<<setw(14)<<"self"<<setw(9)<<"%";
+	if (counting) {
+		for (int ic=0; ic<PERF_NCOUNTER; ic++) {
+			if (PerfCounters::has(ic)) ofs <<setw(16)<<PerfCounters::name(ic);
+		}
+		if (PerfCounters::has(0) && PerfCounters::has(1)) ofs <<setw(8)<<"IPC";
+	}
+	ofs <<"\n";
+	for (unsigned int i=0; i<top.size(); i++) writeNode(ofs, top[i], 0, runtime);
+
+	ofs <<"\n# wall-clock seconds by cohort and phase\n";
+	ofs <<"CHTID";
+	for (unsigned int in=1; in<nodes.size(); in++) ofs <<"\t"<<path(in);
+	ofs <<"\n";
+	ofs <<setprecision(6);
+	for (unsigned int ic=0; ic<chttimes.size(); ic++) {
+		ofs <<chtids[ic];
+		for (unsigned int in=1; in<nodes.size(); in++) {
+			ofs <<"\t"<<(in<chttimes[ic].size() ? chttimes[ic][in] : 0.);
+		}
+		ofs <<"\n";
+	}
+
+	// counts including sub-phases, one line per cohort and phase
+	if (counting) {
+		ofs <<"\n# hardware counters by cohort and phase\n";
+		ofs <<"CHTID\tphase";
+		for (int ic=0; ic<PERF_NCOUNTER; ic++) {
+			if (PerfCounters::has(ic)) ofs <<"\t"<<PerfCounters::name(ic);
+		}
+		ofs <<"\n";
+		for (unsigned int ic=0; ic<chtcounts.size(); ic++) {
+			const vector<unsigned long long> & counts = chtcounts[ic];
+			for (unsigned int in=1; in<nodes.size() && in*PERF_NCOUNTER<counts.size(); in++) {
+				ofs <<chtids[ic]<<"\t"<<path(in);
+				for (int k=0; k<PERF_NCOUNTER; k++) {
+					if (PerfCounters::has(k)) ofs <<"\t"<<counts[in*PERF_NCOUNTER+k];
+				}
+				ofs <<"\n";
+			}
+		}
+	}
+
+	ofs.close();
+};
@@ -0,0 +1,92 @@
+#ifndef PHASETIMER_H_
+#define PHASETIMER_H_
+
+/*! hierarchical wall-clock timing of model phases, for finding where a run spends its time
+ * \file
+ *
+ *  a phase is timed from a PHASE_SCOPE("name") to the end of its enclosing block. Phases nest,
+ *  and a phase is a different node under a different parent, e.g. Stefan::updateFronts under
+ *  RunCohort::runSpinup/.../Ground::updateDaily. Times are also kept per cohort, between
+ *  beginCohort() and endCohort(), and all is written by write() as a summary text file.
+ *
+ *  PHASE_SCOPE is compiled in only with '#define PHASETIMER' in TEMMOD.h, and with
+ *  '#define PHASECOUNTERS' the hardware counters of each phase are kept as its times,
+ *  or only the times if the counters cannot be opened. Reading the counters is a system
+ *  call per phase begin/end, so a phase's own counts include some of its sub-phases' reading.
+ */
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <time.h>
+using namespace std;
+
+#include "../TEMMOD.h"
+#include "PerfCounters.h"
+
+class PhaseTimer{
+	public:
+
+		static void begin(const char* name);   //'name' must be a string literal, compared by pointer first
+		static void end();
+
+		static void beginCohort(const int & chtid);
+		static void endCohort();
+
+		static void write(const string & filename);
+
+	private:
+
+		struct PhaseNode{
+			const char* name;
+			int parent;
+			vector<int> children;
+			long calls;
+			double total;     //seconds
+			double cohort;    //seconds, in current cohort
+			unsigned long long counts[PERF_NCOUNTER];
+			unsigned long long chtcounts[PERF_NCOUNTER];   //in current cohort
+		};
+
+		static vector<PhaseNode> nodes;    //nodes[0] is the root (not a phase)
+		static vector<int> stack;
+		static vector<double> starts;
+		static vector<unsigned long long> cstarts;     //PERF_NCOUNTER per level of stack
+		static bool counting;
+		static int current;
+
+		static bool incohort;
+		static vector<int> chtids;
+		static vector< vector<float> > chttimes;   //per cohort, per node
+		static vector< vector<unsigned long long> > chtcounts;   //per cohort, PERF_NCOUNTER per node
+
+		static double now();
+		static PhaseNode newNode(const char* name, const int & parent);
+		static string path(const int & inode);
+		static void writeNode(ofstream & ofs, const int & inode, const int & depth, const double & runtime);
+
+};
+
+//the timing object of PHASE_SCOPE
+class PhaseScope{
+	public:
+		PhaseScope(const char* name){
+			PhaseTimer::begin(name);
+		};
+		~PhaseScope(){
+			PhaseTimer::end();
+		};
+};
+
+#ifdef PHASETIMER
+	#define PHASE_SCOPE_CAT(a, b) a##b
+	#define PHASE_SCOPE_VAR(line) PHASE_SCOPE_CAT(phasescope_, line)
+	#define PHASE_SCOPE(name) PhaseScope PHASE_SCOPE_VAR(__LINE__)(name)
+#else
+	#define PHASE_SCOPE(name)
+#endif
+
+#endif /*PHASETIMER_H_*/
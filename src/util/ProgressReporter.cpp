@@ -0,0 +1,136 @@
+#include "ProgressReporter.h"
+
+bool ProgressReporter::on = false;
+string ProgressReporter::filename = "";
+double ProgressReporter::interval = 10.;
+string ProgressReporter::runstage = "";
+int ProgressReporter::numcht = 0;
+int ProgressReporter::ndone = 0;
+int ProgressReporter::nfailed = 0;
+int ProgressReporter::chtid = -1;
+double ProgressReporter::cohortyears = 0.;
+double ProgressReporter::t0 = 0.;
+double ProgressReporter::tlast = 0.;
+double ProgressReporter::tcht = 0.;
+double ProgressReporter::tstage = 0.;
+const char* ProgressReporter::curstage = NULL;
+double ProgressReporter::avgcht = 0.;
+vector<ProgressReporter::StageCost> ProgressReporter::costs;
+
+// the moving averages are over the last 10 or so cohorts, the plain mean before that
+const long PROGRESS_WINDOW = 10;
+
+double ProgressReporter::now(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec*1.e-9;
+};
+
+void ProgressReporter::enable(const string & progressfile, const double & updateinterval){
+	if (progressfile=="") return;
+	filename = progressfile;
+	interval = updateinterval>0. ? updateinterval : 0.;
+	on = true;
+};
+
+void ProgressReporter::begin(const string & stage, const int & numcohorts){
+	if (!on) return;
+	runstage    = stage;
+	numcht      = numcohorts;
+	ndone       = 0;
+	nfailed     = 0;
+	chtid       = -1;
+	cohortyears = 0.;
+	avgcht      = 0.;
+	costs.clear();
+	t0 = now();
+	write("running");
+};
+
+void ProgressReporter::beginCohort(const int & id){
+	chtid    = id;
+	tcht     = now();
+	tstage   = tcht;
+	curstage = "input";
+};
+
+void ProgressReporter::stage(const char* name){
+	double t = now();
+	closeStage(t);
+	curstage = name;
+	tstage   = t;
+};
+
+void ProgressReporter::closeStage(const double & t){
+	if (curstage==NULL) return;
+	unsigned int is = 0;
+	while (is<costs.size() && strcmp(costs[is].name, curstage)!=0) is++;
+	if (is==costs.size()) {
+		StageCost cost;
+		cost.name = curstage;
+		cost.avg  = 0.;
+		cost.n    = 0;
+		costs.push_back(cost);
+	}
+	costs[is].n++;
+	average(costs[is].avg, costs[is].n, t-tstage);
+	curstage = NULL;
+};
+
+void ProgressReporter::average(double & avg, const long & n, const double & value){
+	avg += (value-avg)/(n<PROGRESS_WINDOW ? n : PROGRESS_WINDOW);
+};
+
+void ProgressReporter::endCohort(const bool & failed, const long & months){
+	double t = now();
+	closeStage(t);
+	if (failed) {
+		nfailed++;
+	} else {
+		ndone++;
+	}
+	cohortyears += months/12.;
+	average(avgcht, ndone+nfailed, t-tcht);
+
+	if (t-tlast>=interval) write("running");
+};
+
+void ProgressReporter::end(){
+	if (!on) return;
+	write("finished");
+	on = false;
+};
+
+// written whole to <file>.tmp, and then renamed over <file> (atomic within a file system)
+void ProgressReporter::write(const char* state){
+	tlast = now();
+
+	string tmpfile = filename+".tmp";
+	FILE * f = fopen(tmpfile.c_str(), "w");
+	if (f==NULL) {
+		cout <<"cannot open "<<tmpfile<<" for the progress - no more progress written\n";
+		on = false;
+		return;
+	}
+
+	double elapsed = tlast-t0;
+	int remaining  = numcht-ndone-nfailed;
+	if (remaining<0) remaining = 0;
+
+	fprintf(f, "{\n\"state\": \"%s\",\n\"stage\": \"%s\",\n\"updated\": %ld,\n\"elapsed_s\": %.1f,\n",
+			state, runstage.c_str(), (long)time(NULL), elapsed);
+	fprintf(f, "\"cohorts\": %d,\n\"done\": %d,\n\"failed\": %d,\n\"remaining\": %d,\n\"current_chtid\": %d,\n",
+			numcht, ndone, nfailed, remaining, chtid);
+	fprintf(f, "\"cohort_years\": %.0f,\n\"cohort_years_per_s\": %.2f,\n",
+			cohortyears, elapsed>0. ? cohortyears/elapsed : 0.);
+	fprintf(f, "\"cost_per_cohort_s\": {\"total\": %.3f", avgcht);
+	for (unsigned int is=0; is<costs.size(); is++) {
+		fprintf(f, ", \"%s\": %.3f", costs[is].name, costs[is].avg);
+	}
+	fprintf(f, "},\n\"eta_s\": %.0f\n}\n", ndone+nfailed>0 ? remaining*avgcht : -1.);
+
+	if (fclose(f)!=0 || rename(tmpfile.c_str(), filename.c_str())!=0) {
+		cout <<"cannot write "<<filename<<" - no more progress written\n";
+		on = false;
+	}
+};
@@ -0,0 +1,90 @@
+#ifndef PROGRESSREPORTER_H_
+#define PROGRESSREPORTER_H_
+
+/*! progress of a multi-cohort run in a small JSON status file, for a scheduler or a person
+ *  to poll while the run goes on ('progress <file>' in the control file)
+ * \file
+ *
+ *  the file holds the cohorts done/failed/remaining, cohort-years per second, the moving
+ *  average wall time of a cohort and of each stage of a cohort ("input", "reinit", "run"), and
+ *  the ETA from it. It is rewritten at most every 'progressinterval <s>' seconds (default 10),
+ *  and at the start and the end of the run, each time as <file>.tmp renamed to <file>, so a
+ *  reader always finds one complete file and the model never waits for a reader
+ */
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <time.h>
+using namespace std;
+
+class ProgressReporter{
+	public:
+
+		static bool on;
+
+		static void enable(const string & filename, const double & interval);
+
+		static void begin(const string & stage, const int & numcohorts);
+		static void beginCohort(const int & chtid);
+		static void stage(const char* name);            //closes the previous stage of the cohort
+		static void endCohort(const bool & failed, const long & months);
+		static void end();
+
+	private:
+
+		struct StageCost{
+			const char* name;          //string literals only
+			double avg;                //moving average (s/cohort)
+			long n;
+		};
+
+		static string filename;
+		static double interval;
+		static string runstage;
+		static int numcht;
+		static int ndone;
+		static int nfailed;
+		static int chtid;
+		static double cohortyears;
+
+		static double t0;
+		static double tlast;           //of the last write
+		static double tcht;            //start of the current cohort
+		static double tstage;          //start of the current stage
+		static const char* curstage;
+		static double avgcht;          //moving average of a cohort (s)
+		static vector<StageCost> costs;
+
+		static double now();           //seconds
+		static void closeStage(const double & t);
+		static void average(double & avg, const long & n, const double & value);
+		static void write(const char* state);
+
+};
+
+//the cohort object of PROGRESS_COHORT, ending the cohort when its block is left
+//(also by 'continue'); the cohort has failed if 'errcount' went up meanwhile, and its
+//cohort-years are from the increase of the running count of months integrated
+class ProgressCohort{
+	public:
+		ProgressCohort(const int & chtid, const int & errcount, const long & monthcount)
+			: err(errcount), err0(errcount), mon(monthcount), mon0(monthcount){
+			if (ProgressReporter::on) ProgressReporter::beginCohort(chtid);
+		};
+		~ProgressCohort(){
+			if (ProgressReporter::on) ProgressReporter::endCohort(err>err0, mon-mon0);
+		};
+	private:
+		const int & err;
+		int err0;
+		const long & mon;
+		long mon0;
+};
+
+#define PROGRESS_COHORT(chtid, errcount, monthcount) ProgressCohort progresscohort(chtid, errcount, monthcount)
+#define PROGRESS_STAGE(name) do { if (ProgressReporter::on) ProgressReporter::stage(name); } while (0)
+
+#endif /*PROGRESSREPORTER_H_*/
@@ -0,0 +1,102 @@
+#include "TraceRecorder.h"
+
+bool TraceRecorder::on = false;
+string TraceRecorder::filename = "";
+vector<TraceRecorder::TraceEvent> TraceRecorder::ring;
+long TraceRecorder::nevent = 0;
+double TraceRecorder::t0 = 0.;
+
+double TraceRecorder::now(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec*1.e6 + ts.tv_nsec*1.e-3 - t0;
+};
+
+void TraceRecorder::enable(const string & tracefile, const long & maxevents){
+	if (tracefile=="" || maxevents<=0) return;
+	filename = tracefile;
+	ring.assign(maxevents, TraceEvent());
+	nevent = 0;
+	t0 = 0.;
+	t0 = now();
+	on = true;
+};
+
+TraceRecorder::TraceEvent & TraceRecorder::next(){
+	TraceEvent & ev = ring[nevent % (long)ring.size()];
+	nevent++;
+	return ev;
+};
+
+void TraceRecorder::span(const char* name, const double & tbeg, const char* argname, const long & arg){
+	TraceEvent & ev = next();
+	ev.name    = name;
+	ev.ph      = 'X';
+	ev.argname = argname;
+	ev.ts      = tbeg;
+	ev.val     = now()-tbeg;
+	ev.arg     = arg;
+};
+
+void TraceRecorder::counter(const char* name, const double & value){
+	TraceEvent & ev = next();
+	ev.name    = name;
+	ev.ph      = 'C';
+	ev.argname = NULL;
+	ev.ts      = now();
+	ev.val     = value;
+	ev.arg     = 0;
+};
+
+void TraceRecorder::instant(const char* name, const char* argname, const long & arg){
+	if (!on) return;
+	TraceEvent & ev = next();
+	ev.name    = name;
+	ev.ph      = 'i';
+	ev.argname = argname;
+	ev.ts      = now();
+	ev.val     = 0.;
+	ev.arg     = arg;
+};
+
+// the events still in the ring, oldest first; recording stops here
+void TraceRecorder::write(){
+	if (!on) return;
+	on = false;
+
+	FILE * f = fopen(filename.c_str(), "w");
+	if (f==NULL) {
+		cout <<"cannot open "<<filename<<" for the trace\n";
+		return;
+	}
+
+	long size    = ring.size();
+	long first   = (nevent>size) ? nevent-size : 0;
+	long dropped = first;
+
+	fprintf(f, "{\"traceEvents\":[\n");
+	fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"DOSTEM\"}}");
+	for (long k=first; k<nevent; k++) {
+		const TraceEvent & ev = ring[k % size];
+		fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"pid\":1,\"tid\":1,\"ts\":%.3f", ev.name, ev.ph, ev.ts);
+		if (ev.ph=='X') {
+			fprintf(f, ",\"dur\":%.3f", ev.val);
+		} else if (ev.ph=='i') {
+			fprintf(f, ",\"s\":\"p\"");
+		}
+		if (ev.ph=='C') {
+			fprintf(f, ",\"args\":{\"value\":%.10g}", ev.val);
+		} else if (ev.argname!=NULL) {
+			fprintf(f, ",\"args\":{\"%s\":%ld}", ev.argname, ev.arg);
+		}
+		fprintf(f, "}");
+	}
+	fprintf(f, "\n],\n\"displayTimeUnit\":\"ms\",\n");
+	fprintf(f, "\"otherData\":{\"events\":%ld,\"dropped\":%ld}\n}\n", nevent, dropped);
+	fclose(f);
+
+	if (dropped>0) {
+		cout <<"trace: the first "<<dropped<<" of "<<nevent<<" events are not in "<<filename
+			<<" (tracebuffer "<<size<<")\n";
+	}
+};
@@ -0,0 +1,88 @@
+#ifndef TRACERECORDER_H_
+#define TRACERECORDER_H_
+
+/*! timeline of model phases in the trace-event JSON format (chrome://tracing, Perfetto),
+ *  for profiling one cohort in detail
+ * \file
+ *
+ *  a span is recorded from a TRACE_SCOPE("name") to the end of its enclosing block, as one
+ *  complete ('X') event when it ends; TRACE_COUNTER("name", value) adds a point to a counter
+ *  track. Nothing is recorded until enable(), i.e. 'trace <file>' in the control file, and a
+ *  disabled TRACE_SCOPE costs one test.
+ *
+ *  the events are kept in a ring buffer of fixed size ('tracebuffer <N>', in events), so a
+ *  long run keeps its LAST N events only, and all is written by write() at the end of run
+ */
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <iostream>
+#include <time.h>
+using namespace std;
+
+class TraceRecorder{
+	public:
+
+		static bool on;
+
+		static void enable(const string & filename, const long & maxevents);
+
+		static void span(const char* name, const double & tbeg, const char* argname, const long & arg);
+		static void counter(const char* name, const double & value);
+		static void instant(const char* name, const char* argname, const long & arg);
+
+		static void write();
+
+		static double now();          //microseconds since enable()
+
+	private:
+
+		struct TraceEvent{
+			const char* name;          //string literals only
+			char ph;                   //'X' span, 'C' counter, 'i' instant
+			const char* argname;       //NULL if no argument
+			double ts;
+			double val;                //duration of a span, or value of a counter
+			long arg;
+		};
+
+		static string filename;
+		static vector<TraceEvent> ring;
+		static long nevent;            //events recorded, including the ones overwritten
+		static double t0;
+
+		static TraceEvent & next();
+
+};
+
+//the span object of TRACE_SCOPE
+class TraceScope{
+	public:
+		TraceScope(const char* name, const char* argname=NULL, const long & arg=0){
+			if (TraceRecorder::on) {
+				nm  = name;
+				an  = argname;
+				av  = arg;
+				beg = TraceRecorder::now();
+			} else {
+				nm  = NULL;
+			}
+		};
+		~TraceScope(){
+			if (nm!=NULL && TraceRecorder::on) TraceRecorder::span(nm, beg, an, av);
+		};
+	private:
+		const char* nm;
+		const char* an;
+		long av;
+		double beg;
+};
+
+#define TRACE_SCOPE_CAT(a, b) a##b
+#define TRACE_SCOPE_VAR(line) TRACE_SCOPE_CAT(tracescope_, line)
+#define TRACE_SCOPE(name) TraceScope TRACE_SCOPE_VAR(__LINE__)(name)
+#define TRACE_SCOPE_ARG(name, argname, arg) TraceScope TRACE_SCOPE_VAR(__LINE__)(name, argname, arg)
+#define TRACE_COUNTER(name, value) do { if (TraceRecorder::on) TraceRecorder::counter(name, value); } while (0)
+
+#endif /*TRACERECORDER_H_*/
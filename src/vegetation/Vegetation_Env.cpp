@@ -104,6 +104,7 @@ void Vegetation_Env::beginOfMonth(const double & dayl){
  
 //VEGETATION DAILY WATER BALANCE CALCULATION
 void Vegetation_Env::updateDaily(   const double & dayl){
+	PHASE_SCOPE("Vegetation_Env::updateDaily");
   	/* temporary for Nirr sensitivity test*/
   	double er = envpar.er; // extinction coefficient
 	double EPAR = 4.55 ;   //an average energy for PAR photon (umol/J)
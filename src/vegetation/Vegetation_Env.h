@@ -12,6 +12,7 @@ using namespace std;
 #include "../data/EnvData.h"
 #include "../data/FirData.h"
 #include "../data/RestartData.h"
+#include "../util/PhaseTimer.h"
 
 
 class Vegetation_Env{